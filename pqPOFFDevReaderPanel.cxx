@@ -206,8 +206,11 @@ pqPOFFReaderPanel::pqPOFFReaderPanel(pqProxy *pxy, QWidget *p)
       SLOT(onWatchToggled(bool)));
   this->Implementation->Links.addPropertyLink(this->Implementation->Watch,
       "checked", SIGNAL(toggled(bool)), this->proxy(), uiWatch);
-  this->Implementation->Watch->setToolTip("<p>Watch the case with the specified"
-      " interval and update the scene with the latest timestep.</p>");
+  this->Implementation->Watch->setToolTip("<p>Watch the case and update the"
+      " scene with the latest timestep as soon as all its fields have been"
+      " written. If the server can not watch the case by filesystem events"
+      " (e.g. on network filesystems), poll it with the specified"
+      " interval instead.</p>");
   grid->addWidget(this->Implementation->Watch, 0, 3, Qt::AlignLeft);
 
   // create line edit for changing interval. Must be created after
@@ -222,7 +225,8 @@ pqPOFFReaderPanel::pqPOFFReaderPanel(pqProxy *pxy, QWidget *p)
   QIntValidator *valid = new QIntValidator(intEdit);
   valid->setBottom(1);
   intEdit->setValidator(valid);
-  intEdit->setToolTip("<p>The interval for watching a case.</p>");
+  intEdit->setToolTip("<p>The interval for polling a case that can not be"
+      " watched by filesystem events.</p>");
   this->Implementation->Links.addPropertyLink(intEdit, "text",
       SIGNAL(editingFinished()), this->proxy(), uiInterval);
   // connect after prperty link so that the interval is properly updated
@@ -653,18 +657,49 @@ void pqPOFFReaderPanel::onRefresh()
 }
 
 //-----------------------------------------------------------------------------
-// Decrement of timer
+// Decrement of timer. When the server watches the case by filesystem
+// events, only ask it for the timesteps completed since the last update
+// instead.
 void pqPOFFReaderPanel::onTimerTimeout()
 {
-  --this->Implementation->CurrentTime;
-  if (this->Implementation->CurrentTime > 0)
+  vtkSMProxy *pxy = this->proxy();
+  pxy->UpdatePropertyInformation(pxy->GetProperty("CompletedTimeSteps"));
+  pxy->UpdatePropertyInformation(pxy->GetProperty("WatchIsEventDriven"));
+  const bool isEventDriven
+      = vtkSMPropertyHelper(pxy, "WatchIsEventDriven").GetAsInt() != 0;
+  // the latest completed timestep. Later time directories may already
+  // exist but still be being written.
+  double latestCompleted = 0.0;
+  if (isEventDriven)
     {
-    if (this->Implementation->CurrentTime < 5 || this->Implementation->CurrentTime % 5 == 0)
+    this->Implementation->IntervalLabel->setText("Watching");
+    vtkSMPropertyHelper completed(pxy, "CompletedTimeSteps");
+    const unsigned int nCompleted = completed.GetNumberOfElements();
+    if (nCompleted == 0)
       {
-      this->Implementation->IntervalLabel
-          ->setText(QString("%1 /").arg(this->Implementation->CurrentTime));
+      return;
+      }
+    for (unsigned int stepI = 0; stepI < nCompleted; stepI++)
+      {
+      const double value = QString(completed.GetAsString(stepI)).toDouble();
+      if (stepI == 0 || value > latestCompleted)
+        {
+        latestCompleted = value;
+        }
+      }
+    }
+  else
+    {
+    --this->Implementation->CurrentTime;
+    if (this->Implementation->CurrentTime > 0)
+      {
+      if (this->Implementation->CurrentTime < 5 || this->Implementation->CurrentTime % 5 == 0)
+        {
+        this->Implementation->IntervalLabel
+            ->setText(QString("%1 /").arg(this->Implementation->CurrentTime));
+        }
+      return;
       }
-    return;
     }
 
   this->Implementation->Timer->stop(); // stop timer while processing
@@ -682,7 +717,20 @@ void pqPOFFReaderPanel::onTimerTimeout()
       this->proxy()->GetProperty("TimestepValues"));
   if (tsv->GetNumberOfElements() > 0)
     {
-    const double lastStep = tsv->GetElement(tsv->GetNumberOfElements() - 1);
+    unsigned int lastStepI = tsv->GetNumberOfElements() - 1;
+    if (isEventDriven)
+      {
+      // the last listed timestep not later than the latest completed
+      // one, with a tolerance for the rounding of time names
+      const double tolerance = 1e-10 * (latestCompleted > 0.0
+          ? latestCompleted : -latestCompleted);
+      while (lastStepI > 0
+          && tsv->GetElement(lastStepI) > latestCompleted + tolerance)
+        {
+        --lastStepI;
+        }
+      }
+    const double lastStep = tsv->GetElement(lastStepI);
     pqApplicationCore *app = pqApplicationCore::instance();
 
     // set animation time to the last timestep
@@ -48,6 +48,34 @@
 #define VTK_FOAMFILE_OUTBUFSIZE (131072)
 #define VTK_FOAMFILE_INCLUDE_STACK_SIZE (10)
 
+// Uncompressed files of at least this size in bytes are memory-mapped
+// and tokenized in place instead of being copied through the output
+// buffer (only on platforms with mmap()).
+#define VTK_FOAMFILE_MMAP_MINSIZE (VTK_FOAMFILE_OUTBUFSIZE)
+
+// Files and directories modified within this many seconds are taken as
+// possibly still being written: they are neither cached nor mapped.
+#define VTK_FOAMFILE_MTIME_MARGIN (2)
+
+// Bulk operations over at least this many elements are split across
+// threads by vtkMultiThreader (set to 0 to always run serially).
+#define VTK_FOAMFILE_MT_MINSIZE (1048576)
+
+// Meshes are built concurrently in ranges of this many cells (set to 0
+// to build serially).
+#define VTK_FOAMFILE_MT_MINCELLS (65536)
+
+// Token strings of up to this many characters are interned, and
+// dictionary tree nodes of up to this size in bytes are allocated from
+// the arena of the parse building the tree.
+#define VTK_FOAMFILE_INTERN_MAXLENGTH (64)
+#define VTK_FOAMFILE_ARENA_MAXNODESIZE (256)
+#define VTK_FOAMFILE_ARENA_BLOCKSIZE (65536)
+
+// The process-wide cache of field file headers is cleared when it grows
+// beyond this many files.
+#define VTK_FOAMFILE_HEADERCACHE_MAXFILES (262144)
+
 #if defined(_MSC_VER) && (_MSC_VER >= 1400)
 #define _CRT_SECURE_NO_WARNINGS 1
 #endif
@@ -65,6 +93,7 @@
 #include "vtksys/RegularExpression.hxx"
 #endif
 #include "vtksys/SystemTools.hxx"
+#include "vtksys/hash_map.hxx"
 #include <vtksys/ios/sstream>
 #include "vtk_zlib.h"
 
@@ -84,6 +113,8 @@
 #include "vtkIntArray.h"
 #include "vtkMath.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
+#include "vtkMutexLock.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
@@ -96,6 +127,7 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkTetra.h"
+#include "vtkTimerLog.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 #include "vtkVertex.h"
@@ -103,9 +135,11 @@
 #include "vtkWedge.h"
 
 #if VTK_MAJOR_VERSION >= 6
+#include <algorithm>
 #include <vector>
 #define vtkstd std
 #else
+#include <vtkstd/algorithm>
 #include <vtkstd/vector>
 #endif
 
@@ -117,11 +151,39 @@
 #include <regex.h>
 // for getuid()
 #include <unistd.h>
+// for mmap() / munmap() / fstat()
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define VTK_FOAMFILE_USE_MMAP 1
+#else
+#define VTK_FOAMFILE_USE_MMAP 0
+#endif
+#if defined(__linux__)
+// for inotify_init1() / inotify_add_watch() / inotify_rm_watch()
+#include <sys/inotify.h>
+#define VTK_FOAMFILE_USE_INOTIFY 1
+#else
+#define VTK_FOAMFILE_USE_INOTIFY 0
 #endif
 // for fabs()
 #include <math.h>
+// for time()
+#include <time.h>
 // for isalnum() / isspace() / isdigit()
 #include <ctype.h>
+// for memmove()
+#include <string.h>
+// for placement new
+#include <new>
+// for _mm256_cvtpd_ps() / _mm_cvtpd_ps()
+#if defined(__AVX__)
+#include <immintrin.h>
+#define VTK_FOAMFILE_HAVE_AVX 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86_FP) && _M_IX86_FP >= 2
+#include <emmintrin.h>
+#define VTK_FOAMFILE_HAVE_SSE2 1
+#endif
 
 // avoid name crashes with the builtin reader
 #define vtkFoamArrayVector vtkNewFoamArrayVector
@@ -162,7 +224,6 @@ public:
   }
 };
 
-typedef vtkFoamArrayVector<vtkIdList> vtkFoamIdListVector;
 typedef vtkFoamArrayVector<vtkIntArray> vtkFoamIntArrayVector;
 typedef vtkFoamArrayVector<vtkFloatArray> vtkFoamFloatArrayVector;
 struct vtkFoamIntVectorVector;
@@ -172,10 +233,14 @@ struct vtkFoamToken;
 struct vtkFoamFileStack;
 struct vtkFoamFile;
 struct vtkFoamIOobject;
+struct vtkFoamEntryFilter;
+struct vtkFoamFieldArrays;
 template <typename T> struct vtkFoamReadValue;
 struct vtkFoamEntryValue;
 struct vtkFoamEntry;
 struct vtkFoamDict;
+struct vtkFoamCaseIndex;
+struct vtkFoamCaseWatcher;
 
 //-----------------------------------------------------------------------------
 // class vtkOFFReaderPrivate
@@ -198,9 +263,16 @@ public:
 
   // gather timestep information
   bool MakeInformationVector(const vtkStdString &, const vtkStdString &,
-      const vtkStdString &, vtkOFFReader *);
+      const vtkStdString &, vtkOFFReader *, vtkFoamCaseIndex *,
+      vtkStringArray *);
+  // update the mesh locations after the time directories of the
+  // master reader have been listed again
+  void UpdateTimeInformation(vtkStringArray *timeNamesOld)
+    {this->PopulatePolyMeshDirArrays(timeNamesOld);}
+  // store the newly indexed directories to the cache directory
+  void WriteCaseIndex();
   // read mesh/fields and create dataset
-  int RequestData(vtkMultiBlockDataSet *, bool, bool, bool, bool);
+  int RequestData(vtkMultiBlockDataSet *, bool, bool, bool, bool, bool);
   void SetTimeValue(const double);
   int MakeMetaDataAtTimeStep(vtkStringArray *, vtkStringArray *,
       vtkStringArray *, vtkStringArray *, const bool);
@@ -221,7 +293,8 @@ private:
       INTERNAL = 4 // internal faces
       };
     vtkStdString BoundaryName;
-    int NFaces, StartFace, AllBoundariesStartFace, MyProcNo, NeighbProcNo;
+    vtkIdType NFaces, StartFace, AllBoundariesStartFace;
+    int MyProcNo, NeighbProcNo;
     bool IsActive;
     bt BoundaryType;
     };
@@ -236,8 +309,26 @@ private:
     // retain face number ranges where myProcNo is larger than
     // neighbProcNo so that polyhedral cell faces on a processor
     // boundary can be decomposed properly
-    vtkstd::vector<int> UpperProcRanges;
-    int LowestUpperProcFaceNo;
+    vtkstd::vector<vtkIdType> UpperProcRanges;
+    vtkIdType LowestUpperProcFaceNo;
+
+    // whether a face has to be reversed when decomposing polyhedra
+    bool IsUpperProcFace(const vtkIdType faceI) const
+    {
+      if (faceI >= this->LowestUpperProcFaceNo)
+        {
+        const size_t rangeSize = this->UpperProcRanges.size();
+        for (size_t rangeI = 0; rangeI < rangeSize; rangeI += 2)
+          {
+          if (this->UpperProcRanges[rangeI] <= faceI
+              && faceI < this->UpperProcRanges[rangeI + 1])
+            {
+            return true;
+            }
+          }
+        }
+      return false;
+    }
 
     // processor boundaries used to reconstruct processor faces when
     // in appended decomposed case mode.
@@ -250,12 +341,18 @@ private:
   vtkStdString CasePath;
   vtkStdString RegionName;
   vtkStdString ProcessorName;
+  // the directory index shared by the readers of the case
+  vtkFoamCaseIndex *CaseIndex;
 
   // time information
   vtkDoubleArray *TimeValues;
   int TimeStep;
   int TimeStepOld;
   vtkStringArray *TimeNames;
+  // the key of the mesh files of TimeStepOld when they were read
+  vtkStdString MeshFilesKeyOld;
+  // whether the fields of TimeStepOld have to be read again
+  bool RereadFields;
 
   int InternalMeshSelectionStatus;
   int InternalMeshSelectionStatusOld;
@@ -275,33 +372,45 @@ private:
   vtkIdType NumCells;
   vtkIdType NumPoints;
   vtkIdType NumInternalFaces;
-  vtkIntArray *FaceOwner;
+  vtkIdTypeArray *FaceOwner;
   vtkFoamIntVectorVector *ProcessorFaces;
+  // the cells owning the faces of the active patches if only the
+  // patches have been read, in which case FaceOwner holds indices to
+  // this list and the cell fields are read only at these cells
+  vtkIdTypeArray *BoundaryOwnerCells;
 
   // for cell-to-point interpolation
-  vtkPolyData *AllBoundaries;
-  vtkIntArray *AllBoundariesPointMap;
-  vtkIntArray *InternalPoints;
+  // the AllBoundaries faces, i.e. the faces of the physical and
+  // processor patches, sharing each point of the mesh. A point is a
+  // boundary point if and only if it has any of these faces.
+  vtkFoamIntVectorVector *AllBoundariesPointFaces;
+  int NumAllBoundariesFaces;
+  // the cells sharing each point of the internal mesh, where a
+  // decomposed polyhedron is represented by its original cell
+  vtkFoamIntVectorVector *PointCells;
 
   // for caching mesh
   vtkUnstructuredGrid *InternalMesh;
   vtkPolyData *SurfaceMesh;
   vtkMultiBlockDataSet *BoundaryMesh;
-  vtkFoamIntArrayVector *BoundaryPointMap; // use IntArray for LookupValue()
+  // the global ids of the points of each active patch
+  vtkFoamIntVectorVector *BoundaryPointMap;
   vtkFoamBoundaryDict BoundaryDict;
   vtkMultiBlockDataSet *LagrangianMesh;
   vtkMultiBlockDataSet *PointZoneMesh;
   vtkMultiBlockDataSet *FaceZoneMesh;
   vtkMultiBlockDataSet *CellZoneMesh;
+  // the mesh directory the zone names have been listed from
+  vtkStdString ZonesTimeDir;
 #if 0
   vtkFoamFloatArrayVector *ReciprocalDelta;
 #endif
 
   // for polyhedra handling
-  int NumTotalAdditionalCells;
-  vtkIntArray *AdditionalCellIds;
+  vtkIdType NumTotalAdditionalCells;
+  vtkIdTypeArray *AdditionalCellIds;
   vtkIntArray *NumAdditionalCells;
-  vtkFoamIdListVector *AdditionalCellPoints;
+  vtkFoamIntVectorVector *AdditionalCellPoints;
 
   // region names displayed in the selection list
   static const char *InternalMeshIdentifier;
@@ -318,6 +427,7 @@ private:
 
   // clear mesh construction
   void ClearInternalMeshes();
+  void ClearZoneMeshes();
   void ClearBoundaryMeshes();
   void ClearLagrangianMeshes();
   void ClearMeshes();
@@ -341,41 +451,66 @@ private:
     {return this->RegionName + (this->RegionName == "" ? "" : "/");}
 
   // search time directories for mesh
-  void AppendMeshDirToArray(vtkStringArray *, const vtkStdString &,
+  void AppendMeshDirToArray(vtkStringArray *, const bool,
       const vtkStdString &, const int);
-  void PopulatePolyMeshDirArrays();
+  void PopulatePolyMeshDirArrays(vtkStringArray *);
+  int FindTimeName(const vtkStdString &) const;
 
   // search a time directory for field objects
   void GetFieldNames(const vtkStdString &, const bool, vtkStringArray *,
       vtkStringArray *, vtkStringArray *);
   void SortFieldFiles(vtkStringArray *, vtkStringArray *, vtkStringArray *);
   void LocateLagrangianClouds(vtkStringArray *, const vtkStdString &);
+  bool IsCloudDirectory(const vtkStdString &);
 
   // read controlDict
   bool ListTimeDirectoriesByControlDict(vtkFoamDict *dict);
   bool ListTimeDirectoriesByInstances();
 
   // read mesh files
-  vtkFloatArray* ReadPointsFile();
-  vtkFoamIntVectorVector* ReadFacesFile (const vtkStdString &);
+  struct vtkFoamMeshFile;
+  struct vtkFoamMeshFileTasks;
+  void ReadMeshFiles(vtkFoamMeshFile *, const int);
+  void ReportMeshFileError(const vtkFoamMeshFile &);
+  vtkFloatArray* ReadPointsFile(vtkFoamMeshFile &);
+  vtkFoamIntVectorVector* ReadFacesFile (vtkFoamMeshFile &);
   vtkFoamIntVectorVector* ReadOwnerNeighborFiles(const vtkStdString &,
-      vtkFoamIntVectorVector *);
+      vtkFoamIntVectorVector *, vtkFoamMeshFile &, vtkFoamMeshFile &);
+  vtkFoamIntVectorVector* ReadBoundaryMeshFiles(const vtkStdString &);
   bool CheckFacePoints(vtkFoamIntVectorVector *);
 
+  // persistent mesh cache
+  struct vtkFoamMeshCacheFile;
+  vtkStdString MeshCacheKey(const vtkStdString &);
+  vtkStdString MeshFilesKey(const int);
+  vtkStdString CachePath(const vtkStdString &, const char *);
+  bool MakeCacheDirectory();
+  vtkFoamIntVectorVector *ReadMeshCache(const vtkStdString &, vtkIdType &);
+  void WriteMeshCache(const vtkStdString &, const vtkFoamIntVectorVector *);
+
+  // persistent case index
+  vtkStdString CaseIndexKey();
+  void ReadCaseIndex();
+
   // create mesh
+  struct vtkFoamCellRange;
+  struct vtkFoamCellTasks;
+  void CountCellsInRange(const vtkFoamCellTasks &, vtkFoamCellRange &);
+  void InsertCellsInRange(const vtkFoamCellTasks &, vtkFoamCellRange &);
   void InsertCellsToGrid(vtkUnstructuredGrid *, const vtkFoamIntVectorVector *,
-      const vtkFoamIntVectorVector *, vtkFloatArray *, vtkIdTypeArray *,
+      const vtkFoamIntVectorVector *, vtkFloatArray *, const bool,
       vtkIntArray *);
   vtkUnstructuredGrid *MakeInternalMesh(const vtkFoamIntVectorVector *,
       const vtkFoamIntVectorVector *, vtkFloatArray *);
   vtkPolyData *MakeSurfaceMesh(const vtkStdString &,
       const vtkFoamIntVectorVector *, vtkFloatArray *);
 
-  bool InsertFacesToGrid(vtkPolyData *, const vtkFoamIntVectorVector *, int,
-      int, vtkIntArray *, vtkIdList *, const int *, const bool);
-  template <typename T1, typename T2> bool ExtendArray(T1 *, const int);
+  bool InsertFacesToGrid(vtkPolyData *, const vtkFoamIntVectorVector *,
+      vtkIdType, vtkIdType, vtkIdTypeArray *, vtkIdList *, const vtkIdType *,
+      const bool);
+  template <typename T1, typename T2> bool ExtendArray(T1 *, const vtkIdType);
   vtkMultiBlockDataSet* MakeBoundaryMesh(const vtkFoamIntVectorVector *,
-      vtkFloatArray *);
+      vtkFloatArray *, const vtkIdType);
   void SetBlockName(vtkMultiBlockDataSet *, unsigned int, const char *);
   void TruncateFaceOwner();
 #if 0
@@ -388,35 +523,53 @@ private:
   void MoveBoundaryMesh(vtkMultiBlockDataSet *, vtkFloatArray *);
 
   // cell-to-point interpolator
+  void BuildAllBoundariesPointFaces(const vtkFoamIntVectorVector *,
+      const vtkIdType);
+  void BuildPointCells();
+  void InterpolateInternalCellToPoint(
+      const vtkstd::vector<vtkFoamFieldArrays> &);
   void InterpolateCellToPoint(vtkFloatArray *, vtkFloatArray *, vtkPointSet *,
       vtkIntArray *, const int);
 
   // read and create cell/point fields
   void ConstructDimensions(vtkStdString *, vtkFoamDict *);
   bool ReadFieldFile(vtkFoamIOobject *, vtkFoamDict *, const vtkStdString &,
-      vtkDataArraySelection *);
-  vtkFloatArray *FillField(vtkFoamEntry *, vtkFoamEntry *, int, vtkFoamIOobject *,
+      vtkDataArraySelection *, const vtkFoamEntryFilter * = NULL);
+  vtkFloatArray *FillField(vtkFoamEntry *, vtkFoamEntry *, vtkIdType,
+      vtkFoamIOobject *,
       const vtkStdString &, const bool);
   void GetVolFieldAtTimeStep(vtkUnstructuredGrid *, vtkMultiBlockDataSet *,
-      const vtkStdString &);
+      const vtkStdString &, vtkFoamFieldArrays *);
   void GetSurfaceFieldAtTimeStep(vtkPolyData *, vtkMultiBlockDataSet *,
-      const vtkStdString &);
+      const vtkStdString &, vtkFoamFieldArrays *);
 
   void GetPointFieldAtTimeStep(vtkUnstructuredGrid *, vtkMultiBlockDataSet *,
-      const vtkStdString &);
+      const vtkStdString &, vtkFoamFieldArrays *);
   void AddArrayToFieldData(vtkDataSetAttributes *, vtkDataArray *,
       const vtkStdString &);
 
+  // read all the selected fields concurrently
+  struct vtkFoamFieldTasks;
+  void GetFieldsAtTimeStep();
+
   // create lagrangian mesh/fields
   vtkMultiBlockDataSet *MakeLagrangianMesh();
 
   // create point/face/cell zones
-  vtkFoamDict *GatherBlocks(const char *, const int);
-  bool GetPointZoneMesh(vtkMultiBlockDataSet *, vtkPoints *);
-  bool GetFaceZoneMesh(vtkMultiBlockDataSet *, const vtkFoamIntVectorVector *,
+  vtkFoamDict *GatherBlocks(const char *, const int,
+      const vtkFoamEntryFilter * = NULL);
+  void ListZoneNames(const char *);
+  bool HasMissingZones(vtkMultiBlockDataSet *, const char *);
+  bool GetPointZoneMesh(vtkMultiBlockDataSet *, vtkMultiBlockDataSet *,
+      vtkPoints *);
+  bool GetFaceZoneMesh(vtkMultiBlockDataSet *, vtkMultiBlockDataSet *,
+      const vtkFoamIntVectorVector *, vtkPoints *);
+  bool GetCellZoneMesh(vtkMultiBlockDataSet *, vtkMultiBlockDataSet *,
+      const vtkFoamIntVectorVector *, const vtkFoamIntVectorVector *,
       vtkPoints *);
-  bool GetCellZoneMesh(vtkMultiBlockDataSet *, const vtkFoamIntVectorVector *,
+  bool UpdateZoneMeshes(const vtkFoamIntVectorVector *,
       const vtkFoamIntVectorVector *, vtkPoints *);
+  void ExtractCellsToGrid(vtkUnstructuredGrid *, vtkIntArray *);
   void SetShallowCopies(vtkMultiBlockDataSet *, vtkMultiBlockDataSet *,
       const char *);
 };
@@ -425,10 +578,12 @@ vtkStandardNewMacro(vtkOFFReaderPrivate);
 
 //-----------------------------------------------------------------------------
 // struct vtkFoamIntVectorVector
+// a list of label lists in compressed rows, with vtkIdType labels and
+// offsets so that meshes with 64-bit labels are read as they are
 struct vtkFoamIntVectorVector
 {
 private:
-  vtkIntArray *Indices, *Body;
+  vtkIdTypeArray *Indices, *Body;
 
 public:
   ~vtkFoamIntVectorVector()
@@ -444,59 +599,61 @@ public:
     this->Body->Register(0);
   }
   vtkFoamIntVectorVector() :
-    Indices(vtkIntArray::New()), Body(vtkIntArray::New())
+    Indices(vtkIdTypeArray::New()), Body(vtkIdTypeArray::New())
   {
   }
-  vtkFoamIntVectorVector(const int nElements, const int bodyLength) :
-    Indices(vtkIntArray::New()), Body(vtkIntArray::New())
+  vtkFoamIntVectorVector(const vtkIdType nElements,
+      const vtkIdType bodyLength) :
+    Indices(vtkIdTypeArray::New()), Body(vtkIdTypeArray::New())
   {
     this->Indices->SetNumberOfValues(nElements + 1);
     this->Body->SetNumberOfValues(bodyLength);
   }
 
-  // note that vtkIntArray::Resize() allocates (current size + new
+  // note that vtkDataArrayTemplate::Resize() allocates (current size + new
   // size) bytes if current size < new size until 2010-06-27
   // cf. commit c869c3d5875f503e757b64f2fd1ec349aee859bf
-  void ResizeBody(const int bodyLength)
+  void ResizeBody(const vtkIdType bodyLength)
   {
     this->Body->Resize(bodyLength);
   }
 
-  int *WritePointer(const int i, const int bodyI, const int number)
+  vtkIdType *WritePointer(const vtkIdType i, const vtkIdType bodyI,
+      const vtkIdType number)
   {
     return this->Body->WritePointer(*this->Indices->GetPointer(i) = bodyI,
         number);
   }
 
-  int *SetIndex(const int i, const int bodyI)
+  vtkIdType *SetIndex(const vtkIdType i, const vtkIdType bodyI)
   {
     return this->Body->GetPointer(*this->Indices->GetPointer(i) = bodyI);
   }
-  void SetValue(const int bodyI, int value)
+  void SetValue(const vtkIdType bodyI, vtkIdType value)
   {
     this->Body->SetValue(bodyI, value);
   }
-  void InsertValue(const int bodyI, int value)
+  void InsertValue(const vtkIdType bodyI, vtkIdType value)
   {
     this->Body->InsertValue(bodyI, value);
   }
-  const int *operator[](const int i) const
+  const vtkIdType *operator[](const vtkIdType i) const
   {
     return this->Body->GetPointer(this->Indices->GetValue(i));
   }
-  int GetSize(const int i) const
+  vtkIdType GetSize(const vtkIdType i) const
   {
     return this->Indices->GetValue(i + 1) - this->Indices->GetValue(i);
   }
-  int GetNumberOfElements() const
+  vtkIdType GetNumberOfElements() const
   {
     return this->Indices->GetNumberOfTuples() - 1;
   }
-  vtkIntArray *GetIndices()
+  vtkIdTypeArray *GetIndices()
   {
     return this->Indices;
   }
-  vtkIntArray *GetBody()
+  vtkIdTypeArray *GetBody()
   {
     return this->Body;
   }
@@ -522,6 +679,306 @@ public:
   }
 };
 
+//-----------------------------------------------------------------------------
+#if defined(_MSC_VER)
+#define VTK_FOAMFILE_THREAD_LOCAL __declspec(thread)
+#else
+#define VTK_FOAMFILE_THREAD_LOCAL __thread
+#endif
+
+//-----------------------------------------------------------------------------
+// class vtkFoamArena
+// allocator for the nodes and the token strings of a dictionary tree,
+// owned by the parse building the tree. Nodes are carved out of large
+// blocks and recycled through per-size free lists, and short strings
+// are interned and shared among the tokens of the tree, so that
+// building a boundaryField with thousands of patch subdictionaries
+// takes a few allocations. Each node and string is prefixed with its
+// arena, which is released as a whole, blocks, strings and all, once
+// the parse is over and the last reference to it has been freed.
+// Nodes and strings allocated outside of a parse come from the heap.
+//
+// An arena has no lock: the nodes of a tree must never be allocated or
+// freed from two threads at once. This holds since a tree is only ever
+// used by the thread that has parsed it or that it has been handed
+// over to, e. g. a field task parses and deletes its dictionaries on
+// its own worker thread, and since a token copied outside of the parse
+// of its arena gets a string of its own instead of a reference.
+struct vtkFoamArena
+{
+private:
+  friend struct vtkFoamArenaScope;
+
+  enum
+    {
+    GRANULARITY = 16,
+    NSIZECLASSES = VTK_FOAMFILE_ARENA_MAXNODESIZE / 16 + 1,
+    // the size of the node prefix, which keeps the nodes aligned
+    HEADERSIZE = GRANULARITY
+    };
+
+  // the arena of the parse on the calling thread, NULL if none
+  static VTK_FOAMFILE_THREAD_LOCAL vtkFoamArena *Current;
+
+  void *FreeLists[NSIZECLASSES];
+  vtkstd::vector<char *> Blocks;
+  char *BlockPtr;
+  char *BlockEndPtr;
+  // open addressing hash table of interned strings, which live in the
+  // blocks until the arena is released
+  vtkstd::vector<vtkStdString *> Strings;
+  size_t NStrings;
+  // the number of live nodes plus that of the references to interned
+  // strings
+  size_t NNodes;
+  bool IsInUse;
+
+  vtkFoamArena() :
+    Blocks(), BlockPtr(NULL), BlockEndPtr(NULL), Strings(64,
+        static_cast<vtkStdString *>(NULL)), NStrings(0), NNodes(0),
+        IsInUse(true)
+  {
+    for (int classI = 0; classI < NSIZECLASSES; classI++)
+      {
+      this->FreeLists[classI] = NULL;
+      }
+  }
+  ~vtkFoamArena()
+  {
+    for (size_t stringI = 0; stringI < this->Strings.size(); stringI++)
+      {
+      if (this->Strings[stringI] != NULL)
+        {
+        this->Strings[stringI]->~vtkStdString();
+        }
+      }
+    for (size_t blockI = 0; blockI < this->Blocks.size(); blockI++)
+      {
+      ::operator delete(this->Blocks[blockI]);
+      }
+  }
+  vtkFoamArena(const vtkFoamArena &); // not implemented
+  void operator=(const vtkFoamArena &); // not implemented
+
+  static size_t Hash(const char *str, const size_t length)
+  {
+    // FNV-1a
+    size_t hash = 2166136261U;
+    for (size_t i = 0; i < length; i++)
+      {
+      hash = (hash ^ static_cast<unsigned char>(str[i])) * 16777619U;
+      }
+    return hash;
+  }
+
+  void GrowStrings()
+  {
+    vtkstd::vector<vtkStdString *> strings(2 * this->Strings.size(),
+        static_cast<vtkStdString *>(NULL));
+    const size_t mask = strings.size() - 1;
+    for (size_t stringI = 0; stringI < this->Strings.size(); stringI++)
+      {
+      vtkStdString *str = this->Strings[stringI];
+      if (str != NULL)
+        {
+        size_t slotI = Hash(str->data(), str->length()) & mask;
+        while (strings[slotI] != NULL)
+          {
+          slotI = (slotI + 1) & mask;
+          }
+        strings[slotI] = str;
+        }
+      }
+    this->Strings.swap(strings);
+  }
+
+  // returns an interned string and counts the reference to it
+  const vtkStdString *InternString(const char *str, const size_t length)
+  {
+    const size_t hash = Hash(str, length);
+    size_t mask = this->Strings.size() - 1;
+    size_t slotI = hash & mask;
+    for (; this->Strings[slotI] != NULL; slotI = (slotI + 1) & mask)
+      {
+      const vtkStdString *interned = this->Strings[slotI];
+      if (interned->length() == length
+          && memcmp(interned->data(), str, length) == 0)
+        {
+        this->NNodes++;
+        return interned;
+        }
+      }
+    if (2 * (this->NStrings + 1) > this->Strings.size())
+      {
+      this->GrowStrings();
+      mask = this->Strings.size() - 1;
+      for (slotI = hash & mask; this->Strings[slotI] != NULL;
+          slotI = (slotI + 1) & mask)
+        {
+        }
+      }
+    // the node counts as the first reference
+    char *ptr = static_cast<char *>(this->AllocateNode(
+        (HEADERSIZE + sizeof(vtkStdString) + GRANULARITY - 1) / GRANULARITY));
+    *reinterpret_cast<vtkFoamArena **>(ptr) = this;
+    vtkStdString *interned = new (ptr + HEADERSIZE) vtkStdString(str, length);
+    this->Strings[slotI] = interned;
+    this->NStrings++;
+    return interned;
+  }
+
+  void *AllocateNode(const size_t classI)
+  {
+    void *ptr = this->FreeLists[classI];
+    if (ptr != NULL)
+      {
+      this->FreeLists[classI] = *static_cast<void **>(ptr);
+      }
+    else
+      {
+      const size_t nodeSize = classI * GRANULARITY;
+      if (static_cast<size_t>(this->BlockEndPtr - this->BlockPtr) < nodeSize)
+        {
+        this->BlockPtr = static_cast<char *>(
+            ::operator new(VTK_FOAMFILE_ARENA_BLOCKSIZE));
+        this->BlockEndPtr = this->BlockPtr + VTK_FOAMFILE_ARENA_BLOCKSIZE;
+        this->Blocks.push_back(this->BlockPtr);
+        }
+      ptr = this->BlockPtr;
+      this->BlockPtr += nodeSize;
+      }
+    this->NNodes++;
+    return ptr;
+  }
+  void FreeNode(void *ptr, const size_t classI)
+  {
+    *static_cast<void **>(ptr) = this->FreeLists[classI];
+    this->FreeLists[classI] = ptr;
+    this->Release();
+  }
+  void Release()
+  {
+    if (--this->NNodes == 0 && !this->IsInUse)
+      {
+      delete this;
+      }
+  }
+
+public:
+  static void *Allocate(size_t size)
+  {
+    size += HEADERSIZE;
+    vtkFoamArena *arena = Current;
+    char *ptr;
+    if (arena != NULL && size <= VTK_FOAMFILE_ARENA_MAXNODESIZE)
+      {
+      ptr = static_cast<char *>(arena->AllocateNode(
+          (size + GRANULARITY - 1) / GRANULARITY));
+      }
+    else
+      {
+      arena = NULL;
+      ptr = static_cast<char *>(::operator new(size));
+      }
+    *reinterpret_cast<vtkFoamArena **>(ptr) = arena;
+    return ptr + HEADERSIZE;
+  }
+
+  static void Free(void *ptr, size_t size)
+  {
+    if (ptr == NULL)
+      {
+      return;
+      }
+    char *nodePtr = static_cast<char *>(ptr) - HEADERSIZE;
+    vtkFoamArena *arena = *reinterpret_cast<vtkFoamArena **>(nodePtr);
+    if (arena == NULL)
+      {
+      ::operator delete(nodePtr);
+      return;
+      }
+    size += HEADERSIZE;
+    arena->FreeNode(nodePtr, (size + GRANULARITY - 1) / GRANULARITY);
+  }
+
+  // returns a string for a token, interned in the arena of the parse on
+  // the calling thread if short. Use FreeString() to release it.
+  static const vtkStdString *NewString(const char *str, const size_t length)
+  {
+    if (Current != NULL && length <= VTK_FOAMFILE_INTERN_MAXLENGTH)
+      {
+      return Current->InternString(str, length);
+      }
+    return new (Allocate(sizeof(vtkStdString))) vtkStdString(str, length);
+  }
+  static const vtkStdString *NewString(const vtkStdString &str)
+  {
+    return NewString(str.data(), str.length());
+  }
+  // shares an interned string within the parse of its arena only, so
+  // that no other thread ever references the arena
+  static const vtkStdString *CopyString(const vtkStdString *str)
+  {
+    vtkFoamArena *arena = *reinterpret_cast<vtkFoamArena * const *>(
+        reinterpret_cast<const char *>(str) - HEADERSIZE);
+    if (arena != NULL && arena == Current
+        && str->length() <= VTK_FOAMFILE_INTERN_MAXLENGTH)
+      {
+      arena->NNodes++;
+      return str;
+      }
+    return NewString(*str);
+  }
+  static void FreeString(const vtkStdString *str)
+  {
+    vtkFoamArena *arena = *reinterpret_cast<vtkFoamArena * const *>(
+        reinterpret_cast<const char *>(str) - HEADERSIZE);
+    if (arena != NULL && str->length() <= VTK_FOAMFILE_INTERN_MAXLENGTH)
+      {
+      arena->Release();
+      return;
+      }
+    str->~vtkStdString();
+    Free(const_cast<vtkStdString *>(str), sizeof(vtkStdString));
+  }
+};
+
+VTK_FOAMFILE_THREAD_LOCAL vtkFoamArena *vtkFoamArena::Current = NULL;
+
+// makes the nodes allocated on the calling thread within the scope come
+// from an arena of their own if isEnabled. A scope within another one
+// shares the arena of the outer scope.
+struct vtkFoamArenaScope
+{
+private:
+  vtkFoamArena *Arena;
+
+  vtkFoamArenaScope(const vtkFoamArenaScope &); // not implemented
+  void operator=(const vtkFoamArenaScope &); // not implemented
+
+public:
+  vtkFoamArenaScope(const bool isEnabled) :
+    Arena(NULL)
+  {
+    if (isEnabled && vtkFoamArena::Current == NULL)
+      {
+      this->Arena = vtkFoamArena::Current = new vtkFoamArena;
+      }
+  }
+  ~vtkFoamArenaScope()
+  {
+    if (this->Arena != NULL)
+      {
+      vtkFoamArena::Current = NULL;
+      this->Arena->IsInUse = false;
+      if (this->Arena->NNodes == 0)
+        {
+        delete this->Arena;
+        }
+      }
+  }
+};
+
 //-----------------------------------------------------------------------------
 // class vtkFoamToken
 // token class which also works as container for list types
@@ -550,9 +1007,11 @@ protected:
   union
   {
     char Char;
-    int Int;
+    // wide enough for the labels and the list sizes of meshes with more
+    // than 2^31 faces
+    vtkTypeInt64 Int;
     double Double;
-    vtkStdString* String;
+    const vtkStdString* String;
     vtkObjectBase *VtkObjectPtr;
     // vtkObject-derived list types
     vtkIntArray *LabelListPtr;
@@ -568,7 +1027,7 @@ protected:
   {
     if (this->Type == WORD || this->Type == STRING || this->Type == IDENTIFIER)
       {
-      delete this->String;
+      vtkFoamArena::FreeString(this->String);
       }
   }
 
@@ -588,7 +1047,7 @@ protected:
       case WORD:
       case STRING:
       case IDENTIFIER:
-        this->String = new vtkStdString(*value.String);
+        this->String = vtkFoamArena::CopyString(value.String);
         break;
         // required to suppress the 'enumeration value not handled' warning by
         // g++ when compiled with -Wall
@@ -632,7 +1091,13 @@ public:
   // workaround for SunOS-CC5.6-dbg
   int ToInt() const
   {
-    return this->Int;
+    return static_cast<int>(this->Int);
+  }
+
+  // a label as a mesh label, which is not narrowed with 64-bit ids
+  vtkIdType ToIdType() const
+  {
+    return static_cast<vtkIdType>(this->Int);
   }
 
   // workaround for SunOS-CC5.6-dbg
@@ -679,6 +1144,12 @@ public:
     this->Type = LABEL;
     this->Int = value;
   }
+  void operator=(const vtkTypeInt64 value)
+  {
+    this->Clear();
+    this->Type = LABEL;
+    this->Int = value;
+  }
   void operator=(const double value)
   {
     this->Clear();
@@ -689,13 +1160,13 @@ public:
   {
     this->Clear();
     this->Type = STRING;
-    this->String = new vtkStdString(value);
+    this->String = vtkFoamArena::NewString(value, strlen(value));
   }
   void operator=(const vtkStdString& value)
   {
     this->Clear();
     this->Type = STRING;
-    this->String = new vtkStdString(value);
+    this->String = vtkFoamArena::NewString(value);
   }
   void operator=(const vtkFoamToken& value)
   {
@@ -774,7 +1245,7 @@ VTK_TEMPLATE_SPECIALIZE inline bool vtkFoamToken::Is<double>() const
 
 VTK_TEMPLATE_SPECIALIZE inline int vtkFoamToken::To<int>() const
 {
-  return this->Int;
+  return static_cast<int>(this->Int);
 }
 
 VTK_TEMPLATE_SPECIALIZE inline float vtkFoamToken::To<float>() const
@@ -787,6 +1258,19 @@ VTK_TEMPLATE_SPECIALIZE inline double vtkFoamToken::To<double>() const
   return this->Type == LABEL ? this->Int : this->Double;
 }
 
+// vtkIdType is distinct from int only with 64-bit ids
+#ifdef VTK_USE_64BIT_IDS
+VTK_TEMPLATE_SPECIALIZE inline bool vtkFoamToken::Is<vtkIdType>() const
+{
+  return this->Type == LABEL;
+}
+
+VTK_TEMPLATE_SPECIALIZE inline vtkIdType vtkFoamToken::To<vtkIdType>() const
+{
+  return static_cast<vtkIdType>(this->Int);
+}
+#endif
+
 //-----------------------------------------------------------------------------
 // class vtkFoamFileStack
 // list of variables that have to be saved when a file is included.
@@ -796,6 +1280,9 @@ protected:
   vtkStdString FileName;
   FILE *File;
   bool IsCompressed;
+  // true if Outbuf points to a memory-mapped file of MapSize bytes
+  bool IsMapped;
+  size_t MapSize;
   z_stream Z;
   int ZStatus;
   int LineNumber;
@@ -810,7 +1297,8 @@ protected:
   unsigned char *BufEndPtr;
 
   vtkFoamFileStack() :
-    FileName(), File(NULL), IsCompressed(false), ZStatus(Z_OK), LineNumber(0),
+    FileName(), File(NULL), IsCompressed(false), IsMapped(false), MapSize(0),
+        ZStatus(Z_OK), LineNumber(0),
 #if VTK_FOAMFILE_RECOGNIZE_LINEHEAD
         WasNewline(true),
 #endif
@@ -826,6 +1314,8 @@ protected:
     // this->FileName = "";
     this->File = NULL;
     this->IsCompressed = false;
+    this->IsMapped = false;
+    this->MapSize = 0;
     // this->ZStatus = Z_OK;
     this->Z.zalloc = Z_NULL;
     this->Z.zfree = Z_NULL;
@@ -943,7 +1433,18 @@ private:
       }
 
     delete [] this->Superclass::Inbuf;
-    delete [] this->Superclass::Outbuf;
+#if VTK_FOAMFILE_USE_MMAP
+    if (this->Superclass::IsMapped)
+      {
+      munmap(this->Superclass::Outbuf, this->Superclass::MapSize);
+      this->Superclass::IsMapped = false;
+      this->Superclass::MapSize = 0;
+      }
+    else
+#endif
+      {
+      delete [] this->Superclass::Outbuf;
+      }
     this->Superclass::Inbuf = this->Superclass::Outbuf = NULL;
 
     if (this->Superclass::File)
@@ -1232,9 +1733,13 @@ public:
           } while (isdigit(c = this->Getc()) && charI < MAXLEN);
         if (c != '.' && c != 'e' && c != 'E' && charI < MAXLEN && c != EOF)
           {
-          // label token
-          buf[charI] = '\0';
-          token = static_cast<int>(strtol(buf, NULL, 10));
+          // label token, in 64 bits since strtol() may not be
+          vtkTypeInt64 value = 0;
+          for (int digitI = (buf[0] == '-' ? 1 : 0); digitI < charI; digitI++)
+            {
+            value = 10 * value + buf[digitI] - 48; // '0' == 48
+            }
+          token = buf[0] == '-' ? -value : value;
           this->PutBack(c);
           return true;
           }
@@ -1498,16 +2003,74 @@ public:
       {
       // uncompressed format
       this->Superclass::IsCompressed = false;
+#if VTK_FOAMFILE_USE_MMAP
+      this->MapFile();
+#endif
       }
     rewind(this->Superclass::File);
 
     this->Superclass::ZStatus = Z_OK;
-    this->Superclass::Outbuf = new unsigned char[VTK_FOAMFILE_OUTBUFSIZE + 1];
-    this->Superclass::BufPtr = this->Superclass::Outbuf + 1;
-    this->Superclass::BufEndPtr = this->Superclass::BufPtr;
+    if (!this->Superclass::IsMapped)
+      {
+      this->Superclass::Outbuf = new unsigned char[VTK_FOAMFILE_OUTBUFSIZE + 1];
+      this->Superclass::BufPtr = this->Superclass::Outbuf + 1;
+      this->Superclass::BufEndPtr = this->Superclass::BufPtr;
+      }
     this->Superclass::LineNumber = 1;
   }
 
+#if VTK_FOAMFILE_USE_MMAP
+  // map the whole of an uncompressed file so that BufPtr / BufEndPtr
+  // walk through the file contents directly. Falls back to the
+  // buffered fread() path silently if the file can't be mapped.
+  // Accessing a mapping beyond the end of a file truncated meanwhile
+  // raises SIGBUS, thus neither a file nor the files of a directory
+  // modified recently, e. g. those of the time directory a running
+  // solver is writing, are mapped.
+  void MapFile()
+  {
+    struct stat fileStat;
+    const int fd = fileno(this->Superclass::File);
+    if (fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode)
+        || fileStat.st_size < VTK_FOAMFILE_MMAP_MINSIZE)
+      {
+      return;
+      }
+    const long minMTime = static_cast<long>(time(NULL))
+        - VTK_FOAMFILE_MTIME_MARGIN;
+    if (static_cast<long>(fileStat.st_mtime) >= minMTime)
+      {
+      return;
+      }
+    const vtkStdString &fileName = this->Superclass::FileName;
+    const size_t slashPos = fileName.rfind('/');
+    struct stat dirStat;
+    if (stat(slashPos == vtkStdString::npos ? "."
+        : fileName.substr(0, slashPos + 1).c_str(), &dirStat) != 0
+        || static_cast<long>(dirStat.st_mtime) >= minMTime)
+      {
+      return;
+      }
+    const size_t mapSize = static_cast<size_t>(fileStat.st_size);
+    // a private writable mapping is required since PutBack() writes
+    // back to the buffer; only the touched pages get copied
+    void *mapPtr = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+        fd, 0);
+    if (mapPtr == MAP_FAILED)
+      {
+      return;
+      }
+#if defined(MADV_SEQUENTIAL)
+    madvise(mapPtr, mapSize, MADV_SEQUENTIAL);
+#endif
+    this->Superclass::IsMapped = true;
+    this->Superclass::MapSize = mapSize;
+    this->Superclass::Outbuf = static_cast<unsigned char *>(mapPtr);
+    this->Superclass::BufPtr = this->Superclass::Outbuf;
+    this->Superclass::BufEndPtr = this->Superclass::Outbuf + mapSize;
+  }
+#endif
+
   void Close()
   {
     while (this->CloseIncludedFile())
@@ -1519,7 +2082,11 @@ public:
   int Read(unsigned char *buf, const int len)
   {
     int readlen;
-    const int buflen = this->Superclass::BufEndPtr - this->Superclass::BufPtr;
+    // the distance may exceed the range of int if the file is mapped
+    const size_t bufSize = static_cast<size_t>(this->Superclass::BufEndPtr
+        - this->Superclass::BufPtr);
+    const int buflen = bufSize < static_cast<size_t>(len)
+        ? static_cast<int>(bufSize) : len;
     if (len > buflen)
       {
       memcpy(buf, this->Superclass::BufPtr, buflen);
@@ -1557,6 +2124,120 @@ public:
     return readlen;
   }
 
+  // the unread part of the buffer, which is the whole rest of the file
+  // if it is mapped
+  const unsigned char *GetBufferBegin() const
+  {
+    return this->Superclass::BufPtr;
+  }
+  const unsigned char *GetBufferEnd() const
+  {
+    return this->Superclass::BufEndPtr;
+  }
+
+  // skips len bytes of binary data
+  void Skip(size_t len)
+  {
+    unsigned char buf[VTK_FOAMFILE_INBUFSIZE];
+    while (len > 0)
+      {
+      const size_t bufSize = static_cast<size_t>(this->Superclass::BufEndPtr
+          - this->Superclass::BufPtr);
+      if (bufSize > 0)
+        {
+        const size_t skipSize = bufSize < len ? bufSize : len;
+        this->Superclass::BufPtr += skipSize;
+        len -= skipSize;
+        }
+      else
+        {
+        const int readSize = static_cast<int>(len < sizeof(buf)
+            ? len : sizeof(buf));
+        if (this->Read(buf, readSize) != readSize)
+          {
+          this->ThrowUnexpectedEOFException();
+          }
+        len -= readSize;
+        }
+      }
+  }
+
+  // skips the rest of an ASCII list whose opening parenthesis has
+  // already been read by bracket matching, without tokenizing. As with
+  // Read(), parentheses in comments and strings do not count.
+  void SkipAsciiList()
+  {
+    int depth = 1, c = this->Getc();
+    while (c != EOF)
+      {
+      if (c == '(')
+        {
+        depth++;
+        }
+      else if (c == ')')
+        {
+        if (--depth == 0)
+          {
+          return;
+          }
+        }
+      else if (c == '\n')
+        {
+        ++this->Superclass::LineNumber;
+        }
+      else if (c == '/')
+        {
+        // NextTokenHead() returns the character following the comments
+        // or the slash itself if it does not start a comment
+        this->PutBack(c);
+        if ((c = this->NextTokenHead()) != '/')
+          {
+          continue;
+          }
+        }
+      else if (c == '"')
+        {
+        bool wasEscape = false;
+        while ((c = this->Getc()) != EOF && (c != '"' || wasEscape))
+          {
+          if (c == '\n')
+            {
+            ++this->Superclass::LineNumber;
+            }
+          wasEscape = (c == '\\' && !wasEscape);
+          }
+        if (c == EOF)
+          {
+          break;
+          }
+        }
+      c = this->Getc();
+      }
+    this->ThrowUnexpectedEOFException();
+  }
+
+  // returns a pointer to the next len bytes in the buffer and skips
+  // them if they are contiguously available there, which is always
+  // the case for a mapped file. Returns NULL otherwise.
+  const unsigned char *ReadDirect(const size_t len)
+  {
+    if (static_cast<size_t>(this->Superclass::BufEndPtr
+        - this->Superclass::BufPtr) < len)
+      {
+      return NULL;
+      }
+    const unsigned char *ptr = this->Superclass::BufPtr;
+    this->Superclass::BufPtr += len;
+    const unsigned char *endPtr = this->Superclass::BufPtr;
+    for (const unsigned char *nlPtr = ptr; (nlPtr = static_cast<const
+        unsigned char *>(memchr(nlPtr, '\n', endPtr - nlPtr))) != NULL;
+        nlPtr++)
+      {
+      this->Superclass::LineNumber++;
+      }
+    return ptr;
+  }
+
   void ReadExpecting(const char expected)
   {
     // skip prepending invalid chars
@@ -1593,7 +2274,11 @@ public:
       }
   }
 
-  int ReadIntValue();
+  int ReadIntValue()
+  {
+    return static_cast<int>(this->ReadLabelValue());
+  }
+  vtkTypeInt64 ReadLabelValue();
   float ReadFloatValue();
 };
 
@@ -1606,9 +2291,10 @@ int vtkFoamFile::ReadNext()
   return *this->Superclass::BufPtr++;
 }
 
-// specialized for reading an integer value.
+// specialized for reading an integer value, in 64 bits for the labels
+// of large meshes.
 // not using the standard strtol() for speed reason.
-int vtkFoamFile::ReadIntValue()
+vtkTypeInt64 vtkFoamFile::ReadLabelValue()
 {
   // skip prepending invalid chars
   // expanded the outermost loop in nextTokenHead() for performance
@@ -1657,7 +2343,7 @@ int vtkFoamFile::ReadIntValue()
       }
     }
 
-  int num = c - 48; // '0' == 48
+  vtkTypeInt64 num = c - 48; // '0' == 48
   while (isdigit(c = this->Getc()))
     {
     num = 10 * num + c - 48;
@@ -1849,7 +2535,12 @@ bool vtkFoamFile::InflateNext(unsigned char *buf,
     int requestSize)
 {
   size_t size;
-  if (this->Superclass::IsCompressed)
+  if (this->Superclass::IsMapped)
+    {
+    // the whole file is already in the buffer
+    return false;
+    }
+  else if (this->Superclass::IsCompressed)
     {
     if (this->Superclass::ZStatus != Z_OK)
       {
@@ -1997,14 +2688,45 @@ private:
   vtkStdString HeaderClassName;
   bool Is13Positions;
   bool IsSinglePrecisionBinary;
+  bool Use64BitLabels;
   vtkFoamError E;
 
-  vtkFoamIOobject();
-  void ReadHeader(); // defined later
+  // entries not accepted by the filter are skipped while reading. The
+  // keyword path to the entry being read is kept only with a filter.
+  const vtkFoamEntryFilter *EntryFilter;
+  vtkstd::vector<vtkStdString> KeywordPath;
+
+  // the entries skipped so far by the dictionaries they would belong
+  // to, and the keyword paths of those found to be referenced by a
+  // $identifier, which are not to be skipped when reading the file
+  // again
+  struct skippedEntry
+    {
+    const vtkFoamDict *Dict;
+    vtkstd::vector<vtkStdString> KeywordPath;
+    };
+  vtkstd::vector<skippedEntry> SkippedEntries;
+  vtkstd::vector<vtkstd::vector<vtkStdString> > ReferencedPaths;
+
+  // the list of the top level entry GatherKeyword is reduced to the
+  // tuples at GatherIndices while being read. Requires a filter for
+  // the keyword path to be available.
+  vtkStdString GatherKeyword;
+  vtkIdTypeArray *GatherIndices;
+
+  // bytes of binary floating point lists read and the time taken
+  double BinaryListBytes;
+  double BinaryListTime;
+
+  vtkFoamIOobject();
+  void ReadHeader(); // defined later
 public:
   vtkFoamIOobject(const vtkStdString& casePath, const bool isSinglePrecisionBinary) :
     vtkFoamFile(casePath), Format(UNDEFINED), Is13Positions(false),
-    IsSinglePrecisionBinary(isSinglePrecisionBinary), E()
+    IsSinglePrecisionBinary(isSinglePrecisionBinary), Use64BitLabels(false),
+    E(), EntryFilter(NULL), KeywordPath(), SkippedEntries(), ReferencedPaths(),
+    GatherKeyword(), GatherIndices(NULL), BinaryListBytes(0.0),
+    BinaryListTime(0.0)
   {
   }
   ~vtkFoamIOobject()
@@ -2043,7 +2765,12 @@ public:
     this->Format = UNDEFINED;
     this->ObjectName.erase();
     this->HeaderClassName.erase();
+    this->Use64BitLabels = false;
     this->E.erase();
+    this->KeywordPath.clear();
+    this->SkippedEntries.clear();
+    this->BinaryListBytes = 0.0;
+    this->BinaryListTime = 0.0;
   }
   fileFormat GetFormat() const
   {
@@ -2053,6 +2780,11 @@ public:
   {
     return this->HeaderClassName;
   }
+  // true if binary labels are 64-bit (WM_LABEL_SIZE=64)
+  bool GetUse64BitLabels() const
+  {
+    return this->Use64BitLabels;
+  }
   const vtkStdString& GetObjectName() const
   {
     return this->ObjectName;
@@ -2077,8 +2809,246 @@ public:
   {
     return this->IsSinglePrecisionBinary;
   }
+  void AddBinaryListStatistics(const double bytes, const double time)
+  {
+    this->BinaryListBytes += bytes;
+    this->BinaryListTime += time;
+  }
+  double GetBinaryListBytes() const
+  {
+    return this->BinaryListBytes;
+  }
+  double GetBinaryListTime() const
+  {
+    return this->BinaryListTime;
+  }
+
+  // the referenced paths are kept by a filter only while it is set
+  void SetEntryFilter(const vtkFoamEntryFilter *filter)
+  {
+    this->EntryFilter = filter;
+    this->ReferencedPaths.clear();
+  }
+  bool GetHasEntryFilter() const
+  {
+    return this->EntryFilter != NULL;
+  }
+  // the keyword path is maintained by vtkFoamDict::Read()
+  void PushKeyword(const vtkStdString &keyword)
+  {
+    this->KeywordPath.push_back(keyword);
+  }
+  void PopKeyword()
+  {
+    this->KeywordPath.pop_back();
+  }
+  void SetGather(const vtkStdString &keyword, vtkIdTypeArray *indices)
+  {
+    this->GatherKeyword = keyword;
+    this->GatherIndices = indices;
+  }
+  // the indices to be gathered if the entry being read is the one
+  // given to SetGather(), NULL otherwise
+  vtkIdTypeArray *GetGatherIndices() const
+  {
+    return this->GatherIndices != NULL && this->KeywordPath.size() == 1
+        && this->KeywordPath[0] == this->GatherKeyword
+        ? this->GatherIndices : NULL;
+  }
+  // the number of the skipped entries found to be referenced, which
+  // increases if reading has failed for a reference to one
+  size_t GetNumberOfReferencedPaths() const
+  {
+    return this->ReferencedPaths.size();
+  }
+  bool IsEntryWanted(const vtkStdString &keyword); // defined later
+  // skips the entry with the given keyword of dict
+  void SkipEntry(const vtkFoamDict *dict, const vtkStdString &keyword);
+  // throws if the entry with the given keyword of dict has been
+  // skipped, after recording it as referenced
+  void CheckSkippedEntry(const vtkFoamDict *dict,
+      const vtkStdString &keyword); // defined later
+private:
+  void SkipEntry(); // defined later
+};
+
+//-----------------------------------------------------------------------------
+// class vtkFoamKeywordScope
+// pushes a keyword to the keyword path of an IOobject reading with an
+// entry filter for the lifetime of the scope, so that the path is kept
+// when reading the entry throws
+struct vtkFoamKeywordScope
+{
+private:
+  vtkFoamIOobject &IO;
+  const bool IsPushed;
+
+  vtkFoamKeywordScope(const vtkFoamKeywordScope &); // not implemented
+  void operator=(const vtkFoamKeywordScope &); // not implemented
+
+public:
+  vtkFoamKeywordScope(vtkFoamIOobject &io, const vtkStdString &keyword) :
+    IO(io), IsPushed(io.GetHasEntryFilter())
+  {
+    if (this->IsPushed)
+      {
+      this->IO.PushKeyword(keyword);
+      }
+  }
+  ~vtkFoamKeywordScope()
+  {
+    if (this->IsPushed)
+      {
+      this->IO.PopKeyword();
+      }
+  }
 };
 
+//-----------------------------------------------------------------------------
+// class vtkFoamEntryFilter
+// decides which entries of a dictionary tree are read by
+// vtkFoamDict::Read(). Rejected entries are skipped without being
+// parsed and are absent from the resulting dictionary.
+struct vtkFoamEntryFilter
+{
+  virtual ~vtkFoamEntryFilter()
+  {
+  }
+  // keywordPath holds the keywords from the top level dictionary down
+  // to the entry in question
+  virtual bool IsWanted(const vtkstd::vector<vtkStdString> &keywordPath)
+      const = 0;
+};
+
+// the entries on the way to or within a referenced entry are always
+// wanted
+bool vtkFoamIOobject::IsEntryWanted(const vtkStdString &keyword)
+{
+  this->KeywordPath.push_back(keyword);
+  bool isWanted = this->EntryFilter->IsWanted(this->KeywordPath);
+  for (size_t pathI = 0; !isWanted && pathI < this->ReferencedPaths.size();
+      pathI++)
+    {
+    const vtkstd::vector<vtkStdString> &path = this->ReferencedPaths[pathI];
+    const size_t n = vtkstd::min(path.size(), this->KeywordPath.size());
+    isWanted = vtkstd::equal(path.begin(), path.begin() + n,
+        this->KeywordPath.begin());
+    }
+  this->KeywordPath.pop_back();
+  return isWanted;
+}
+
+void vtkFoamIOobject::SkipEntry(const vtkFoamDict *dict,
+    const vtkStdString &keyword)
+{
+  this->SkipEntry();
+  skippedEntry entry;
+  entry.Dict = dict;
+  entry.KeywordPath = this->KeywordPath;
+  entry.KeywordPath.push_back(keyword);
+  this->SkippedEntries.push_back(entry);
+}
+
+void vtkFoamIOobject::CheckSkippedEntry(const vtkFoamDict *dict,
+    const vtkStdString &keyword)
+{
+  for (size_t entryI = 0; entryI < this->SkippedEntries.size(); entryI++)
+    {
+    const skippedEntry &entry = this->SkippedEntries[entryI];
+    if (entry.Dict == dict && entry.KeywordPath.back() == keyword)
+      {
+      this->ReferencedPaths.push_back(entry.KeywordPath);
+      throw vtkFoamError() << "Skipped entry " << keyword
+          << " is referenced";
+      }
+    }
+}
+
+// skips the value of an entry whose keyword has already been read, up
+// to and including the terminating ';' or the closing brace of a
+// subdictionary. Binary lists are skipped using the size prefix and
+// the element type given by a preceding List<Type>. The other lists
+// are read as the full parser does: the lists of the types it reads
+// as binary and ASCII lists of any other type.
+void vtkFoamIOobject::SkipEntry()
+{
+  const int realSize = this->IsSinglePrecisionBinary ? sizeof(float)
+      : sizeof(double);
+  const int labelSize = this->Use64BitLabels ? sizeof(vtkTypeInt64)
+      : sizeof(int);
+  vtkFoamToken currToken;
+  int depth = 0, listSize = -1, elementSize = 0;
+  bool isDictionary = false, isNonuniform = false;
+  while (this->Superclass::Read(currToken))
+    {
+    if (currToken.GetType() == vtkFoamToken::LABEL)
+      {
+      listSize = currToken.To<int>();
+      isNonuniform = false;
+      continue;
+      }
+    if (currToken.IsWordOrString())
+      {
+      const vtkStdString &word = currToken.ToStdString();
+      // List<bool> is read as List<label>
+      elementSize = (word == "List<label>" || word == "List<bool>"
+          ? labelSize : word == "List<scalar>" ? realSize
+          : word == "List<sphericalTensor>" ? realSize
+          : word == "List<vector>" ? 3 * realSize
+          : word == "List<symmTensor>" ? 6 * realSize
+          : word == "List<tensor>" ? 9 * realSize : 0);
+      if (isNonuniform && elementSize == 0)
+        {
+        throw vtkFoamError() << "Unsupported nonuniform list type "
+            << currToken;
+        }
+      isNonuniform = (word == "nonuniform");
+      listSize = -1;
+      continue;
+      }
+    isNonuniform = false;
+    if (currToken == '(' && listSize >= 0)
+      {
+      if (this->Format == BINARY && listSize > 0 && elementSize > 0)
+        {
+        this->Superclass::Skip(static_cast<size_t>(listSize) * elementSize);
+        this->Superclass::ReadExpecting(')');
+        }
+      else
+        {
+        this->Superclass::SkipAsciiList();
+        }
+      elementSize = 0;
+      }
+    else if (currToken == '(' || currToken == '[' || currToken == '{')
+      {
+      if (depth == 0)
+        {
+        isDictionary = (currToken == '{');
+        }
+      depth++;
+      }
+    else if (currToken == ')' || currToken == ']' || currToken == '}')
+      {
+      if (--depth < 0)
+        {
+        throw vtkFoamError() << "Unexpected " << currToken
+            << " while skipping an entry";
+        }
+      if (depth == 0 && isDictionary)
+        {
+        return;
+        }
+      }
+    else if (currToken == ';' && depth == 0)
+      {
+      return;
+      }
+    listSize = -1;
+    }
+  throw vtkFoamError() << "Unexpected EOF while skipping an entry";
+}
+
 //-----------------------------------------------------------------------------
 // workarounding class for older compilers (gcc-3.3.x and possibly older)
 template <typename T> struct vtkFoamReadValue
@@ -2097,258 +3067,1275 @@ VTK_TEMPLATE_SPECIALIZE inline float vtkFoamReadValue<float>::ReadValue(vtkFoamI
   return io.ReadFloatValue();
 }
 
+#ifdef VTK_USE_64BIT_IDS
+VTK_TEMPLATE_SPECIALIZE inline vtkIdType vtkFoamReadValue<vtkIdType>::ReadValue(vtkFoamIOobject& io)
+{
+  return static_cast<vtkIdType>(io.ReadLabelValue());
+}
+#endif
+
 //-----------------------------------------------------------------------------
-// class vtkFoamEntryValue
-// a class that represents a value of a dictionary entry that corresponds to
-// its keyword. note that an entry can have more than one value.
-struct vtkFoamEntryValue : public vtkFoamToken
+// the maximum number of threads the parallel loops below may run on,
+// per calling thread. Set from NumberOfThreads by the reader, and to 1
+// on the worker threads so that loops nested in the tasks of another
+// loop run serially. 0 leaves it to vtkMultiThreader.
+static VTK_FOAMFILE_THREAD_LOCAL int vtkFoamMaxThreads = 0;
+
+static vtkIdType vtkFoamGetMaxThreads()
+{
+  const vtkIdType nThreads
+      = vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  return vtkFoamMaxThreads > 0 && vtkFoamMaxThreads < nThreads
+      ? vtkFoamMaxThreads : nThreads;
+}
+
+// limits the number of threads within a scope. The limit is only ever
+// lowered, and restored at the end of the scope.
+struct vtkFoamMaxThreadsScope
 {
-public:
-  enum uniformTypes
-    {UNDEFINED, UNIFORM, NONUNIFORM};
 private:
-  typedef vtkFoamToken Superclass;
+  int MaxThreadsOld;
 
-  uniformTypes IsUniform;
-  bool Managed;
-  const vtkFoamEntry *UpperEntryPtr;
+  vtkFoamMaxThreadsScope(const vtkFoamMaxThreadsScope &); // not implemented
+  void operator=(const vtkFoamMaxThreadsScope &); // not implemented
 
-  vtkFoamEntryValue();
-  vtkObjectBase *ToVTKObject()
+public:
+  vtkFoamMaxThreadsScope(const int maxThreads)
+    : MaxThreadsOld(vtkFoamMaxThreads)
   {
-    return this->Superclass::VtkObjectPtr;
+    if (maxThreads > 0
+        && (vtkFoamMaxThreads <= 0 || maxThreads < vtkFoamMaxThreads))
+      {
+      vtkFoamMaxThreads = maxThreads;
+      }
   }
-  void Clear();
-  void ReadList(vtkFoamIOobject& io);
+  ~vtkFoamMaxThreadsScope()
+  {
+    vtkFoamMaxThreads = this->MaxThreadsOld;
+  }
+};
+
+//-----------------------------------------------------------------------------
+// error, warning and debug messages of a task run on a worker thread,
+// where vtkErrorMacro() and the like must not be called. The task sets
+// itself as the sink of the thread, and the calling thread emits the
+// collected messages once the tasks are finished.
+struct vtkFoamMessageSink
+{
+  enum messageTypes
+    {
+    MESSAGE_ERROR, MESSAGE_WARNING, MESSAGE_DEBUG
+    };
+  struct message
+    {
+    messageTypes Type;
+    vtkStdString Text;
+    };
+  vtkstd::vector<message> Messages;
+
+  void Add(const messageTypes type, const vtksys_ios::ostringstream &text)
+  {
+    message m;
+    m.Type = type;
+    m.Text = text.str();
+    this->Messages.push_back(m);
+  }
+};
+
+static VTK_FOAMFILE_THREAD_LOCAL vtkFoamMessageSink *vtkFoamMessages = NULL;
+
+// sets the message sink of the calling thread within a scope
+struct vtkFoamMessageSinkScope
+{
+private:
+  vtkFoamMessageSink *SinkOld;
+
+  vtkFoamMessageSinkScope(const vtkFoamMessageSinkScope &); // not implemented
+  void operator=(const vtkFoamMessageSinkScope &); // not implemented
 
 public:
-  // reads primitive int/float lists
-  template <typename listT, typename primitiveT> class listTraits
+  vtkFoamMessageSinkScope(vtkFoamMessageSink *sink)
+    : SinkOld(vtkFoamMessages)
   {
-    listT *Ptr;
+    vtkFoamMessages = sink;
+  }
+  ~vtkFoamMessageSinkScope()
+  {
+    vtkFoamMessages = this->SinkOld;
+  }
+};
 
-  public:
-    listTraits() :
-      Ptr(listT::New())
+// vtkErrorMacro(), vtkWarningMacro() and vtkDebugWithObjectMacro()
+// that defer the message to the sink of the thread if there is one
+#define vtkFoamErrorMacro(x) \
+  do \
+    { \
+    if (vtkFoamMessages != NULL) \
+      { \
+      vtksys_ios::ostringstream vtkfoammsg; \
+      vtkfoammsg << "" x; \
+      vtkFoamMessages->Add(vtkFoamMessageSink::MESSAGE_ERROR, vtkfoammsg); \
+      } \
+    else \
+      { \
+      vtkErrorMacro(x); \
+      } \
+    } while (0)
+
+#define vtkFoamWarningMacro(x) \
+  do \
+    { \
+    if (vtkFoamMessages != NULL) \
+      { \
+      vtksys_ios::ostringstream vtkfoammsg; \
+      vtkfoammsg << "" x; \
+      vtkFoamMessages->Add(vtkFoamMessageSink::MESSAGE_WARNING, \
+          vtkfoammsg); \
+      } \
+    else \
+      { \
+      vtkWarningMacro(x); \
+      } \
+    } while (0)
+
+#define vtkFoamDebugWithObjectMacro(self, x) \
+  do \
+    { \
+    if (vtkFoamMessages == NULL) \
+      { \
+      vtkDebugWithObjectMacro(self, x); \
+      } \
+    else if ((self)->GetDebug()) \
+      { \
+      vtksys_ios::ostringstream vtkfoammsg; \
+      vtkfoammsg << "" x; \
+      vtkFoamMessages->Add(vtkFoamMessageSink::MESSAGE_DEBUG, vtkfoammsg); \
+      } \
+    } while (0)
+
+//-----------------------------------------------------------------------------
+// runs functor(begin, end) over contiguous subranges of [0, size) on
+// up to vtkFoamGetMaxThreads() threads, each thread taking at least
+// minSize elements. The functor must not throw.
+template <typename functorT> struct vtkFoamParallelForInfo
+{
+  functorT *Functor;
+  vtkIdType Size;
+};
+
+template <typename functorT>
+VTK_THREAD_RETURN_TYPE vtkFoamParallelForThread(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info
+      = static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkFoamParallelForInfo<functorT> *forInfo
+      = static_cast<vtkFoamParallelForInfo<functorT> *>(info->UserData);
+  // thread 0 is the calling thread, whose limit is restored
+  vtkFoamMaxThreadsScope serial(1);
+  const vtkIdType nThreads = info->NumberOfThreads;
+  (*forInfo->Functor)(forInfo->Size * info->ThreadID / nThreads,
+      forInfo->Size * (info->ThreadID + 1) / nThreads);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+template <typename functorT>
+void vtkFoamParallelFor(const vtkIdType size, const vtkIdType minSize,
+    functorT &functor)
+{
+  vtkIdType nThreads = vtkFoamGetMaxThreads();
+  if (minSize <= 0 || size / minSize < nThreads)
     {
+    nThreads = minSize <= 0 ? 1 : size / minSize;
     }
-    listT *GetPtr()
+  if (nThreads <= 1)
     {
-      return this->Ptr;
+    functor(0, size);
+    return;
     }
-    void ReadUniformValues(vtkFoamIOobject& io, const int size)
+
+  vtkFoamParallelForInfo<functorT> forInfo;
+  forInfo.Functor = &functor;
+  forInfo.Size = size;
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(static_cast<int>(nThreads));
+  threader->SetSingleMethod(vtkFoamParallelForThread<functorT>, &forInfo);
+  threader->SingleMethodExecute();
+  threader->Delete();
+}
+
+//-----------------------------------------------------------------------------
+// runs functor(taskI) for each taskI in [0, nTasks) on up to maxThreads
+// threads (up to vtkFoamGetMaxThreads() if maxThreads <= 0). Parallel
+// loops run by the tasks are run serially.
+// The tasks are handed out one at a time in ascending order so that
+// tasks of different lengths balance out. The functor must not throw.
+template <typename functorT> struct vtkFoamParallelTasksInfo
+{
+  functorT *Functor;
+  vtkIdType NTasks;
+  vtkIdType NextTask;
+  vtkSimpleMutexLock Lock;
+};
+
+template <typename functorT>
+VTK_THREAD_RETURN_TYPE vtkFoamParallelTasksThread(void *arg)
+{
+  vtkMultiThreader::ThreadInfo *info
+      = static_cast<vtkMultiThreader::ThreadInfo *>(arg);
+  vtkFoamParallelTasksInfo<functorT> *tasksInfo
+      = static_cast<vtkFoamParallelTasksInfo<functorT> *>(info->UserData);
+  vtkFoamMaxThreadsScope serial(1);
+  for (;;)
     {
-      primitiveT value = vtkFoamReadValue<primitiveT>::ReadValue(io);
-      for (int i = 0; i < size; i++)
-        {
-        this->Ptr->SetValue(i, value);
-        }
+    tasksInfo->Lock.Lock();
+    const vtkIdType taskI = tasksInfo->NextTask++;
+    tasksInfo->Lock.Unlock();
+    if (taskI >= tasksInfo->NTasks)
+      {
+      break;
+      }
+    (*tasksInfo->Functor)(taskI);
     }
-    void ReadAsciiList(vtkFoamIOobject& io, const int size)
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+template <typename functorT>
+void vtkFoamParallelTasks(const vtkIdType nTasks, const int maxThreads,
+    functorT &functor)
+{
+  vtkIdType nThreads = vtkFoamGetMaxThreads();
+  if (maxThreads > 0 && maxThreads < nThreads)
     {
-      for (int i = 0; i < size; i++)
-        {
-        this->Ptr->SetValue(i, vtkFoamReadValue<primitiveT>::ReadValue(io));
-        }
+    nThreads = maxThreads;
     }
-    void ReadBinaryList(vtkFoamIOobject& io, const int size)
+  if (nTasks < nThreads)
     {
-      io.Read(reinterpret_cast<unsigned char *>(this->Ptr->GetPointer(0)), size
-          * sizeof(primitiveT));
+    nThreads = nTasks;
     }
-    void ReadValue(vtkFoamIOobject&, vtkFoamToken& currToken)
+  if (nThreads <= 1)
     {
-      if (!currToken.Is<primitiveT>())
-        {
-        throw vtkFoamError() << "Expected an integer or a (, found "
-        << currToken;
-        }
-      this->Ptr->InsertNextValue(currToken.To<primitiveT>());
+    // the loops nested in a single task may still run in parallel
+    for (vtkIdType taskI = 0; taskI < nTasks; taskI++)
+      {
+      functor(taskI);
+      }
+    return;
     }
-  };
 
-  // reads rank 1 lists of types vector, sphericalTensor, symmTensor
-  // and tensor. if isPositions is true it reads Cloud type of data as
-  // particle positions. cf. (the positions format)
-  // src/lagrangian/basic/particle/particleIO.C
-  template <typename listT, typename primitiveT, int nComponents,
-      bool isPositions> class vectorListTraits
+  vtkFoamParallelTasksInfo<functorT> tasksInfo;
+  tasksInfo.Functor = &functor;
+  tasksInfo.NTasks = nTasks;
+  tasksInfo.NextTask = 0;
+  vtkMultiThreader *threader = vtkMultiThreader::New();
+  threader->SetNumberOfThreads(static_cast<int>(nThreads));
+  threader->SetSingleMethod(vtkFoamParallelTasksThread<functorT>, &tasksInfo);
+  threader->SingleMethodExecute();
+  threader->Delete();
+}
+
+//-----------------------------------------------------------------------------
+// converts double precision values at an arbitrary alignment (e.g. in
+// a mapped file) to single precision
+struct vtkFoamDoubleToFloat
+{
+  float *Destination;
+  const unsigned char *Source;
+
+  void operator()(const vtkIdType begin, const vtkIdType end) const
   {
-    listT *Ptr;
+    float *destination = this->Destination + begin;
+    const unsigned char *source = this->Source + sizeof(double) * begin;
+    const vtkIdType size = end - begin;
+    vtkIdType i = 0;
+#if VTK_FOAMFILE_HAVE_AVX
+    for (; i + 4 <= size; i += 4)
+      {
+      _mm_storeu_ps(destination + i, _mm256_cvtpd_ps(_mm256_loadu_pd(
+          reinterpret_cast<const double *>(source + sizeof(double) * i))));
+      }
+#elif VTK_FOAMFILE_HAVE_SSE2
+    for (; i + 4 <= size; i += 4)
+      {
+      const double *sourceI
+          = reinterpret_cast<const double *>(source + sizeof(double) * i);
+      _mm_storeu_ps(destination + i,
+          _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(sourceI)),
+          _mm_cvtpd_ps(_mm_loadu_pd(sourceI + 2))));
+      }
+#endif
+    for (; i < size; i++)
+      {
+      double value;
+      memcpy(&value, source + sizeof(double) * i, sizeof(double));
+      destination[i] = static_cast<float>(value);
+      }
+  }
+};
 
-  public:
-    vectorListTraits() :
-      Ptr(listT::New())
+// reads size double precision binary values into destination. The
+// values are converted straight from the buffer if the whole list is
+// there (always the case for a mapped file), otherwise they are read
+// in chunks of the output buffer size.
+static void vtkFoamReadBinaryDoubles(vtkFoamIOobject& io, float *destination,
+    const vtkIdType size)
+{
+  if (size <= 0)
     {
-      this->Ptr->SetNumberOfComponents(nComponents);
+    return;
     }
-    listT *GetPtr()
+  const double startTime = vtkTimerLog::GetUniversalTime();
+  const size_t nBytes = sizeof(double) * static_cast<size_t>(size);
+
+  vtkFoamDoubleToFloat converter;
+  converter.Destination = destination;
+  converter.Source = io.ReadDirect(nBytes);
+  if (converter.Source != NULL)
     {
-      return this->Ptr;
+    vtkFoamParallelFor(size, VTK_FOAMFILE_MT_MINSIZE, converter);
     }
-    void ReadUniformValues(vtkFoamIOobject& io, const int size)
+  else
     {
-      io.ReadExpecting('(');
-      primitiveT vectorValue[nComponents];
-      for (int j = 0; j < nComponents; j++)
-        {
-        vectorValue[j] = vtkFoamReadValue<primitiveT>::ReadValue(io);
-        }
-      for (int i = 0; i < size; i++)
+    const vtkIdType bufferUnit = VTK_FOAMFILE_OUTBUFSIZE / sizeof(double);
+    vtkstd::vector<double> buffer(static_cast<size_t>(size < bufferUnit
+        ? size : bufferUnit));
+    converter.Source = reinterpret_cast<unsigned char *>(&buffer[0]);
+    for (vtkIdType i = 0; i < size; i += bufferUnit)
+      {
+      const vtkIdType readSize = size - i < bufferUnit ? size - i : bufferUnit;
+      io.Read(reinterpret_cast<unsigned char *>(&buffer[0]),
+          static_cast<int>(sizeof(double) * readSize));
+      converter.Destination = destination + i;
+      converter(0, readSize);
+      }
+    }
+
+  io.AddBinaryListStatistics(static_cast<double>(nBytes),
+      vtkTimerLog::GetUniversalTime() - startTime);
+}
+
+// converts a binary list of labels of type S in the file to type T,
+// reading through a buffer unless the stream can lend its own. A
+// label out of the range of T is an error rather than silently
+// truncated, which can only happen when 64-bit labels are read into
+// the int lists of fields and zones.
+template <typename S, typename T>
+static void vtkFoamConvertBinaryLabels(vtkFoamIOobject& io, T *destination,
+    const vtkIdType size)
+{
+  const vtkIdType bufferUnit = VTK_FOAMFILE_OUTBUFSIZE / sizeof(S);
+  vtkstd::vector<S> buffer(static_cast<size_t>(size < bufferUnit
+      ? size : bufferUnit));
+  for (vtkIdType i = 0; i < size; i += bufferUnit)
+    {
+    const vtkIdType readSize = size - i < bufferUnit ? size - i : bufferUnit;
+    const unsigned char *source = io.ReadDirect(sizeof(S)
+        * static_cast<size_t>(readSize));
+    if (source == NULL)
+      {
+      io.Read(reinterpret_cast<unsigned char *>(&buffer[0]),
+          static_cast<int>(sizeof(S) * readSize));
+      source = reinterpret_cast<unsigned char *>(&buffer[0]);
+      }
+    for (vtkIdType j = 0; j < readSize; j++)
+      {
+      S value;
+      memcpy(&value, source + sizeof(S) * j, sizeof(S));
+      if (sizeof(T) < sizeof(S) && static_cast<S>(static_cast<T>(value))
+          != value)
         {
-        this->Ptr->SetTuple(i, vectorValue);
-        }
-      io.ReadExpecting(')');
-      if (isPositions)
-        {
-        // skip label celli
-        vtkFoamReadValue<int>::ReadValue(io);
+        throw vtkFoamError() << "Label value " << static_cast<double>(value)
+            << " exceeds the range of " << static_cast<int>(8 * sizeof(T))
+            << "-bit labels";
         }
+      destination[i + j] = static_cast<T>(value);
+      }
     }
-    void ReadAsciiList(vtkFoamIOobject& io, const int size)
+}
+
+// reads a binary list of labels into int or vtkIdType labels. The
+// list is read as it is when the label sizes of the file and the
+// destination agree, which is the case for the mesh with 64-bit labels
+// and 64-bit ids.
+template <typename T>
+static void vtkFoamReadBinaryLabels(vtkFoamIOobject& io, T *destination,
+    const vtkIdType size)
+{
+  if (size <= 0)
     {
-      for (int i = 0; i < size; i++)
-        {
-        io.ReadExpecting('(');
-        primitiveT *vectorTupleI = this->Ptr->GetPointer(nComponents * i);
-        for (int j = 0; j < nComponents; j++)
-          {
-          vectorTupleI[j] = vtkFoamReadValue<primitiveT>::ReadValue(io);
-          }
-        io.ReadExpecting(')');
-        if (isPositions)
-          {
-          // skip label celli
-          vtkFoamReadValue<int>::ReadValue(io);
-          }
-        }
+    return;
     }
-    void ReadBinaryList(vtkFoamIOobject& io, const int size)
+  const size_t labelSize = io.GetUse64BitLabels() ? sizeof(vtkTypeInt64)
+      : sizeof(int);
+  if (labelSize == sizeof(T))
     {
-      if (isPositions) // lagrangian/positions (class Cloud)
+    // in pieces of which the byte counts fit in an int
+    const vtkIdType readUnit = (1 << 30) / sizeof(T);
+    for (vtkIdType i = 0; i < size; i += readUnit)
+      {
+      const vtkIdType readSize = size - i < readUnit ? size - i : readUnit;
+      io.Read(reinterpret_cast<unsigned char *>(destination + i),
+          static_cast<int>(sizeof(T) * readSize));
+      }
+    }
+  else if (io.GetUse64BitLabels())
+    {
+    vtkFoamConvertBinaryLabels<vtkTypeInt64>(io, destination, size);
+    }
+  else
+    {
+    vtkFoamConvertBinaryLabels<int>(io, destination, size);
+    }
+}
+
+// the number of the listed indices from indexI on that are
+// consecutive, i. e. that can be read at once
+static vtkIdType vtkFoamCountConsecutiveIndices(vtkIdTypeArray& indices,
+    const vtkIdType indexI, const vtkIdType nextTupleI, const vtkIdType size)
+{
+  const vtkIdType nIndices = indices.GetNumberOfTuples();
+  vtkIdType endI = indexI;
+  for (; endI < nIndices; endI++)
+    {
+    const vtkIdType tupleI = indices.GetValue(endI);
+    if (endI == indexI ? tupleI < nextTupleI || tupleI >= size
+        : tupleI != indices.GetValue(endI - 1) + 1)
+      {
+      break;
+      }
+    }
+  if (endI == indexI)
+    {
+    throw vtkFoamError() << "Index " << indices.GetValue(indexI)
+        << " is out of range of the list of size " << size;
+    }
+  if (indices.GetValue(endI - 1) >= size)
+    {
+    throw vtkFoamError() << "Index " << indices.GetValue(endI - 1)
+        << " is out of range of the list of size " << size;
+    }
+  return endI - indexI;
+}
+
+// reads only the tuples listed in the ascending indices out of a
+// binary list of size tuples of real numbers, seeking past the others.
+// Double precision tuples are gathered first and converted at once.
+static void vtkFoamGatherBinaryList(vtkFoamIOobject& io, float *destination,
+    const int nComponents, const vtkIdType size, vtkIdTypeArray& indices)
+{
+  const double startTime = vtkTimerLog::GetUniversalTime();
+  const bool isSinglePrecision = io.GetIsSinglePrecisionBinary();
+  const size_t tupleSize = (isSinglePrecision ? sizeof(float)
+      : sizeof(double)) * nComponents;
+  const vtkIdType nIndices = indices.GetNumberOfTuples();
+  vtkstd::vector<double> buffer(isSinglePrecision || nIndices == 0 ? 0
+      : static_cast<size_t>(nComponents) * nIndices);
+  unsigned char *gathered = isSinglePrecision
+      ? reinterpret_cast<unsigned char *>(destination)
+      : reinterpret_cast<unsigned char *>(buffer.empty() ? NULL : &buffer[0]);
+  vtkIdType nextTupleI = 0;
+  for (vtkIdType i = 0; i < nIndices;)
+    {
+    const vtkIdType nTuples
+        = vtkFoamCountConsecutiveIndices(indices, i, nextTupleI, size);
+    const vtkIdType tupleI = indices.GetValue(i);
+    io.Skip(tupleSize * (tupleI - nextTupleI));
+    io.Read(gathered + tupleSize * i, static_cast<int>(tupleSize * nTuples));
+    nextTupleI = tupleI + nTuples;
+    i += nTuples;
+    }
+  io.Skip(tupleSize * (size - nextTupleI));
+
+  if (!buffer.empty())
+    {
+    vtkFoamDoubleToFloat converter;
+    converter.Destination = destination;
+    converter.Source = gathered;
+    const vtkIdType nValues = static_cast<vtkIdType>(buffer.size());
+    vtkFoamParallelFor(nValues, VTK_FOAMFILE_MT_MINSIZE, converter);
+    io.AddBinaryListStatistics(static_cast<double>(sizeof(double) * nValues),
+        vtkTimerLog::GetUniversalTime() - startTime);
+    }
+}
+
+// same as above for a binary list of labels
+template <typename T>
+static void vtkFoamGatherBinaryList(vtkFoamIOobject& io, T *destination,
+    const int nComponents, const vtkIdType size, vtkIdTypeArray& indices)
+{
+  const size_t tupleSize = (io.GetUse64BitLabels() ? sizeof(vtkTypeInt64)
+      : sizeof(int)) * nComponents;
+  const vtkIdType nIndices = indices.GetNumberOfTuples();
+  vtkIdType nextTupleI = 0;
+  for (vtkIdType i = 0; i < nIndices;)
+    {
+    const vtkIdType nTuples
+        = vtkFoamCountConsecutiveIndices(indices, i, nextTupleI, size);
+    const vtkIdType tupleI = indices.GetValue(i);
+    io.Skip(tupleSize * (tupleI - nextTupleI));
+    vtkFoamReadBinaryLabels(io, destination + nComponents * i,
+        static_cast<vtkIdType>(nComponents) * nTuples);
+    nextTupleI = tupleI + nTuples;
+    i += nTuples;
+    }
+  io.Skip(tupleSize * (size - nextTupleI));
+}
+
+// moves the tuples listed in the ascending indices to the front of a
+// list of size tuples that has been read in whole
+template <typename T>
+static void vtkFoamGatherTuples(T *values, const int nComponents,
+    const vtkIdType size, vtkIdTypeArray& indices)
+{
+  const vtkIdType nIndices = indices.GetNumberOfTuples();
+  for (vtkIdType i = 0; i < nIndices; i++)
+    {
+    const vtkIdType tupleI = indices.GetValue(i);
+    if (tupleI < i || tupleI >= size)
+      {
+      throw vtkFoamError() << "Index " << tupleI
+          << " is out of range of the list of size " << size;
+      }
+    for (int j = 0; j < nComponents; j++)
+      {
+      values[nComponents * i + j] = values[nComponents * tupleI + j];
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// class vtkFoamAsciiListParser
+// bulk parser for the body of an ASCII list that lies entirely in the
+// buffer (always the case for a mapped file). The body is split into
+// chunks at line heads, the number tokens and parentheses of each
+// chunk are counted by an SSE2 scan to obtain the output offsets, and
+// then the chunks are parsed in parallel straight into the
+// preallocated array. The parser gives up on anything unexpected
+// (comments, nan, uniform sublists etc.) without consuming the buffer
+// so that the caller can fall back to the token-by-token path.
+struct vtkFoamAsciiListParser
+{
+private:
+  struct chunk
+  {
+    const unsigned char *Begin;
+    const unsigned char *End;
+    vtkIdType NNumbers; // number of number tokens
+    vtkIdType NOpens; // number of '('
+    vtkIdType NumberOffset;
+    vtkIdType OpenOffset;
+    bool Failed;
+  };
+  typedef vtkstd::vector<chunk> chunkVector;
+
+  chunkVector Chunks;
+  const unsigned char *Begin;
+  const unsigned char *End;
+  vtkIdType NNumbers;
+  vtkIdType NOpens;
+
+  static int PopCount(unsigned int bits)
+  {
+    bits = bits - ((bits >> 1) & 0x55555555);
+    bits = (bits & 0x33333333) + ((bits >> 2) & 0x33333333);
+    return static_cast<int>((((bits + (bits >> 4)) & 0x0f0f0f0f)
+        * 0x01010101) >> 24);
+  }
+  static bool IsSpace(const int c)
+  {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r';
+  }
+  static bool IsSeparator(const int c)
+  {
+    return IsSpace(c) || c == '(' || c == ')';
+  }
+  static const unsigned char *SkipSpaces(const unsigned char *ptr,
+      const unsigned char *endPtr)
+  {
+    while (ptr < endPtr && IsSpace(*ptr))
+      {
+      ptr++;
+      }
+    return ptr;
+  }
+
+  // same as vtkFoamFile::ReadLabelValue() for int or vtkIdType
+  // labels. Returns NULL if not a number delimited by a separator.
+  template <typename T>
+  static const unsigned char *ParseValue(const unsigned char *ptr,
+      const unsigned char *endPtr, T *value)
+  {
+    const bool nonNegative = (*ptr != '-');
+    if (*ptr == '-' || *ptr == '+')
+      {
+      ptr++;
+      }
+    if (ptr == endPtr || !isdigit(*ptr))
+      {
+      return NULL;
+      }
+    T num = 0;
+    while (ptr < endPtr && isdigit(*ptr))
+      {
+      num = 10 * num + *ptr++ - 48; // '0' == 48
+      }
+    if (ptr < endPtr && !IsSeparator(*ptr))
+      {
+      return NULL;
+      }
+    *value = nonNegative ? num : -num;
+    return ptr;
+  }
+
+  // same arithmetic as vtkFoamFile::ReadFloatValue()
+  static const unsigned char *ParseValue(const unsigned char *ptr,
+      const unsigned char *endPtr, float *value)
+  {
+    const bool nonNegative = (*ptr != '-');
+    if (*ptr == '-' || *ptr == '+')
+      {
+      ptr++;
+      }
+    if (ptr == endPtr || (!isdigit(*ptr) && *ptr != '.'))
+      {
+      return NULL;
+      }
+    double num = 0.0;
+    while (ptr < endPtr && isdigit(*ptr))
+      {
+      num = num * 10.0 + (*ptr++ - 48);
+      }
+    if (ptr < endPtr && *ptr == '.')
+      {
+      double divisor = 1.0;
+      while (++ptr < endPtr && isdigit(*ptr))
         {
-        // allocate space along with the larger 1.4 format since the
-        // size must be determined at compile-time. The buffer is
-        // allocated on the stack in order to avoid leak when an
-        // exception is thrown.
-        unsigned char buffer[sizeof(double) * (nComponents + 1) + 2
-            * sizeof(int)];
-        const int realSize = io.GetIsSinglePrecisionBinary()
-            ? sizeof(float) : sizeof(double);
-        const int nBytes = (io.GetIs13Positions()
-            // skip label celli
-            ? realSize * nComponents + sizeof(int)
-            // skip label celli, label facei and scalar stepFraction
-            : realSize * (nComponents + 1) + 2 * sizeof(int));
-        for (int i = 0; i < size; i++)
-          {
-          io.ReadExpecting('(');
-          io.Read(buffer, nBytes);
-          this->Ptr->SetTuple(i, reinterpret_cast<double *>(buffer));
-          io.ReadExpecting(')');
-          }
+        num = num * 10.0 + (*ptr - 48);
+        divisor *= 10.0;
+        }
+      num /= divisor;
+      }
+    if (ptr < endPtr && (*ptr == 'E' || *ptr == 'e'))
+      {
+      int esign = 1;
+      int eval = 0;
+      double scale = 1.0;
+      if (++ptr < endPtr && *ptr == '-')
+        {
+        esign = -1;
+        ptr++;
+        }
+      else if (ptr < endPtr && *ptr == '+')
+        {
+        ptr++;
+        }
+      while (ptr < endPtr && isdigit(*ptr))
+        {
+        eval = eval * 10 + (*ptr++ - 48);
+        }
+      while (eval >= 64)
+        {
+        scale *= 1.0e+64;
+        eval -= 64;
+        }
+      while (eval >= 16)
+        {
+        scale *= 1.0e+16;
+        eval -= 16;
+        }
+      while (eval >= 4)
+        {
+        scale *= 1.0e+4;
+        eval -= 4;
+        }
+      while (eval >= 1)
+        {
+        scale *= 1.0e+1;
+        eval -= 1;
+        }
+      if (esign < 0)
+        {
+        num /= scale;
         }
       else
         {
-        if (io.GetIsSinglePrecisionBinary())
+        num *= scale;
+        }
+      }
+    if (ptr < endPtr && !IsSeparator(*ptr))
+      {
+      return NULL;
+      }
+    *value = static_cast<float>(nonNegative ? num : -num);
+    return ptr;
+  }
+
+  // counts number tokens (a non-separator preceded by a separator) and
+  // '(' in a chunk. A chunk always begins at a line head or at the
+  // list head so the byte before the chunk is a separator.
+  struct countFunctor
+  {
+    chunkVector *Chunks;
+    void operator()(const vtkIdType begin, const vtkIdType end) const
+    {
+      for (vtkIdType chunkI = begin; chunkI < end; chunkI++)
+        {
+        chunk &c = (*this->Chunks)[chunkI];
+        const unsigned char *ptr = c.Begin;
+        vtkIdType nNumbers = 0, nOpens = 0;
+        bool wasSeparator = true;
+#if VTK_FOAMFILE_HAVE_SSE2
+        const __m128i space = _mm_set1_epi8(' '), newline = _mm_set1_epi8('\n'),
+            tab = _mm_set1_epi8('\t'), cr = _mm_set1_epi8('\r'),
+            open = _mm_set1_epi8('('), close = _mm_set1_epi8(')');
+        unsigned int carry = 1;
+        for (; ptr + 16 <= c.End; ptr += 16)
           {
-          io.Read(reinterpret_cast<unsigned char *>(this->Ptr->GetPointer(0)),
-              sizeof(float) * nComponents * size);
+          const __m128i v
+              = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+          const __m128i isOpen = _mm_cmpeq_epi8(v, open);
+          const __m128i isSeparator = _mm_or_si128(
+              _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space),
+              _mm_cmpeq_epi8(v, newline)), _mm_or_si128(_mm_cmpeq_epi8(v, tab),
+              _mm_cmpeq_epi8(v, cr))), _mm_or_si128(isOpen,
+              _mm_cmpeq_epi8(v, close)));
+          const unsigned int separatorBits
+              = static_cast<unsigned int>(_mm_movemask_epi8(isSeparator));
+          nNumbers += PopCount(~separatorBits & ((separatorBits << 1) | carry)
+              & 0xffff);
+          nOpens += PopCount(
+              static_cast<unsigned int>(_mm_movemask_epi8(isOpen)));
+          carry = separatorBits >> 15;
           }
-        else
+        wasSeparator = (carry != 0);
+#endif
+        for (; ptr < c.End; ptr++)
           {
-#if 0
-          // reduce calls to io.Read() by using the array space as buffer
-          float *destination = this->Ptr->GetPointer(0);
-          double *source = reinterpret_cast<double *>(destination);
+          const bool isSeparator = IsSeparator(*ptr);
+          if (!isSeparator && wasSeparator)
+            {
+            nNumbers++;
+            }
+          if (*ptr == '(')
+            {
+            nOpens++;
+            }
+          wasSeparator = isSeparator;
+          }
+        c.NNumbers = nNumbers;
+        c.NOpens = nOpens;
+        }
+    }
+  };
 
-          int remainingSize = size;
-          for (int halfSize = remainingSize / 2; halfSize > 0;
-               halfSize = remainingSize / 2)
+  // parses a list of primitives (nComponents == 0) or a list of tuples
+  // of nComponents primitives
+  template <typename T> struct valueFunctor
+  {
+    chunkVector *Chunks;
+    T *Values;
+    int NComponents;
+    void operator()(const vtkIdType begin, const vtkIdType end) const
+    {
+      for (vtkIdType chunkI = begin; chunkI < end; chunkI++)
+        {
+        chunk &c = (*this->Chunks)[chunkI];
+        T *values = this->Values + c.NumberOffset;
+        T *valuesEnd = values + c.NNumbers;
+        const unsigned char *ptr = SkipSpaces(c.Begin, c.End);
+        c.Failed = true;
+        while (ptr < c.End)
+          {
+          if (this->NComponents == 0)
             {
-            const int convertSize = nComponents * halfSize;
-            io.Read(reinterpret_cast<unsigned char *>(source),
-            sizeof(double) * convertSize);
-            for (int i = 0; i < convertSize; i++)
+            if (values == valuesEnd
+                || (ptr = ParseValue(ptr, c.End, values++)) == NULL)
               {
-              *destination++ = static_cast<float>(*source++);
+              return;
               }
-            source = reinterpret_cast<double *>(destination);
-            remainingSize -= halfSize;
             }
-          if (remainingSize > 0)
+          else
             {
-            // read the last one element that doesn't fit into the
-            // remaining space
-            double buffer[nComponents];
-            io.Read(reinterpret_cast<unsigned char *>(buffer),
-                sizeof(double) * nComponents);
-            for (int i = 0; i < nComponents; i++)
+            if (*ptr != '(' || values + this->NComponents > valuesEnd)
+              {
+              return;
+              }
+            ptr++;
+            for (int j = 0; j < this->NComponents; j++)
+              {
+              ptr = SkipSpaces(ptr, c.End);
+              if (ptr == c.End
+                  || (ptr = ParseValue(ptr, c.End, values++)) == NULL)
+                {
+                return;
+                }
+              }
+            ptr = SkipSpaces(ptr, c.End);
+            if (ptr == c.End || *ptr != ')')
               {
-              *destination++ = static_cast<float>(buffer[i]);
+              return;
               }
+            ptr++;
             }
-#else
-          const int bufferUnit = 32, nDivs = size / bufferUnit,
-            unitSize = nComponents * bufferUnit;
-          double buffer[nComponents * bufferUnit];
+          ptr = SkipSpaces(ptr, c.End);
+          }
+        c.Failed = (values != valuesEnd);
+        }
+    }
+  };
 
-          for (int i = 0; i < nDivs; i++)
+  // parses a list of labelLists of the form n(l0 l1 ... ln-1)
+  struct labelListFunctor
+  {
+    chunkVector *Chunks;
+    vtkIdType *Indices;
+    vtkIdType *Body;
+    void operator()(const vtkIdType begin, const vtkIdType end) const
+    {
+      for (vtkIdType chunkI = begin; chunkI < end; chunkI++)
+        {
+        chunk &c = (*this->Chunks)[chunkI];
+        vtkIdType *indices = this->Indices + c.OpenOffset;
+        vtkIdType *indicesEnd = indices + c.NOpens;
+        vtkIdType bodyI = c.NumberOffset - c.OpenOffset;
+        const vtkIdType bodyEnd = bodyI + c.NNumbers - c.NOpens;
+        const unsigned char *ptr = SkipSpaces(c.Begin, c.End);
+        c.Failed = true;
+        while (ptr < c.End)
+          {
+          vtkIdType sizeJ;
+          if (indices == indicesEnd
+              || (ptr = ParseValue(ptr, c.End, &sizeJ)) == NULL || sizeJ < 0
+              || sizeJ > bodyEnd - bodyI)
+            {
+            return;
+            }
+          ptr = SkipSpaces(ptr, c.End);
+          if (ptr == c.End || *ptr != '(')
+            {
+            return;
+            }
+          ptr++;
+          *indices++ = bodyI;
+          for (vtkIdType j = 0; j < sizeJ; j++)
             {
-            float *destination = this->Ptr->GetPointer(i * unitSize);
-            io.Read(reinterpret_cast<unsigned char *>(buffer),
-                sizeof(double) * unitSize);
-            for (int j = 0; j < unitSize; j++)
+            ptr = SkipSpaces(ptr, c.End);
+            if (ptr == c.End
+                || (ptr = ParseValue(ptr, c.End, this->Body + bodyI++)) == NULL)
               {
-              destination[j] = static_cast<float>(buffer[j]);
+              return;
               }
             }
-          const int remainingSize = nComponents * (size % bufferUnit);
-          float *destination = this->Ptr->GetPointer(nDivs * unitSize);
-          io.Read(reinterpret_cast<unsigned char *>(buffer),
-              sizeof(double) * remainingSize);
-          for (int j = 0; j < remainingSize; j++)
+          ptr = SkipSpaces(ptr, c.End);
+          if (ptr == c.End || *ptr != ')')
             {
-            destination[j] = static_cast<float>(buffer[j]);
+            return;
             }
-#endif
+          ptr = SkipSpaces(ptr + 1, c.End);
           }
+        c.Failed = (indices != indicesEnd || bodyI != bodyEnd);
         }
     }
-    void ReadValue(vtkFoamIOobject& io, vtkFoamToken& currToken)
-    {
-      if (currToken != '(')
+  };
+
+  bool Succeeded() const
+  {
+    for (size_t chunkI = 0; chunkI < this->Chunks.size(); chunkI++)
+      {
+      if (this->Chunks[chunkI].Failed)
         {
-        throw vtkFoamError() << "Expected '(', found " << currToken;
+        return false;
         }
-      primitiveT v[nComponents];
-      for (int j = 0; j < nComponents; j++)
+      }
+    return true;
+  }
+
+public:
+  vtkFoamAsciiListParser() :
+    Chunks(), Begin(NULL), End(NULL), NNumbers(0), NOpens(0)
+  {
+  }
+
+  // locates the end of the list body that begins at the current
+  // buffer position as the nClosings-th ')', splits the body into
+  // chunks and counts the tokens. isNested tells if chunks have to be
+  // split only at line heads following ')'.
+  bool Scan(vtkFoamIOobject& io, const vtkIdType nClosings,
+      const bool isNested)
+  {
+    this->Begin = io.GetBufferBegin();
+    const unsigned char *bufEnd = io.GetBufferEnd();
+    if (this->Begin == NULL || nClosings <= 0)
+      {
+      return false;
+      }
+    const unsigned char *endPtr = this->Begin;
+    for (vtkIdType closingI = 1;; closingI++, endPtr++)
+      {
+      endPtr = static_cast<const unsigned char *>(memchr(endPtr, ')',
+          bufEnd - endPtr));
+      if (endPtr == NULL)
         {
-        v[j] = vtkFoamReadValue<primitiveT>::ReadValue(io);
+        return false;
         }
-      this->Ptr->InsertNextTuple(v);
-      io.ReadExpecting(')');
-    }
-  };
+      if (closingI == nClosings)
+        {
+        break;
+        }
+      }
+    this->End = endPtr;
 
-  vtkFoamEntryValue(const vtkFoamEntry *upperEntryPtr) :
-    vtkFoamToken(), IsUniform(UNDEFINED), Managed(true),
-        UpperEntryPtr(upperEntryPtr)
+    const vtkIdType nBytes = this->End - this->Begin;
+    vtkIdType nChunks = vtkFoamGetMaxThreads();
+    if (VTK_FOAMFILE_MT_MINSIZE <= 0 || nBytes / VTK_FOAMFILE_MT_MINSIZE
+        < nChunks)
+      {
+      nChunks = VTK_FOAMFILE_MT_MINSIZE <= 0 ? 1
+          : nBytes / VTK_FOAMFILE_MT_MINSIZE;
+      }
+    const unsigned char *chunkBegin = this->Begin;
+    for (vtkIdType chunkI = 1; chunkBegin < this->End; chunkI++)
+      {
+      const unsigned char *chunkEnd = this->End;
+      if (chunkI < nChunks)
+        {
+        chunkEnd = this->Begin + nBytes * chunkI / nChunks;
+        if (chunkEnd < chunkBegin)
+          {
+          chunkEnd = chunkBegin;
+          }
+        // move forward to the next line head
+        for (;;)
+          {
+          const unsigned char *nlPtr = static_cast<const unsigned char *>(
+              memchr(chunkEnd, '\n', this->End - chunkEnd));
+          if (nlPtr == NULL)
+            {
+            chunkEnd = this->End;
+            break;
+            }
+          chunkEnd = nlPtr + 1;
+          if (!isNested || (nlPtr > this->Begin && nlPtr[-1] == ')'))
+            {
+            break;
+            }
+          }
+        }
+      chunk c;
+      c.Begin = chunkBegin;
+      c.End = chunkEnd;
+      c.NNumbers = c.NOpens = c.NumberOffset = c.OpenOffset = 0;
+      c.Failed = false;
+      this->Chunks.push_back(c);
+      chunkBegin = chunkEnd;
+      }
+
+    countFunctor counter;
+    counter.Chunks = &this->Chunks;
+    vtkFoamParallelFor(static_cast<vtkIdType>(this->Chunks.size()), 1,
+        counter);
+    this->NNumbers = this->NOpens = 0;
+    for (size_t chunkI = 0; chunkI < this->Chunks.size(); chunkI++)
+      {
+      chunk &c = this->Chunks[chunkI];
+      c.NumberOffset = this->NNumbers;
+      c.OpenOffset = this->NOpens;
+      this->NNumbers += c.NNumbers;
+      this->NOpens += c.NOpens;
+      }
+    return true;
+  }
+
+  vtkIdType GetNumberOfNumbers() const
   {
+    return this->NNumbers;
   }
-  vtkFoamEntryValue(vtkFoamEntryValue&, const vtkFoamEntry *);
-  ~vtkFoamEntryValue()
+  vtkIdType GetNumberOfOpens() const
   {
-    this->Clear();
+    return this->NOpens;
   }
 
-  void SetEmptyList()
+  template <typename T> bool ParseValues(T *values, const int nComponents)
   {
-    this->Clear();
-    this->IsUniform = NONUNIFORM;
-    this->Superclass::Type = EMPTYLIST;
+    valueFunctor<T> parser;
+    parser.Chunks = &this->Chunks;
+    parser.Values = values;
+    parser.NComponents = nComponents;
+    vtkFoamParallelFor(static_cast<vtkIdType>(this->Chunks.size()), 1,
+        parser);
+    return this->Succeeded();
   }
-  uniformTypes GetIsUniform() const
+
+  bool ParseLabelLists(vtkIdType *indices, vtkIdType *body)
+  {
+    labelListFunctor parser;
+    parser.Chunks = &this->Chunks;
+    parser.Indices = indices;
+    parser.Body = body;
+    vtkFoamParallelFor(static_cast<vtkIdType>(this->Chunks.size()), 1,
+        parser);
+    return this->Succeeded();
+  }
+
+  // consumes the list body up to the closing ')'
+  void Skip(vtkFoamIOobject& io)
+  {
+    io.ReadDirect(this->End - this->Begin);
+  }
+};
+
+// reads the body of an ASCII list of size primitives (isTuple ==
+// false) or size tuples of nComponents primitives in bulk. Returns
+// false without consuming the input if not possible.
+template <typename T>
+static bool vtkFoamReadAsciiList(vtkFoamIOobject& io, T *values,
+    const vtkIdType size, const int nComponents, const bool isTuple)
+{
+  if (size <= 0)
+    {
+    return false;
+    }
+  vtkFoamAsciiListParser parser;
+  if (!parser.Scan(io, isTuple ? size + 1 : 1, isTuple)
+      || parser.GetNumberOfNumbers() != size * nComponents
+      || parser.GetNumberOfOpens() != (isTuple ? size : 0)
+      || !parser.ParseValues(values, isTuple ? nComponents : 0))
+    {
+    return false;
+    }
+  parser.Skip(io);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// class vtkFoamEntryValue
+// a class that represents a value of a dictionary entry that corresponds to
+// its keyword. note that an entry can have more than one value.
+struct vtkFoamEntryValue : public vtkFoamToken
+{
+public:
+  enum uniformTypes
+    {UNDEFINED, UNIFORM, NONUNIFORM};
+private:
+  typedef vtkFoamToken Superclass;
+
+  uniformTypes IsUniform;
+  bool Managed;
+  const vtkFoamEntry *UpperEntryPtr;
+
+  vtkFoamEntryValue();
+  vtkObjectBase *ToVTKObject()
+  {
+    return this->Superclass::VtkObjectPtr;
+  }
+  void Clear();
+  void ReadList(vtkFoamIOobject& io);
+
+public:
+  // reads primitive int/float lists
+  template <typename listT, typename primitiveT> class listTraits
+  {
+    listT *Ptr;
+
+  public:
+    listTraits() :
+      Ptr(listT::New())
+    {
+    }
+    listT *GetPtr()
+    {
+      return this->Ptr;
+    }
+    void ReadUniformValues(vtkFoamIOobject& io, const vtkIdType size)
+    {
+      primitiveT value = vtkFoamReadValue<primitiveT>::ReadValue(io);
+      for (vtkIdType i = 0; i < size; i++)
+        {
+        this->Ptr->SetValue(i, value);
+        }
+    }
+    void ReadAsciiList(vtkFoamIOobject& io, const vtkIdType size)
+    {
+      if (vtkFoamReadAsciiList(io, this->Ptr->GetPointer(0), size, 1, false))
+        {
+        return;
+        }
+      for (vtkIdType i = 0; i < size; i++)
+        {
+        this->Ptr->SetValue(i, vtkFoamReadValue<primitiveT>::ReadValue(io));
+        }
+    }
+    void ReadBinaryList(vtkFoamIOobject& io, const vtkIdType size)
+    {
+      io.Read(reinterpret_cast<unsigned char *>(this->Ptr->GetPointer(0)), size
+          * sizeof(primitiveT));
+    }
+    void ReadBinaryListGather(vtkFoamIOobject& io, const vtkIdType size,
+        vtkIdTypeArray& indices)
+    {
+      vtkFoamGatherBinaryList(io, this->Ptr->GetPointer(0), 1, size, indices);
+    }
+    void ReadValue(vtkFoamIOobject&, vtkFoamToken& currToken)
+    {
+      if (!currToken.Is<primitiveT>())
+        {
+        throw vtkFoamError() << "Expected an integer or a (, found "
+        << currToken;
+        }
+      this->Ptr->InsertNextValue(currToken.To<primitiveT>());
+    }
+  };
+
+  // reads rank 1 lists of types vector, sphericalTensor, symmTensor
+  // and tensor. if isPositions is true it reads Cloud type of data as
+  // particle positions. cf. (the positions format)
+  // src/lagrangian/basic/particle/particleIO.C
+  template <typename listT, typename primitiveT, int nComponents,
+      bool isPositions> class vectorListTraits
+  {
+    listT *Ptr;
+
+  public:
+    vectorListTraits() :
+      Ptr(listT::New())
+    {
+      this->Ptr->SetNumberOfComponents(nComponents);
+    }
+    listT *GetPtr()
+    {
+      return this->Ptr;
+    }
+    void ReadUniformValues(vtkFoamIOobject& io, const vtkIdType size)
+    {
+      io.ReadExpecting('(');
+      primitiveT vectorValue[nComponents];
+      for (int j = 0; j < nComponents; j++)
+        {
+        vectorValue[j] = vtkFoamReadValue<primitiveT>::ReadValue(io);
+        }
+      for (vtkIdType i = 0; i < size; i++)
+        {
+        this->Ptr->SetTuple(i, vectorValue);
+        }
+      io.ReadExpecting(')');
+      if (isPositions)
+        {
+        // skip label celli
+        vtkFoamReadValue<int>::ReadValue(io);
+        }
+    }
+    void ReadAsciiList(vtkFoamIOobject& io, const vtkIdType size)
+    {
+      if (!isPositions && vtkFoamReadAsciiList(io, this->Ptr->GetPointer(0),
+          size, nComponents, true))
+        {
+        return;
+        }
+      for (vtkIdType i = 0; i < size; i++)
+        {
+        io.ReadExpecting('(');
+        primitiveT *vectorTupleI = this->Ptr->GetPointer(nComponents * i);
+        for (int j = 0; j < nComponents; j++)
+          {
+          vectorTupleI[j] = vtkFoamReadValue<primitiveT>::ReadValue(io);
+          }
+        io.ReadExpecting(')');
+        if (isPositions)
+          {
+          // skip label celli
+          vtkFoamReadValue<int>::ReadValue(io);
+          }
+        }
+    }
+    void ReadBinaryList(vtkFoamIOobject& io, const vtkIdType size)
+    {
+      if (isPositions) // lagrangian/positions (class Cloud)
+        {
+        // allocate space along with the larger 1.4 format since the
+        // size must be determined at compile-time. The buffer is
+        // allocated on the stack in order to avoid leak when an
+        // exception is thrown.
+        unsigned char buffer[sizeof(double) * (nComponents + 1) + 2
+            * sizeof(vtkTypeInt64)];
+        const int realSize = io.GetIsSinglePrecisionBinary()
+            ? sizeof(float) : sizeof(double);
+        const int labelSize = io.GetUse64BitLabels()
+            ? sizeof(vtkTypeInt64) : sizeof(int);
+        const int nBytes = (io.GetIs13Positions()
+            // skip label celli
+            ? realSize * nComponents + labelSize
+            // skip label celli, label facei and scalar stepFraction
+            : realSize * (nComponents + 1) + 2 * labelSize);
+        for (vtkIdType i = 0; i < size; i++)
+          {
+          io.ReadExpecting('(');
+          io.Read(buffer, nBytes);
+          this->Ptr->SetTuple(i, reinterpret_cast<double *>(buffer));
+          io.ReadExpecting(')');
+          }
+        }
+      else
+        {
+        if (io.GetIsSinglePrecisionBinary())
+          {
+          io.Read(reinterpret_cast<unsigned char *>(this->Ptr->GetPointer(0)),
+              sizeof(float) * nComponents * size);
+          }
+        else
+          {
+          vtkFoamReadBinaryDoubles(io, this->Ptr->GetPointer(0),
+              static_cast<vtkIdType>(nComponents) * size);
+          }
+        }
+    }
+    void ReadBinaryListGather(vtkFoamIOobject& io, const vtkIdType size,
+        vtkIdTypeArray& indices)
+    {
+      vtkFoamGatherBinaryList(io, this->Ptr->GetPointer(0), nComponents, size,
+          indices);
+    }
+    void ReadValue(vtkFoamIOobject& io, vtkFoamToken& currToken)
+    {
+      if (currToken != '(')
+        {
+        throw vtkFoamError() << "Expected '(', found " << currToken;
+        }
+      primitiveT v[nComponents];
+      for (int j = 0; j < nComponents; j++)
+        {
+        v[j] = vtkFoamReadValue<primitiveT>::ReadValue(io);
+        }
+      this->Ptr->InsertNextTuple(v);
+      io.ReadExpecting(')');
+    }
+  };
+
+  // allocated from the arena
+  static void *operator new(size_t size)
+  {
+    return vtkFoamArena::Allocate(size);
+  }
+  static void operator delete(void *ptr, size_t size)
+  {
+    vtkFoamArena::Free(ptr, size);
+  }
+  vtkFoamEntryValue(const vtkFoamEntry *upperEntryPtr) :
+    vtkFoamToken(), IsUniform(UNDEFINED), Managed(true),
+        UpperEntryPtr(upperEntryPtr)
+  {
+  }
+  vtkFoamEntryValue(vtkFoamEntryValue&, const vtkFoamEntry *);
+  ~vtkFoamEntryValue()
+  {
+    this->Clear();
+  }
+
+  void SetEmptyList()
+  {
+    this->Clear();
+    this->IsUniform = NONUNIFORM;
+    this->Superclass::Type = EMPTYLIST;
+  }
+  uniformTypes GetIsUniform() const
   {
     return this->IsUniform;
   }
@@ -2428,6 +4415,10 @@ public:
   {
     return this->Superclass::Type == LABEL ? this->Superclass::To<int>() : 0;
   }
+  vtkIdType ToIdType() const
+  {
+    return this->Superclass::Type == LABEL ? this->Superclass::ToIdType() : 0;
+  }
 
   // the following two are for an exceptional expression of
   // `LABEL{LABELorSCALAR}' without type prefix (e. g. `2{-0}' in
@@ -2482,12 +4473,36 @@ public:
       }
     if (currToken.GetType() == vtkFoamToken::LABEL)
       {
-      const int sizeI = currToken.To<int>();
+      const vtkIdType sizeI = currToken.ToIdType();
       if (sizeI < 0)
         {
         throw vtkFoamError() << "List size must not be negative: size = "
         << sizeI;
         }
+      io.ReadExpecting('(');
+      if (io.GetFormat() == vtkFoamIOobject::ASCII && sizeI > 0)
+        {
+        vtkFoamAsciiListParser parser;
+        if (parser.Scan(io, sizeI + 1, true)
+            && parser.GetNumberOfOpens() == sizeI)
+          {
+          const vtkIdType bodySize = parser.GetNumberOfNumbers() - sizeI;
+          vtkFoamIntVectorVector *lists
+              = new vtkFoamIntVectorVector(sizeI, bodySize);
+          if (parser.ParseLabelLists(lists->GetIndices()->GetPointer(0),
+              lists->GetBody()->GetPointer(0)))
+            {
+            lists->SetIndex(sizeI, bodySize);
+            this->Superclass::LabelListListPtr = lists;
+            this->Superclass::Type = LABELLISTLIST;
+            parser.Skip(io);
+            io.ReadExpecting(')');
+            return;
+            }
+          delete lists;
+          }
+        }
+
       // gives initial guess for list size. Assumes 4.25 vertices per
       // face in average, taking into account typical snappyHexMesh
       // polyhedral meshes. The +0.25 vertices per face over a quad
@@ -2497,9 +4512,8 @@ public:
       // will not be enough for polyDualMesh-type meshes though.
       this->Superclass::LabelListListPtr = new vtkFoamIntVectorVector(sizeI, 4 * sizeI + (sizeI + 3) / 4);
       this->Superclass::Type = LABELLISTLIST;
-      io.ReadExpecting('(');
-      int bodyI = 0;
-      for (int i = 0; i < sizeI; i++)
+      vtkIdType bodyI = 0;
+      for (vtkIdType i = 0; i < sizeI; i++)
         {
         if (!io.Read(currToken))
           {
@@ -2507,21 +4521,22 @@ public:
           }
         if (currToken.GetType() == vtkFoamToken::LABEL)
           {
-          const int sizeJ = currToken.To<int>();
+          const vtkIdType sizeJ = currToken.ToIdType();
           if (sizeJ < 0)
             {
             throw vtkFoamError() << "List size must not be negative: size = "
             << sizeJ;
             }
-          int *listI = this->Superclass::LabelListListPtr->WritePointer(i,
-              bodyI, sizeJ);
+          vtkIdType *listI
+              = this->Superclass::LabelListListPtr->WritePointer(i, bodyI,
+              sizeJ);
 
           if (io.GetFormat() == vtkFoamIOobject::ASCII)
             {
             io.ReadExpecting('(');
-            for (int j = 0; j < sizeJ; j++)
+            for (vtkIdType j = 0; j < sizeJ; j++)
               {
-              listI[j] = vtkFoamReadValue<int>::ReadValue(io);
+              listI[j] = static_cast<vtkIdType>(io.ReadLabelValue());
               }
             io.ReadExpecting(')');
             }
@@ -2530,8 +4545,7 @@ public:
             if (sizeJ > 0) // avoid invalid reference to labelListI.at(0)
               {
               io.ReadExpecting('(');
-              io.Read(reinterpret_cast<unsigned char*>(listI), sizeJ
-                  * sizeof(int));
+              vtkFoamReadBinaryLabels(io, listI, sizeJ);
               io.ReadExpecting(')');
               }
             }
@@ -2548,7 +4562,7 @@ public:
               << currToken;
               }
             this->Superclass::LabelListListPtr
-                ->InsertValue(bodyI++, currToken.To<int>());
+                ->InsertValue(bodyI++, currToken.ToIdType());
             }
           }
         else
@@ -2590,7 +4604,7 @@ public:
         }
       if (currToken.GetType() == vtkFoamToken::LABEL)
         {
-        const int sizeI = currToken.To<int>();
+        const vtkIdType sizeI = currToken.ToIdType();
         if (sizeI < 0)
           {
           throw vtkFoamError() << "List size must not be negative: size = "
@@ -2598,13 +4612,12 @@ public:
           }
         if (sizeI > 0) // avoid invalid reference
           {
-          vtkIntArray *array = (arrayI == 0
+          vtkIdTypeArray *array = (arrayI == 0
               ? this->Superclass::LabelListListPtr->GetIndices()
               : this->Superclass::LabelListListPtr->GetBody());
           array->SetNumberOfValues(sizeI);
           io.ReadExpecting('(');
-          io.Read(reinterpret_cast<unsigned char*>(array->GetPointer(0)),
-              sizeI * sizeof(int));
+          vtkFoamReadBinaryLabels(io, array->GetPointer(0), sizeI);
           io.ReadExpecting(')');
           }
         }
@@ -2668,11 +4681,28 @@ public:
   }
 };
 
+// specializations for reading binary labels of either width into
+// vtkIntArray, or into vtkIdTypeArray for the owner and neighbour lists
+// of the mesh. Must precede ReadNonuniformList() below (HP-UXia64-aCC).
+VTK_TEMPLATE_SPECIALIZE
+void vtkFoamEntryValue::listTraits<vtkIntArray, int>::ReadBinaryList(
+    vtkFoamIOobject& io, const vtkIdType size)
+{
+  vtkFoamReadBinaryLabels(io, this->Ptr->GetPointer(0), size);
+}
+
+VTK_TEMPLATE_SPECIALIZE
+void vtkFoamEntryValue::listTraits<vtkIdTypeArray, vtkIdType>::ReadBinaryList(
+    vtkFoamIOobject& io, const vtkIdType size)
+{
+  vtkFoamReadBinaryLabels(io, this->Ptr->GetPointer(0), size);
+}
+
 // specialization for reading double precision binary into vtkFloatArray.
 // Must precede ReadNonuniformList() below (HP-UXia64-aCC).
 VTK_TEMPLATE_SPECIALIZE
 void vtkFoamEntryValue::listTraits<vtkFloatArray, float>::ReadBinaryList(
-    vtkFoamIOobject& io, const int size)
+    vtkFoamIOobject& io, const vtkIdType size)
 {
   if(io.GetIsSinglePrecisionBinary())
     {
@@ -2681,53 +4711,7 @@ void vtkFoamEntryValue::listTraits<vtkFloatArray, float>::ReadBinaryList(
     }
   else
     {
-#if 0
-    // reduce calls to io.Read() by using the array space as buffer
-    float *destination = this->Ptr->GetPointer(0);
-    double *source = reinterpret_cast<double *>(destination);
-
-    int remainingSize = size;
-    for (int halfSize = size / 2; halfSize > 0; halfSize = remainingSize / 2)
-      {
-      io.Read(reinterpret_cast<unsigned char *>(source),
-          sizeof(double) * halfSize);
-      for (int i = 0; i < halfSize; i++)
-        {
-        *destination++ = static_cast<float>(*source++);
-        }
-      source = reinterpret_cast<double *>(destination);
-      remainingSize -= halfSize;
-      }
-    if (remainingSize > 0)
-      {
-      // read the last one element that doesn't fit into the remaining space
-      double buffer;
-      io.Read(reinterpret_cast<unsigned char *>(&buffer), sizeof(double));
-      *destination = static_cast<float>(buffer);
-      }
-#else
-    const int bufferUnit = 32, nDivs = size / bufferUnit;
-    double buffer[bufferUnit];
-
-    for (int i = 0; i < nDivs; i++)
-      {
-      float *destination = this->Ptr->GetPointer(i * bufferUnit);
-      io.Read(reinterpret_cast<unsigned char *>(buffer),
-          sizeof(double) * bufferUnit);
-      for (int j = 0; j < bufferUnit; j++)
-        {
-        destination[j] = static_cast<float>(buffer[j]);
-        }
-      }
-    const int remainingSize = size % bufferUnit;
-    float *destination = this->Ptr->GetPointer(nDivs * bufferUnit);
-    io.Read(reinterpret_cast<unsigned char *>(buffer),
-        sizeof(double) * remainingSize);
-    for (int j = 0; j < remainingSize; j++)
-      {
-      destination[j] = static_cast<float>(buffer[j]);
-      }
-#endif
+    vtkFoamReadBinaryDoubles(io, this->Ptr->GetPointer(0), size);
     }
 }
 
@@ -2746,14 +4730,15 @@ void vtkFoamEntryValue::ReadNonuniformList(vtkFoamIOobject& io)
   this->Superclass::VtkObjectPtr = list.GetPtr();
   if (currToken.Is<int>())
     {
-    const int size = currToken.To<int>();
+    const vtkIdType size = currToken.ToIdType();
     if (size < 0)
       {
       throw vtkFoamError() << "List size must not be negative: size = " << size;
       }
-    list.GetPtr()->SetNumberOfTuples(size);
+    vtkIdTypeArray *gatherIndices = io.GetGatherIndices();
     if (io.GetFormat() == vtkFoamIOobject::ASCII)
       {
+      list.GetPtr()->SetNumberOfTuples(size);
       if (!io.Read(currToken))
         {
         throw vtkFoamError() << "Unexpected EOF";
@@ -2772,15 +4757,35 @@ void vtkFoamEntryValue::ReadNonuniformList(vtkFoamIOobject& io)
         }
       list.ReadAsciiList(io, size);
       io.ReadExpecting(')');
+      if (gatherIndices != NULL)
+        {
+        vtkFoamGatherTuples(list.GetPtr()->GetPointer(0),
+            list.GetPtr()->GetNumberOfComponents(), size, *gatherIndices);
+        list.GetPtr()->SetNumberOfTuples(gatherIndices->GetNumberOfTuples());
+        }
       }
     else
       {
+      list.GetPtr()->SetNumberOfTuples(gatherIndices != NULL
+          ? gatherIndices->GetNumberOfTuples() : size);
       if (size > 0)
         {
         // read parentheses only when size > 0
         io.ReadExpecting('(');
-        list.ReadBinaryList(io, size);
-        io.ReadExpecting(')');
+        if (gatherIndices != NULL)
+          {
+          list.ReadBinaryListGather(io, size, *gatherIndices);
+          }
+        else
+          {
+          list.ReadBinaryList(io, size);
+          }
+        io.ReadExpecting(')');
+        }
+      else if (gatherIndices != NULL && gatherIndices->GetNumberOfTuples() > 0)
+        {
+        throw vtkFoamError() << "Index " << gatherIndices->GetValue(0)
+            << " is out of range of the list of size 0";
         }
       }
     }
@@ -2790,6 +4795,14 @@ void vtkFoamEntryValue::ReadNonuniformList(vtkFoamIOobject& io)
       {
       list.ReadValue(io, currToken);
       }
+    vtkIdTypeArray *gatherIndices = io.GetGatherIndices();
+    if (gatherIndices != NULL)
+      {
+      vtkFoamGatherTuples(list.GetPtr()->GetPointer(0),
+          list.GetPtr()->GetNumberOfComponents(),
+          list.GetPtr()->GetNumberOfTuples(), *gatherIndices);
+      list.GetPtr()->SetNumberOfTuples(gatherIndices->GetNumberOfTuples());
+      }
     list.GetPtr()->Squeeze();
     }
   else
@@ -2867,6 +4880,10 @@ public:
       }
   }
 
+  bool IsRegEx() const
+  {
+    return this->Preg != NULL;
+  }
   bool RegExMatch(const vtkStdString &string) const
   {
     if (this->Preg == NULL)
@@ -2935,6 +4952,10 @@ public:
       }
   }
 
+  bool IsRegEx() const
+  {
+    return this->Regex != NULL;
+  }
   bool RegExMatch(const vtkStdString &string) const
   {
     if (this->Regex == NULL)
@@ -2995,6 +5016,10 @@ public:
       }
   }
 
+  bool IsRegEx() const
+  {
+    return this->Regex != NULL;
+  }
   bool RegExMatch(const vtkStdString &string) const
   {
     if (this->Regex == NULL)
@@ -3022,6 +5047,15 @@ private:
   vtkFoamEntry();
 
 public:
+  // allocated from the arena
+  static void *operator new(size_t size)
+  {
+    return vtkFoamArena::Allocate(size);
+  }
+  static void operator delete(void *ptr, size_t size)
+  {
+    vtkFoamArena::Free(ptr, size);
+  }
   vtkFoamEntry(vtkFoamDict *upperDictPtr) :
     Keyword(), UpperDictPtr(upperDictPtr)
   {
@@ -3130,6 +5164,10 @@ public:
   {
     return this->Superclass::size() > 0 ? this->FirstValue().ToInt() : 0;
   }
+  vtkIdType ToIdType() const
+  {
+    return this->Superclass::size() > 0 ? this->FirstValue().ToIdType() : 0;
+  }
 
   void ReadDictionary(vtkFoamIOobject& io)
   {
@@ -3148,27 +5186,100 @@ struct vtkFoamDict : public vtkstd::vector<vtkFoamEntry*>
 {
 private:
   typedef vtkstd::vector<vtkFoamEntry*> Superclass;
+  typedef vtksys::hash_map<vtkstd::string, size_t> literalIndex;
 
   vtkFoamToken Token;
   const vtkFoamDict *UpperDictPtr;
 
+  // positions of the first entries with each keyword, and of the
+  // entries with regex keywords in ascending order. Entries must be
+  // added and removed only through PushBack() and PopBack() to keep
+  // them in sync.
+  literalIndex LiteralIndex;
+  vtkstd::vector<size_t> RegExEntries;
+
   vtkFoamDict(const vtkFoamDict &);
 
+  void IndexBack()
+  {
+    const size_t entryI = this->Superclass::size() - 1;
+    const vtkFoamKeyword &keyword = this->Superclass::back()->GetKeyword();
+    // insert() keeps the existing position so that the first entry wins
+    this->LiteralIndex.insert(literalIndex::value_type(keyword, entryI));
+    if (keyword.IsRegEx())
+      {
+      this->RegExEntries.push_back(entryI);
+      }
+  }
+
+  // appends an entry whose keyword has already been set
+  void PushBack(vtkFoamEntry *entry)
+  {
+    this->Superclass::push_back(entry);
+    this->IndexBack();
+  }
+
+  // appends a new entry with the given keyword. The entry is owned by
+  // the dictionary before the keyword is set since a regex compilation
+  // error throws.
+  vtkFoamEntry *PushBack(const vtkFoamToken& keyword,
+      const bool isRegExKeyword)
+  {
+    this->Superclass::push_back(new vtkFoamEntry(this));
+    this->Superclass::back()->SetKeyword(keyword, isRegExKeyword);
+    this->IndexBack();
+    return this->Superclass::back();
+  }
+
+  // deletes the last entry
+  void PopBack()
+  {
+    const size_t entryI = this->Superclass::size() - 1;
+    literalIndex::iterator it
+        = this->LiteralIndex.find(this->Superclass::back()->GetKeyword());
+    if (it != this->LiteralIndex.end() && it->second == entryI)
+      {
+      this->LiteralIndex.erase(it);
+      }
+    if (this->RegExEntries.size() > 0 && this->RegExEntries.back() == entryI)
+      {
+      this->RegExEntries.pop_back();
+      }
+    delete this->Superclass::back();
+    this->Superclass::pop_back();
+  }
+
 public:
+  // allocated from the arena
+  static void *operator new(size_t size)
+  {
+    return vtkFoamArena::Allocate(size);
+  }
+  static void operator delete(void *ptr, size_t size)
+  {
+    vtkFoamArena::Free(ptr, size);
+  }
   vtkFoamDict(const vtkFoamDict *upperDictPtr = NULL) :
-    Superclass(), Token(), UpperDictPtr(upperDictPtr)
+    Superclass(), Token(), UpperDictPtr(upperDictPtr), LiteralIndex(),
+    RegExEntries()
   {
   }
   vtkFoamDict(const vtkFoamDict& dict, const vtkFoamDict *upperDictPtr) :
-    Superclass(dict.size()), Token(), UpperDictPtr(upperDictPtr)
+    Superclass(), Token(), UpperDictPtr(upperDictPtr), LiteralIndex(),
+    RegExEntries()
   {
     if (dict.GetType() == vtkFoamToken::DICTIONARY)
       {
+      this->Superclass::reserve(dict.size());
       for (size_t entryI = 0; entryI < dict.size(); entryI++)
         {
-        this->operator[](entryI) = new vtkFoamEntry(*dict[entryI], this);
+        this->PushBack(new vtkFoamEntry(*dict[entryI], this));
         }
       }
+    else
+      {
+      this->Superclass::resize(dict.size());
+      }
   }
 
   ~vtkFoamDict()
@@ -3196,19 +5307,33 @@ public:
     return this->UpperDictPtr;
   }
 
+  // deletes all the entries to read the dictionary again
+  void Clear()
+  {
+    if (this->Token.GetType() == vtkFoamToken::UNDEFINED)
+      {
+      while (this->Superclass::size() > 0)
+        {
+        this->PopBack();
+        }
+      }
+    else
+      {
+      this->Superclass::clear();
+      this->Token = vtkFoamToken();
+      }
+  }
+
   // lookup by literal search
   vtkFoamEntry *LookupLiteral(const vtkStdString& keyword) const
   {
     if (this->Token.GetType() == vtkFoamToken::UNDEFINED)
       {
-      for (size_t entryI = 0; entryI < this->Superclass::size(); entryI++)
+      literalIndex::const_iterator it = this->LiteralIndex.find(keyword);
+      if (it != this->LiteralIndex.end())
         {
-        // attempt literal match
-        if (this->operator[](entryI)->GetKeyword() == keyword)
-          {
-          // found
-          return this->operator[](entryI);
-          }
+        // found
+        return this->operator[](it->second);
         }
       }
 
@@ -3226,15 +5351,17 @@ public:
       vtkFoamEntry *entry = this->LookupLiteral(keyword);
       if (entry == NULL)
         {
-        // regex is matched in descending order
-        for (int entryI = static_cast<int>(this->Superclass::size()) - 1;
-            entryI >= 0; entryI--)
+        // regex is matched in descending order so that the last
+        // matching entry wins. Only regex keywords are visited.
+        for (size_t regExI = this->RegExEntries.size(); regExI-- > 0;)
           {
           // attempt regex match
-          if (this->operator[](entryI)->GetKeyword().RegExMatch(keyword))
+          vtkFoamEntry *regExEntry
+              = this->operator[](this->RegExEntries[regExI]);
+          if (regExEntry->GetKeyword().RegExMatch(keyword))
             {
             // found
-            entry = this->operator[](entryI);
+            entry = regExEntry;
             break;
             }
           }
@@ -3258,6 +5385,8 @@ public:
   bool Read(vtkFoamIOobject& io, const bool isSubDictionary = false,
       const vtkFoamToken& firstToken = vtkFoamToken())
   {
+    // the tree read from a file is allocated from an arena of its own
+    vtkFoamArenaScope arena(!isSubDictionary);
     try
       {
       bool isRegExKeyword = true;
@@ -3336,9 +5465,7 @@ public:
       // but string does not work as regex.
       else if (firstToken.IsWordOrString())
         {
-        this->Superclass::push_back(new vtkFoamEntry(this));
-        this->Superclass::back()->SetKeyword(firstToken, isRegExKeyword);
-        this->Superclass::back()->ReadDictionary(io);
+        this->PushBack(firstToken, isRegExKeyword)->ReadDictionary(io);
         if (!io.Read(currToken) || currToken == '}' || currToken == ')')
           {
           return true;
@@ -3361,6 +5488,7 @@ public:
             if (isRegExKeyword && (previousEntry
                 = this->LookupLiteral(currToken.ToStdString())) != NULL)
               {
+              vtkFoamKeywordScope keywordScope(io, currToken.ToStdString());
               if (io.GetInputMode() == vtkFoamFile::INPUT_MODE_MERGE)
                 {
                 if (previousEntry->FirstValue().GetType()
@@ -3394,11 +5522,23 @@ public:
                   << currToken.ToStdString();
                 }
               }
+            else if (io.GetHasEntryFilter())
+              {
+              if (io.IsEntryWanted(currToken.ToStdString()))
+                {
+                vtkFoamKeywordScope keywordScope(io, currToken.ToStdString());
+                this->PushBack(currToken, isRegExKeyword)->Read(io);
+                }
+              else
+                {
+                io.SkipEntry(this, currToken.ToStdString());
+                // nothing to be done for the skipped entry
+                continue;
+                }
+              }
             else
               {
-              this->Superclass::push_back(new vtkFoamEntry(this));
-              this->Superclass::back()->SetKeyword(currToken, isRegExKeyword);
-              this->Superclass::back()->Read(io);
+              this->PushBack(currToken, isRegExKeyword)->Read(io);
               }
 
             // the "FoamFile" keyword of type word must be searched by exact
@@ -3406,8 +5546,7 @@ public:
             if(currToken == "FoamFile")
               {
               // delete the FoamFile header subdictionary entry
-              delete this->Superclass::back();
-              this->Superclass::pop_back();
+              this->PopBack();
               }
             // the "include" keyword of type word or string must be searched by
             // exact match (no need for regex search)
@@ -3427,8 +5566,7 @@ public:
                 }
               const vtkStdString includeFileName(
                   this->Superclass::back()->ToString());
-              delete this->Superclass::back();
-              this->Superclass::pop_back();
+              this->PopBack();
               io.IncludeFile(includeFileName, io.GetFilePath(), false);
               }
             }
@@ -3458,23 +5596,23 @@ public:
                   // I think #inputMode handling should be done here
                   // as well, but the genuine FoamFile parser for OF
                   // 1.5 does not seem to be doing it.
-                  this->Superclass::push_back(
+                  this->PushBack(
                       new vtkFoamEntry(*identifiedDict[entryI], this));
                   }
                 break;
                 }
               else
                 {
+                // an entry that has been skipped is read if referenced
+                io.CheckSkippedEntry(uDictPtr, identifier);
                 uDictPtr = uDictPtr->GetUpperDictPtr();
                 if (uDictPtr == NULL)
                   {
                   // if no entry with the identifier as keyowrd is found
                   // interpret the identifier as keyword
-                  this->Superclass::push_back(new vtkFoamEntry(this));
                   vtkFoamToken keywordToken;
                   keywordToken.SetWord("$" + identifier);
-                  this->Superclass::back()->SetKeyword(keywordToken, isRegExKeyword);
-                  this->Superclass::back()->Read(io);
+                  this->PushBack(keywordToken, isRegExKeyword)->Read(io);
                   }
                 }
               }
@@ -3510,6 +5648,28 @@ public:
   }
 };
 
+//-----------------------------------------------------------------------------
+// reads a file opened by io into dict skipping the entries rejected by
+// filter. Should a skipped entry turn out to be referenced, the file
+// is read again with the entry, which is repeated for each reference.
+static bool vtkFoamReadDict(vtkFoamIOobject &io, vtkFoamDict &dict,
+    const vtkFoamEntryFilter *filter)
+{
+  const vtkStdString fileName(io.GetFileName());
+  io.SetEntryFilter(filter);
+  bool isRead = dict.Read(io);
+  size_t nReferenced = 0;
+  while (!isRead && io.GetNumberOfReferencedPaths() > nReferenced)
+    {
+    nReferenced = io.GetNumberOfReferencedPaths();
+    io.Close();
+    dict.Clear();
+    isRead = io.Open(fileName) && dict.Read(io);
+    }
+  io.SetEntryFilter(NULL);
+  return isRead;
+}
+
 void vtkFoamIOobject::ReadHeader()
 {
   // the "FoamFile" keyword must be searched by exact match (no need
@@ -3544,6 +5704,13 @@ void vtkFoamIOobject::ReadHeader()
     throw vtkFoamError() << "valid object name not found in FoamFile header";
     }
   this->ObjectName = objectEntry->ToStdString();
+
+  // the arch entry (e. g. "LSB;label=64;scalar=64") is written by
+  // OpenFOAM 2.3 and later. Absence means 32-bit labels.
+  const vtkFoamEntry *archEntry = headerDict.Lookup("arch");
+  this->Use64BitLabels = (archEntry != NULL
+      && archEntry->FirstValue().IsWordOrString()
+      && archEntry->ToStdString().find("label=64") != vtkStdString::npos);
 }
 
 vtkFoamEntryValue::vtkFoamEntryValue(
@@ -4169,6 +6336,8 @@ void vtkFoamEntry::Read(vtkFoamIOobject& io)
           }
         else
           {
+          // an entry that has been skipped is read if referenced
+          io.CheckSkippedEntry(uDictPtr, identifier);
           uDictPtr = uDictPtr->GetUpperDictPtr();
           if (uDictPtr == NULL)
             {
@@ -4201,1728 +6370,4017 @@ void vtkFoamEntry::Read(vtkFoamIOobject& io)
 }
 
 //-----------------------------------------------------------------------------
-// vtkOFFReaderPrivate static members
-const char *vtkOFFReaderPrivate::InternalMeshIdentifier
-    = "[InternalMesh]";
-const char *vtkOFFReaderPrivate::SurfaceMeshIdentifier
-    = "[InternalSurfaceMesh]";
-const char *vtkOFFReaderPrivate::ProcessorPatchesIdentifier
-    = "[ProcessorPatches]";
-
-//-----------------------------------------------------------------------------
-int vtkOFFReaderPrivate::GetBoundaryTypeProcessor()
-{
-  return static_cast<int>(vtkFoamBoundaryEntry::PROCESSOR);
-}
-
-//-----------------------------------------------------------------------------
-int vtkOFFReaderPrivate::GetBoundaryTypeInternal()
+// class vtkFoamHeaderCache
+// process-wide cache of the class and object names in the FoamFile
+// headers of files, keyed on the file paths and validated by the sizes
+// and the modification times of the files. Shared by every reader in
+// the process so that a directory is rescanned by opening only the
+// files created or rewritten since. Never destroyed.
+struct vtkFoamHeaderCache
 {
-  return static_cast<int>(vtkFoamBoundaryEntry::INTERNAL);
-}
+private:
+  struct vtkFoamCachedHeader
+    {
+    unsigned long Length;
+    long MTime;
+    // false if the file does not have a valid header
+    bool IsValid;
+    vtkStdString ClassName;
+    vtkStdString ObjectName;
+    };
 
-//-----------------------------------------------------------------------------
-// vtkOFFReaderPrivate constructor and destructor
-vtkOFFReaderPrivate::vtkOFFReaderPrivate()
-{
-  // DATA TIMES
-  this->TimeStep = 0;
-  this->TimeStepOld = -1;
-  this->TimeValues = vtkDoubleArray::New();
-  this->TimeNames = vtkStringArray::New();
+  typedef vtksys::hash_map<vtkstd::string, vtkFoamCachedHeader>
+      vtkFoamCachedHeaderMap;
 
-  // selection
-  this->InternalMeshSelectionStatus = 0;
-  this->InternalMeshSelectionStatusOld = 0;
+  static vtkFoamHeaderCache *Instance;
 
-  // DATA COUNTS
-  this->NumCells = 0;
-  this->NumPoints = 0;
-  this->NumInternalFaces = 0;
+  vtkSimpleMutexLock Lock;
+  vtkFoamCachedHeaderMap Headers;
 
-  this->VolFieldFiles = vtkStringArray::New();
-  this->SurfaceFieldFiles = vtkStringArray::New();
-  this->PointFieldFiles = vtkStringArray::New();
-  this->LagrangianFieldFiles = vtkStringArray::New();
-  this->PolyMeshPointsDir = vtkStringArray::New();
-  this->PolyMeshFacesDir = vtkStringArray::New();
+  vtkFoamHeaderCache() : Lock()
+  {
+  }
+  vtkFoamHeaderCache(const vtkFoamHeaderCache &); // not implemented
+  void operator=(const vtkFoamHeaderCache &); // not implemented
 
-  // for creating cell-to-point translated data
-  this->BoundaryPointMap = NULL;
-  this->AllBoundaries = NULL;
-  this->AllBoundariesPointMap = NULL;
-  this->InternalPoints = NULL;
+public:
+  static vtkFoamHeaderCache *GetInstance()
+  {
+    return Instance;
+  }
 
-  // for caching mesh
-  this->InternalMesh = NULL;
-  this->SurfaceMesh = NULL;
-  this->BoundaryMesh = NULL;
-  this->BoundaryPointMap = NULL;
-#if 0
-  this->ReciprocalDelta = NULL;
-#endif
-  this->FaceOwner = NULL;
-  this->ProcessorFaces = NULL;
-  this->LagrangianMesh = NULL;
-  this->PointZoneMesh = NULL;
-  this->FaceZoneMesh = NULL;
-  this->CellZoneMesh = NULL;
+  // the class and object names in the header of a file, and the size
+  // and the modification time the header is valid for (-1 if the file
+  // has just been modified and has to be read again the next time).
+  // Returns false if the file can not be read or does not have a valid
+  // header.
+  bool GetHeader(const vtkStdString &casePath, const vtkStdString &path,
+      const bool isSinglePrecisionBinary, vtkStdString &className,
+      vtkStdString &objectName, unsigned long &length, long &mTime)
+  {
+    length = vtksys::SystemTools::FileLength(path.c_str());
+    mTime = vtksys::SystemTools::ModifiedTime(path.c_str());
+    if (mTime == 0)
+      {
+      // the file does not exist
+      return false;
+      }
 
-  // for decomposing polyhedra
-  this->NumAdditionalCells = 0;
-  this->AdditionalCellIds = NULL;
-  this->NumAdditionalCells = NULL;
-  this->AdditionalCellPoints = NULL;
-}
+    this->Lock.Lock();
+    vtkFoamCachedHeaderMap::const_iterator headerI = this->Headers.find(path);
+    if (headerI != this->Headers.end() && headerI->second.Length == length
+        && headerI->second.MTime == mTime)
+      {
+      const bool isValid = headerI->second.IsValid;
+      className = headerI->second.ClassName;
+      objectName = headerI->second.ObjectName;
+      this->Lock.Unlock();
+      return isValid;
+      }
+    this->Lock.Unlock();
 
-//-----------------------------------------------------------------------------
-vtkOFFReaderPrivate::~vtkOFFReaderPrivate()
-{
-  this->TimeValues->Delete();
-  this->TimeNames->Delete();
+    // the file is read without holding the lock
+    vtkFoamCachedHeader header;
+    header.Length = length;
+    header.MTime = mTime;
+    vtkFoamIOobject io(casePath, isSinglePrecisionBinary);
+    header.IsValid = io.Open(path);
+    if (header.IsValid)
+      {
+      header.ClassName = io.GetClassName();
+      header.ObjectName = io.GetObjectName();
+      io.Close();
+      }
+    className = header.ClassName;
+    objectName = header.ObjectName;
 
-  this->VolFieldFiles->Delete();
-  this->SurfaceFieldFiles->Delete();
-  this->PointFieldFiles->Delete();
-  this->LagrangianFieldFiles->Delete();
-  this->PolyMeshPointsDir->Delete();
-  this->PolyMeshFacesDir->Delete();
+    // the files modified within the last few seconds may still be
+    // rewritten within the resolution of the modification times
+    if (mTime < static_cast<long>(time(NULL)) - VTK_FOAMFILE_MTIME_MARGIN)
+      {
+      this->Lock.Lock();
+      if (this->Headers.size() >= VTK_FOAMFILE_HEADERCACHE_MAXFILES)
+        {
+        this->Headers.clear();
+        }
+      this->Headers[path] = header;
+      this->Lock.Unlock();
+      }
+    else
+      {
+      mTime = -1;
+      }
+    return header.IsValid;
+  }
+};
 
-  this->ClearMeshes();
-}
+// constructed at load time, before any reader can run
+vtkFoamHeaderCache *vtkFoamHeaderCache::Instance = new vtkFoamHeaderCache;
 
 //-----------------------------------------------------------------------------
-void vtkOFFReaderPrivate::PrintSelf(ostream &os, vtkIndent indent)
+// struct vtkFoamCaseIndex
+// the directories of a case indexed by their modification times: the
+// subdirectories of each directory and the headers of the files in
+// it. An entry is rescanned when its directory has been modified,
+// i. e. when a file or a subdirectory has been created, renamed or
+// removed there. Directories modified within the last few seconds are
+// rescanned every time since the files just created may be incomplete.
+// The headers of an entry are revalidated by the sizes and the
+// modification times of the files since a file rewritten in place does
+// not modify its directory.
+struct vtkFoamCaseIndex
 {
-  this->Superclass::PrintSelf(os, indent);
-  os << indent << "Case Path: "
-      << (this->CasePath.length() ? this->CasePath.c_str() : "(none)") << endl;
-  os << indent << "Region Name: "
-      << (this->RegionName.length() ? this->RegionName.c_str() : "(none)")
-      << endl;
-  os << indent << "Processor Name: "
-      << (this->ProcessorName.length() ? this->ProcessorName.c_str() : "(none)")
-      << endl;
-  if (this->TimeValues)
-    {
-    os << indent << "Number of Time Steps: "
-        << this->TimeValues->GetNumberOfTuples() << endl;
-    }
-  os << indent << "Time Step: " << this->TimeStep << endl;
-  os << indent << "Number of Cells: " << this->NumCells << endl;
-  os << indent << "Number of Points: " << this->NumPoints << endl;
-}
+  struct vtkFoamFileHeader
+    {
+    vtkStdString FileName;
+    vtkStdString ClassName;
+    vtkStdString ObjectName;
+    // the size and the modification time of the file when the header
+    // was read, the latter -1 if the header has to be read again
+    unsigned long Length;
+    long MTime;
+    };
 
-//-----------------------------------------------------------------------------
-void vtkOFFReaderPrivate::ClearInternalMeshes()
-{
-  if (this->FaceOwner != NULL)
-    {
-    this->FaceOwner->Delete();
-    this->FaceOwner = NULL;
-    }
-  delete this->ProcessorFaces;
-  this->ProcessorFaces = NULL;
-  if (this->InternalMesh != NULL)
-    {
-    this->InternalMesh->Delete();
-    this->InternalMesh = NULL;
-    }
-  if (this->SurfaceMesh != NULL)
-    {
-    this->SurfaceMesh->Delete();
-    this->SurfaceMesh = NULL;
-    }
-  if (this->AdditionalCellIds != NULL)
-    {
-    this->AdditionalCellIds->Delete();
-    this->AdditionalCellIds = NULL;
-    }
-  if (this->NumAdditionalCells != NULL)
+  struct vtkFoamDirEntry
     {
-    this->NumAdditionalCells->Delete();
-    this->NumAdditionalCells = NULL;
-    }
-  delete this->AdditionalCellPoints;
-  this->AdditionalCellPoints = NULL;
+    // -1 if the entry has to be rescanned
+    long MTime;
+    bool HasHeaders;
+    // sorted for binary search
+    vtkstd::vector<vtkStdString> SubDirs;
+    vtkstd::vector<vtkFoamFileHeader> Headers;
 
-  if (this->PointZoneMesh != NULL)
-    {
-    this->PointZoneMesh->Delete();
-    this->PointZoneMesh = NULL;
-    }
-  if (this->FaceZoneMesh != NULL)
+    bool HasSubDir(const vtkStdString &name) const
     {
-    this->FaceZoneMesh->Delete();
-    this->FaceZoneMesh = NULL;
+      return vtkstd::binary_search(this->SubDirs.begin(), this->SubDirs.end(),
+          name);
     }
-  if (this->CellZoneMesh != NULL)
+    // the header of a file, or of the gzipped file if there is none
+    const vtkFoamFileHeader *GetHeader(const vtkStdString &fileName) const
     {
-    this->CellZoneMesh->Delete();
-    this->CellZoneMesh = NULL;
+      const vtkStdString fileNames[2] = {fileName, fileName + ".gz"};
+      for (int nameI = 0; nameI < 2; nameI++)
+        {
+        for (size_t headerI = 0; headerI < this->Headers.size(); headerI++)
+          {
+          if (this->Headers[headerI].FileName == fileNames[nameI])
+            {
+            return &this->Headers[headerI];
+            }
+          }
+        }
+      return NULL;
     }
-}
+    };
 
-//-----------------------------------------------------------------------------
-void vtkOFFReaderPrivate::ClearBoundaryMeshes()
-{
-  if (this->BoundaryMesh != NULL)
-    {
-    this->BoundaryMesh->Delete();
-    this->BoundaryMesh = NULL;
-    }
+  typedef vtksys::hash_map<vtkstd::string, vtkFoamDirEntry> vtkFoamDirMap;
 
-  delete this->BoundaryPointMap;
-  this->BoundaryPointMap = NULL;
-#if 0
-  delete this->ReciprocalDelta;
-  this->ReciprocalDelta = NULL;
-#endif
+  vtkStdString CasePath;
+  vtkFoamDirMap Dirs;
+  // whether the index has been read from the cache directory
+  bool IsRead;
+  // whether there are entries not written to the cache directory yet
+  bool IsModified;
 
-  if (this->InternalPoints != NULL)
-    {
-    this->InternalPoints->Delete();
-    this->InternalPoints = NULL;
-    }
-  if (this->AllBoundaries != NULL)
-    {
-    this->AllBoundaries->Delete();
-    this->AllBoundaries = NULL;
-    }
-  if (this->AllBoundariesPointMap != NULL)
-    {
-    this->AllBoundariesPointMap->Delete();
-    this->AllBoundariesPointMap = NULL;
-    }
-}
+  vtkFoamCaseIndex() : IsRead(false), IsModified(false)
+  {
+  }
 
-//-----------------------------------------------------------------------------
-void vtkOFFReaderPrivate::ClearLagrangianMeshes()
-{
-  if (this->LagrangianMesh)
-    {
-    this->LagrangianMesh->Delete();
-    this->LagrangianMesh = 0;
-    }
-}
+  void Initialize(const vtkStdString &casePath)
+  {
+    this->CasePath = casePath;
+    this->Dirs.clear();
+    this->IsRead = false;
+    this->IsModified = false;
+  }
 
-//-----------------------------------------------------------------------------
-void vtkOFFReaderPrivate::ClearMeshes()
-{
-  this->ClearInternalMeshes();
-  this->ClearBoundaryMeshes();
-  this->ClearLagrangianMeshes();
-}
+  // excluded extensions cf. src/OpenFOAM/OSspecific/Unix/Unix.C
+  static bool IsBackupFile(const vtkStdString &fileName)
+  {
+    const size_t len = fileName.length();
+    return fileName.substr(len - 1) == "~" || (len >= 4
+        && (fileName.substr(len - 4) == ".bak"
+        || fileName.substr(len - 4) == ".BAK"
+        || fileName.substr(len - 4) == ".old"))
+        || (len >= 5 && fileName.substr(len - 5) == ".save");
+  }
 
-//-----------------------------------------------------------------------------
-void vtkOFFReaderPrivate::SetTimeValue(const double requestedTime)
-{
-  const int nTimeValues = this->TimeValues->GetNumberOfTuples();
-  if (nTimeValues > 0)
-    {
-    int minTimeI = 0;
-    double minTimeDiff = fabs(this->TimeValues->GetValue(0) - requestedTime);
-    for (int timeI = 1; timeI < nTimeValues; timeI++)
+  // the entry of a directory, or NULL if the directory does not exist.
+  // The file headers are read only if withHeaders is set.
+  const vtkFoamDirEntry *Lookup(const vtkStdString &dirPath,
+      const bool withHeaders, const bool isSinglePrecisionBinary)
+  {
+    vtkFoamDirMap::iterator dirI = this->Dirs.find(dirPath);
+    const long mTime = vtksys::SystemTools::ModifiedTime(dirPath.c_str());
+    if (dirI != this->Dirs.end() && dirI->second.MTime == mTime
+        && (dirI->second.HasHeaders || !withHeaders))
       {
-      const double timeDiff(fabs(this->TimeValues->GetValue(timeI)
-          - requestedTime));
-      if (timeDiff < minTimeDiff)
+      if (withHeaders)
         {
-        minTimeI = timeI;
-        minTimeDiff = timeDiff;
+        // files rewritten in place do not change the modification time
+        // of the directory, hence the headers are validated by the
+        // sizes and the modification times of the files
+        this->ValidateHeaders(dirPath, dirI->second, isSinglePrecisionBinary);
         }
+      return &dirI->second;
       }
-    this->SetTimeStep(minTimeI); // set Modified() if TimeStep changed
-    }
-}
 
-//-----------------------------------------------------------------------------
-void vtkOFFReaderPrivate::SetupInformation(const vtkStdString &casePath,
-    const vtkStdString &regionName, const vtkStdString &procName,
-    vtkOFFReaderPrivate *master)
-{
-  // copy parent, path and timestep information from master
-  this->CasePath = casePath;
-  this->RegionName = regionName;
-  this->ProcessorName = procName;
-  this->Parent = master->Parent;
-  this->TimeValues->Delete();
-  this->TimeValues = master->TimeValues;
-  this->TimeValues->Register(0);
-  this->TimeNames->Delete();
-  this->TimeNames = master->TimeNames;
-  this->TimeNames->Register(0);
+    vtkDirectory *directory = vtkDirectory::New();
+    if (mTime == 0 || !directory->Open(dirPath.c_str()))
+      {
+      directory->Delete();
+      if (dirI != this->Dirs.end())
+        {
+        this->Dirs.erase(dirI);
+        this->IsModified = true;
+        }
+      return NULL;
+      }
 
-  this->PopulatePolyMeshDirArrays();
-}
+    // the subdirectories already known are not stat()ed again so that
+    // rescanning a directory costs about as much as listing the new
+    // entries in it
+    vtkFoamDirEntry &entry = this->Dirs[dirPath];
+    vtkstd::vector<vtkStdString> subDirsOld;
+    subDirsOld.swap(entry.SubDirs);
+    entry.Headers.clear();
+    const int nFiles = directory->GetNumberOfFiles();
+    for (int fileI = 0; fileI < nFiles; fileI++)
+      {
+      const vtkStdString fileName(directory->GetFile(fileI));
+      if (fileName == "." || fileName == "..")
+        {
+        continue;
+        }
+      if (vtkstd::binary_search(subDirsOld.begin(), subDirsOld.end(), fileName)
+          || directory->FileIsDirectory(fileName.c_str()))
+        {
+        entry.SubDirs.push_back(fileName);
+        }
+      else if (withHeaders && !vtkFoamCaseIndex::IsBackupFile(fileName))
+        {
+        vtkFoamFileHeader header;
+        if (vtkFoamHeaderCache::GetInstance()->GetHeader(this->CasePath,
+            dirPath + "/" + fileName, isSinglePrecisionBinary,
+            header.ClassName, header.ObjectName, header.Length,
+            header.MTime)) // file exists and readable
+          {
+          header.FileName = fileName;
+          entry.Headers.push_back(header);
+          }
+        }
+      }
+    directory->Delete();
+    vtkstd::sort(entry.SubDirs.begin(), entry.SubDirs.end());
+    entry.HasHeaders = withHeaders;
+
+    // a margin of a few seconds for the files being written and for
+    // the coarse modification times of some filesystems
+    if (mTime < static_cast<long>(time(NULL)) - VTK_FOAMFILE_MTIME_MARGIN)
+      {
+      entry.MTime = mTime;
+      this->IsModified = true;
+      }
+    else
+      {
+      entry.MTime = -1;
+      }
+    return &entry;
+  }
+
+  // a header is read again (or taken from the header cache) only if
+  // the file has been rewritten since
+  void ValidateHeaders(const vtkStdString &dirPath, vtkFoamDirEntry &entry,
+      const bool isSinglePrecisionBinary)
+  {
+    size_t validI = 0;
+    for (size_t headerI = 0; headerI < entry.Headers.size(); headerI++)
+      {
+      vtkFoamFileHeader &header = entry.Headers[headerI];
+      const vtkStdString path(dirPath + "/" + header.FileName);
+      if (header.MTime == -1
+          || vtksys::SystemTools::ModifiedTime(path.c_str()) != header.MTime
+          || vtksys::SystemTools::FileLength(path.c_str()) != header.Length)
+        {
+        this->IsModified = true;
+        if (!vtkFoamHeaderCache::GetInstance()->GetHeader(this->CasePath,
+            path, isSinglePrecisionBinary, header.ClassName,
+            header.ObjectName, header.Length, header.MTime))
+          {
+          continue;
+          }
+        }
+      if (validI != headerI)
+        {
+        entry.Headers[validI] = header;
+        }
+      validI++;
+      }
+    entry.Headers.resize(validI);
+  }
+
+  // the header of a file in a directory, which may be gzipped
+  const vtkFoamFileHeader *LookupHeader(const vtkStdString &dirPath,
+      const vtkStdString &fileName, const bool isSinglePrecisionBinary)
+  {
+    const vtkFoamDirEntry *entry
+        = this->Lookup(dirPath, true, isSinglePrecisionBinary);
+    return entry != NULL ? entry->GetHeader(fileName) : NULL;
+  }
+};
 
 //-----------------------------------------------------------------------------
-void vtkOFFReaderPrivate::GetFieldNames(const vtkStdString &tempPath,
-    const bool isLagrangian, vtkStringArray *cellObjectNames,
-    vtkStringArray *surfaceObjectNames, vtkStringArray *pointObjectNames)
+// struct vtkFoamCaseWatcher
+// watches the directories the time directories of a case are created
+// in (the case directory or the processor subdirectories) and the
+// files written in the new time directories and in their
+// subdirectories (polyMesh, regions, lagrangian, uniform). A time
+// directory is complete when every file written there has been closed
+// and all the files of the time directory completed before it are
+// present, or when a later time directory has been created next to it.
+// A timestep is complete when its time directories in all the watched
+// directories are.
+struct vtkFoamCaseWatcher
 {
-  // open the directory and get num of files
-  vtkDirectory *directory = vtkDirectory::New();
-  if (!directory->Open(tempPath.c_str()))
-    {
-    // no data
+  struct vtkFoamWatchedDir
+    {
+    // index to Parents
+    int Parent;
+    // empty for a watched parent directory
+    vtkStdString TimeName;
+    double TimeValue;
+    // the watch descriptor of the time directory and the path of the
+    // directory relative to it, with a trailing slash (empty for the
+    // time directory itself)
+    int Root;
+    vtkStdString SubPath;
+    // whether each file seen in the time directory and its
+    // subdirectories has been closed after written, keyed by the path
+    // relative to the time directory. Only kept in the root.
+    vtksys::hash_map<vtkstd::string, bool> Files;
+    };
+
+  // keyed by watch descriptors
+  typedef vtksys::hash_map<int, vtkFoamWatchedDir> vtkFoamWatchedDirMap;
+
+  // the inotify instance, -1 if not watching by events
+  int Fd;
+  // the case the watcher has been started for
+  vtkStdString FileName;
+  vtkstd::vector<vtkStdString> Parents;
+  // the files of the time directory completed last in each parent
+  vtkstd::vector<vtkstd::vector<vtkStdString> > ExpectedFiles;
+  vtkFoamWatchedDirMap Dirs;
+  // the number of parents each timestep has been completed in
+  vtksys::hash_map<vtkstd::string, int> NCompleted;
+
+  vtkFoamCaseWatcher() : Fd(-1)
+  {
+  }
+
+  ~vtkFoamCaseWatcher()
+  {
+    this->Stop();
+  }
+
+  void Stop()
+  {
+#if VTK_FOAMFILE_USE_INOTIFY
+    if (this->Fd >= 0)
+      {
+      close(this->Fd);
+      }
+#endif
+    this->Fd = -1;
+    this->FileName = "";
+    this->Parents.clear();
+    this->ExpectedFiles.clear();
+    this->Dirs.clear();
+    this->NCompleted.clear();
+  }
+
+  // the value of a time directory name, false if not a time directory
+  static bool GetTimeValue(const vtkStdString &name, double &value)
+  {
+    char *endptr;
+    value = strtod(name.c_str(), &endptr);
+    return name.length() > 0 && endptr == name.c_str() + name.length();
+  }
+
+  // the regular files in a directory and in its subdirectories by
+  // their paths relative to the directory prefixed with subPath,
+  // sorted. The subdirectories are appended to subDirs if given.
+  static void ListFiles(const vtkStdString &dirPath,
+      const vtkStdString &subPath, vtkstd::vector<vtkStdString> &files,
+      vtkstd::vector<vtkStdString> *subDirs = NULL)
+  {
+    vtkDirectory *directory = vtkDirectory::New();
+    if (directory->Open(dirPath.c_str()))
+      {
+      for (int fileI = 0; fileI < directory->GetNumberOfFiles(); fileI++)
+        {
+        const vtkStdString fileName(directory->GetFile(fileI));
+        if (fileName == "." || fileName == "..")
+          {
+          continue;
+          }
+        if (directory->FileIsDirectory(fileName.c_str()))
+          {
+          const vtkStdString subDirPath(subPath + fileName + "/");
+          if (subDirs != NULL)
+            {
+            subDirs->push_back(subDirPath);
+            }
+          vtkFoamCaseWatcher::ListFiles(dirPath + "/" + fileName, subDirPath,
+              files, subDirs);
+          }
+        else if (!vtkFoamCaseIndex::IsBackupFile(fileName))
+          {
+          files.push_back(subPath + fileName);
+          }
+        }
+      }
     directory->Delete();
-    return;
-    }
+    vtkstd::sort(files.begin(), files.end());
+  }
 
-  // loop over all files and locate valid fields
-  int nFieldFiles = directory->GetNumberOfFiles();
-  for (int j = 0; j < nFieldFiles; j++)
-    {
-    const vtkStdString fieldFile(directory->GetFile(j));
-    const size_t len = fieldFile.length();
+  // start watching the given parent directories (with trailing
+  // slashes). Returns false if the directories can not be watched by
+  // events, in which case the caller falls back to polling. If there
+  // are no parents yet, e. g. in a decomposed case before the
+  // processor directories have been created, the watcher is left
+  // stopped so that it is started again at the next poll.
+  bool Start(const vtkStdString &fileName, vtkStringArray *parents)
+  {
+    this->Stop();
+    if (parents->GetNumberOfValues() == 0)
+      {
+      return false;
+      }
+    this->FileName = fileName;
+#if VTK_FOAMFILE_USE_INOTIFY
+    if ((this->Fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) < 0)
+      {
+      this->Fd = -1;
+      return false;
+      }
+    for (int parentI = 0; parentI < parents->GetNumberOfValues(); parentI++)
+      {
+      const vtkStdString &parentPath = parents->GetValue(parentI);
+      const int wd = inotify_add_watch(this->Fd, parentPath.c_str(),
+          IN_CREATE | IN_MOVED_TO | IN_ONLYDIR);
+      if (wd < 0)
+        {
+        // e. g. the limit of the number of watches has been reached
+        close(this->Fd);
+        this->Fd = -1;
+        this->Parents.clear();
+        this->ExpectedFiles.clear();
+        this->Dirs.clear();
+        return false;
+        }
+      vtkFoamWatchedDir &dir = this->Dirs[wd];
+      dir.Parent = parentI;
+      dir.TimeValue = 0.0;
+      dir.Root = wd;
+      this->Parents.push_back(parentPath);
+
+      // the fields of the latest time directory are expected in the
+      // time directories to come
+      vtkDirectory *directory = vtkDirectory::New();
+      vtkStdString latestName;
+      double latestValue = 0.0;
+      if (directory->Open(parentPath.c_str()))
+        {
+        for (int fileI = 0; fileI < directory->GetNumberOfFiles(); fileI++)
+          {
+          const vtkStdString name(directory->GetFile(fileI));
+          double value;
+          if (vtkFoamCaseWatcher::GetTimeValue(name, value)
+              && (latestName == "" || value > latestValue))
+            {
+            latestName = name;
+            latestValue = value;
+            }
+          }
+        }
+      directory->Delete();
+      this->ExpectedFiles.push_back(vtkstd::vector<vtkStdString>());
+      if (latestName != "")
+        {
+        vtkFoamCaseWatcher::ListFiles(parentPath + latestName, "",
+            this->ExpectedFiles.back());
+        }
+      }
+    return true;
+#else
+    (void)parents;
+    return false;
+#endif
+  }
 
-    // excluded extensions cf. src/OpenFOAM/OSspecific/Unix/Unix.C
-    if (!directory->FileIsDirectory(fieldFile.c_str()) && fieldFile.substr(len
-        - 1) != "~" && (len < 4 || (fieldFile.substr(len - 4) != ".bak"
-        && fieldFile.substr(len - 4) != ".BAK" && fieldFile.substr(len - 4)
-        != ".old")) && (len < 5 || fieldFile.substr(len - 5) != ".save"))
+  // process the pending events without blocking and append the
+  // names of the newly completed timesteps to completed
+  void Poll(vtkStringArray *completed)
+  {
+#if VTK_FOAMFILE_USE_INOTIFY
+    if (this->Fd < 0)
       {
-      vtkFoamIOobject io(this->CasePath,
-          this->Parent->GetIsSinglePrecisionBinary() != 0);
-      if (io.Open(tempPath + "/" + fieldFile)) // file exists and readable
+      return;
+      }
+    // aligned for struct inotify_event
+    long buf[4096 / sizeof(long)];
+    ssize_t len;
+    while ((len = read(this->Fd, buf, sizeof(buf))) > 0)
+      {
+      const char *ptr = reinterpret_cast<const char *>(buf);
+      const char *end = ptr + len;
+      while (ptr < end)
         {
-        const vtkStdString& cn = io.GetClassName();
-        if (isLagrangian)
+        const struct inotify_event *event
+            = reinterpret_cast<const struct inotify_event *>(ptr);
+        ptr += sizeof(struct inotify_event) + event->len;
+
+        if (event->mask & IN_Q_OVERFLOW)
           {
-          if (cn == "labelField" || cn == "scalarField" || cn == "vectorField"
-              || cn == "sphericalTensorField" || cn == "symmTensorField" || cn
-              == "tensorField")
+          // events have been lost: no longer wait for the time
+          // directories being written
+          vtkstd::vector<int> wds;
+          for (vtkFoamWatchedDirMap::iterator dirI = this->Dirs.begin();
+              dirI != this->Dirs.end(); ++dirI)
+            {
+            wds.push_back(dirI->first);
+            }
+          for (size_t wdI = 0; wdI < wds.size(); wdI++)
             {
-            // real file name
-            this->LagrangianFieldFiles->InsertNextValue(fieldFile);
-            // object name
-            pointObjectNames->InsertNextValue(io.GetObjectName());
+            this->Complete(wds[wdI], true, completed);
             }
+          continue;
           }
-        else
+
+        vtkFoamWatchedDirMap::iterator dirI = this->Dirs.find(event->wd);
+        if (dirI == this->Dirs.end())
+          {
+          continue;
+          }
+        if (event->mask & IN_IGNORED)
           {
-          if (cn == "volScalarField" || cn == "surfaceScalarField"
-              || cn == "pointScalarField" || cn == "volVectorField"
-              || cn == "surfaceVectorField" || cn == "pointVectorField"
-              || cn == "volSphericalTensorField"
-              || cn == "surfaceSphericalTensorField"
-              || cn == "pointSphericalTensorField"
-              || cn == "volSymmTensorField" || cn == "surfaceSymmTensorField"
-              || cn == "pointSymmTensorField" || cn == "volTensorField"
-              || cn == "surfaceTensorField" || cn == "pointTensorField"
-              || cn == "volScalarField::DimensionedInternalField"
-              || cn == "volVectorField::DimensionedInternalField"
-              || cn == "volSphericalTensorField::DimensionedInternalField"
-              || cn == "volSymmTensorField::DimensionedInternalField"
-              || cn == "volTensorField::DimensionedInternalField")
+          // the directory has been removed, along with its
+          // subdirectories if a time directory
+          const int wd = event->wd;
+          vtkstd::vector<int> wds;
+          for (dirI = this->Dirs.begin(); dirI != this->Dirs.end(); ++dirI)
             {
-            if (cn.substr(0, 3) == "vol")
+            if (dirI->first == wd || (dirI->second.TimeName != ""
+                && dirI->second.Root == wd))
               {
-              // real file name
-              this->VolFieldFiles->InsertNextValue(fieldFile);
-              // object name
-              cellObjectNames->InsertNextValue(io.GetObjectName());
+              wds.push_back(dirI->first);
               }
-            else if (cn.substr(0, 7) == "surface")
+            }
+          for (size_t wdI = 0; wdI < wds.size(); wdI++)
+            {
+            if (wds[wdI] != wd)
               {
-              // real file name
-              this->SurfaceFieldFiles->InsertNextValue(fieldFile);
-              // object name
-              surfaceObjectNames->InsertNextValue(io.GetObjectName());
+              inotify_rm_watch(this->Fd, wds[wdI]);
               }
-            else
+            this->Dirs.erase(wds[wdI]);
+            }
+          continue;
+          }
+        if (event->len == 0)
+          {
+          continue;
+          }
+        const vtkStdString name(event->name);
+
+        if (dirI->second.TimeName == "")
+          {
+          double value;
+          if ((event->mask & IN_ISDIR)
+              && vtkFoamCaseWatcher::GetTimeValue(name, value))
+            {
+            this->AddTimeDirectory(dirI->second.Parent, name, value,
+                completed);
+            }
+          }
+        else if (event->mask & IN_ISDIR)
+          {
+          if (event->mask & (IN_CREATE | IN_MOVED_TO))
+            {
+            const int rootWd = dirI->second.Root;
+            if (this->Dirs.find(rootWd) != this->Dirs.end())
               {
-              this->PointFieldFiles->InsertNextValue(fieldFile);
-              pointObjectNames->InsertNextValue(io.GetObjectName());
+              this->AddSubDirectory(rootWd,
+                  dirI->second.SubPath + name + "/");
+              this->Complete(rootWd, false, completed);
               }
             }
           }
-        io.Close();
-        }
-      }
-    }
-  // inserted objects are squeezed later in SortFieldFiles()
-  directory->Delete();
-}
-
-//-----------------------------------------------------------------------------
-// locate laglangian clouds
-void vtkOFFReaderPrivate::LocateLagrangianClouds(
-    vtkStringArray *lagrangianObjectNames, const vtkStdString &timePath)
-{
-  vtkDirectory *directory = vtkDirectory::New();
-  if (directory->Open((timePath + this->RegionPath() + "/lagrangian").c_str()))
-    {
-    // search for sub-clouds (OF 1.5 format)
-    const int nFiles = directory->GetNumberOfFiles();
-    bool isSubCloud = false;
-    for (int fileI = 0; fileI < nFiles; fileI++)
-      {
-      const vtkStdString fileNameI(directory->GetFile(fileI));
-      if (fileNameI != "." && fileNameI != ".."
-          && directory->FileIsDirectory(fileNameI.c_str()))
-        {
-        vtkFoamIOobject io(this->CasePath,
-            this->Parent->GetIsSinglePrecisionBinary() != 0);
-        const vtkStdString subCloudName(this->RegionPrefix() + "lagrangian/"
-            + fileNameI);
-        const vtkStdString subCloudFullPath(timePath + "/" + subCloudName);
-        // lagrangian positions. there are many concrete class names
-        // e. g. Cloud<parcel>, basicKinematicCloud etc.
-        if ((io.Open(subCloudFullPath + "/positions")
-            || io.Open(subCloudFullPath + "/positions.gz")) && io.GetClassName().find("Cloud") != vtkStdString::npos && io.GetObjectName()
-            == "positions")
-          {
-          isSubCloud = true;
-          // a lagrangianPath has to be in a bit different format from
-          // subCloudName to make the "lagrangian" reserved path
-          // component and a mesh region with the same name
-          // distinguishable later
-          const vtkStdString subCloudPath(this->RegionName + "/lagrangian/"
-              + fileNameI);
-          if (this->Parent->LagrangianPaths->LookupValue(subCloudPath) == -1)
+        else if (!vtkFoamCaseIndex::IsBackupFile(name))
+          {
+          const int rootWd = dirI->second.Root;
+          const vtkStdString filePath(dirI->second.SubPath + name);
+          vtkFoamWatchedDirMap::iterator rootI = this->Dirs.find(rootWd);
+          if (rootI != this->Dirs.end())
             {
-            this->Parent->LagrangianPaths->InsertNextValue(subCloudPath);
+            rootI->second.Files[filePath]
+                = (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0;
+            this->Complete(rootWd, false, completed);
             }
-          this->GetFieldNames(subCloudFullPath, true, NULL, NULL,
-              lagrangianObjectNames);
-          this->Parent->PatchDataArraySelection->AddArray(subCloudName.c_str());
           }
         }
       }
-    // if there's no sub-cloud then OF < 1.5 format
-    if (!isSubCloud)
+#else
+    (void)completed;
+#endif
+  }
+
+private:
+#if VTK_FOAMFILE_USE_INOTIFY
+  void AddTimeDirectory(const int parentI, const vtkStdString &timeName,
+      const double timeValue, vtkStringArray *completed)
+  {
+    // the solver has moved on from the earlier time directories
+    vtkstd::vector<int> wds;
+    for (vtkFoamWatchedDirMap::iterator dirI = this->Dirs.begin();
+        dirI != this->Dirs.end(); ++dirI)
       {
-      vtkFoamIOobject io(this->CasePath,
-          this->Parent->GetIsSinglePrecisionBinary() != 0);
-      const vtkStdString cloudName(this->RegionPrefix() + "lagrangian");
-      const vtkStdString cloudFullPath(timePath + "/" + cloudName);
-      if ((io.Open(cloudFullPath + "/positions") || io.Open(cloudFullPath
-          + "/positions.gz")) && io.GetClassName().find("Cloud") != vtkStdString::npos && io.GetObjectName()
-          == "positions")
+      if (dirI->second.Parent == parentI && dirI->second.TimeName != ""
+          && dirI->second.Root == dirI->first
+          && dirI->second.TimeValue < timeValue)
         {
-        const vtkStdString cloudPath(this->RegionName + "/lagrangian");
-        if (this->Parent->LagrangianPaths->LookupValue(cloudPath) == -1)
-          {
-          this->Parent->LagrangianPaths->InsertNextValue(cloudPath);
-          }
-        this->GetFieldNames(cloudFullPath, true, NULL, NULL,
-            lagrangianObjectNames);
-        this->Parent->PatchDataArraySelection->AddArray(cloudName.c_str());
+        wds.push_back(dirI->first);
         }
       }
-    this->Parent->LagrangianPaths->Squeeze();
-    }
-  directory->Delete();
-}
+    for (size_t wdI = 0; wdI < wds.size(); wdI++)
+      {
+      this->Complete(wds[wdI], true, completed);
+      }
 
-//-----------------------------------------------------------------------------
-void vtkOFFReaderPrivate::SortFieldFiles(vtkStringArray *selections,
-    vtkStringArray *files, vtkStringArray *objects)
-{
-  objects->Squeeze();
-  files->Squeeze();
-  vtkSortDataArray::Sort(objects, files);
-  for (int nameI = 0; nameI < objects->GetNumberOfValues(); nameI++)
-    {
-    selections->InsertNextValue(objects->GetValue(nameI));
-    }
-  objects->Delete();
-}
+    const vtkStdString dirPath(this->Parents[parentI] + timeName);
+    const int wd = inotify_add_watch(this->Fd, dirPath.c_str(),
+        IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR);
+    if (wd < 0)
+      {
+      return;
+      }
+    vtkFoamWatchedDir &dir = this->Dirs[wd];
+    dir.Parent = parentI;
+    dir.TimeName = timeName;
+    dir.TimeValue = timeValue;
+    dir.Root = wd;
 
-//-----------------------------------------------------------------------------
-// create field data lists and cell/point array selection lists
-int vtkOFFReaderPrivate::MakeMetaDataAtTimeStep(
-    vtkStringArray *cellSelectionNames, vtkStringArray *surfaceSelectionNames,
-    vtkStringArray *pointSelectionNames,
-    vtkStringArray *lagrangianSelectionNames, const bool listNextTimeStep)
-{
-  // Read the patches from the boundary file into selection array
-  if (this->PolyMeshFacesDir->GetValue(this->TimeStep)
-      != this->BoundaryDict.TimeDir
-      || this->Parent->PatchDataArraySelection->GetMTime()
-          != this->Parent->PatchSelectionMTimeOld)
-    {
-    this->BoundaryDict.clear();
-    this->BoundaryDict.TimeDir
-        = this->PolyMeshFacesDir->GetValue(this->TimeStep);
-    this->BoundaryDict.UpperProcRanges.clear();
-    this->BoundaryDict.LowestUpperProcFaceNo = VTK_INT_MAX;
-    this->BoundaryDict.ProcBoundaries.clear();
+    this->AddSubDirectory(wd, "");
+    this->Complete(wd, false, completed);
+  }
 
-    vtkFoamDict *boundaryDict = this->GatherBlocks("boundary", this->TimeStep);
-    if (boundaryDict == NULL && listNextTimeStep
-        && this->TimeValues->GetNumberOfTuples() >= 2 && this->TimeStep == 0)
+  // watch a subdirectory of the time directory watched by rootWd, or
+  // only list the files of the time directory itself if subPath is
+  // empty. The files and the subdirectories created before the watches
+  // have been added are taken as complete, and are marked as
+  // incomplete again if they are written further.
+  void AddSubDirectory(const int rootWd, const vtkStdString &subPath)
+  {
+    const int parentI = this->Dirs[rootWd].Parent;
+    const vtkStdString timeName(this->Dirs[rootWd].TimeName);
+    const double timeValue = this->Dirs[rootWd].TimeValue;
+    const vtkStdString timePath(this->Parents[parentI] + timeName + "/");
+    vtkstd::vector<vtkStdString> files, subDirs;
+    if (subPath != "")
       {
-      this->BoundaryDict.TimeDir
-          = this->PolyMeshFacesDir->GetValue(1);
-      boundaryDict = this->GatherBlocks("boundary", 1);
+      subDirs.push_back(subPath);
       }
-    if (boundaryDict != NULL)
+    vtkFoamCaseWatcher::ListFiles(timePath + subPath, subPath, files,
+        &subDirs);
+
+    for (size_t subDirI = 0; subDirI < subDirs.size(); subDirI++)
       {
-      // Add the internal mesh by default always
-      const vtkStdString internalMeshName(this->RegionPrefix()
-          + vtkOFFReaderPrivate::InternalMeshIdentifier);
-      if (this->RegionName == ""
-          && this->Parent->Readers->GetNumberOfItems() > 1
-          && !this->Parent->PatchDataArraySelection
-          ->ArrayExists(internalMeshName.c_str()))
+      const int wd = inotify_add_watch(this->Fd,
+          (timePath + subDirs[subDirI]).c_str(),
+          IN_CREATE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_ONLYDIR);
+      // a directory already watched keeps its entry
+      if (wd >= 0 && this->Dirs.find(wd) == this->Dirs.end())
         {
-        this->Parent->PatchDataArraySelection->DisableArray(
-            internalMeshName.c_str());
+        vtkFoamWatchedDir &dir = this->Dirs[wd];
+        dir.Parent = parentI;
+        dir.TimeName = timeName;
+        dir.TimeValue = timeValue;
+        dir.Root = rootWd;
+        dir.SubPath = subDirs[subDirI];
         }
-      else
+      }
+
+    vtksys::hash_map<vtkstd::string, bool> &rootFiles
+        = this->Dirs[rootWd].Files;
+    for (size_t fileI = 0; fileI < files.size(); fileI++)
+      {
+      if (rootFiles.find(files[fileI]) == rootFiles.end())
         {
-        this->Parent->PatchDataArraySelection
-            ->AddArray(internalMeshName.c_str());
+        rootFiles[files[fileI]] = true;
         }
-      this->InternalMeshSelectionStatus
-          = this->Parent->GetPatchArrayStatus(internalMeshName.c_str());
+      }
+  }
 
-      // Add the surface mesh by default always
-      const vtkStdString surfaceMeshName(this->RegionPrefix()
-          + vtkOFFReaderPrivate::SurfaceMeshIdentifier);
-      if (!this->Parent->PatchDataArraySelection
-          ->ArrayExists(surfaceMeshName.c_str()))
+  // stop watching a time directory and its subdirectories if it is
+  // complete or if force is set. wd may be that of a subdirectory.
+  void Complete(int wd, const bool force, vtkStringArray *completed)
+  {
+    vtkFoamWatchedDirMap::iterator dirI = this->Dirs.find(wd);
+    if (dirI == this->Dirs.end() || dirI->second.TimeName == "")
+      {
+      return;
+      }
+    if (dirI->second.Root != wd)
+      {
+      wd = dirI->second.Root;
+      if ((dirI = this->Dirs.find(wd)) == this->Dirs.end())
         {
-        this->Parent->PatchDataArraySelection
-            ->DisableArray(surfaceMeshName.c_str());
+        return;
         }
-      this->SurfaceMeshSelectionStatus
-          = this->Parent->GetPatchArrayStatus(surfaceMeshName.c_str());
-
-      if (this->Parent->OutputProcessorPatches
-          == vtkOFFReader::PROCESSOR_PATCHES_AGGREGATE)
+      }
+    vtkFoamWatchedDir &dir = dirI->second;
+    if (!force)
+      {
+      if (dir.Files.empty())
         {
-        const vtkStdString selectionName(this->RegionPrefix()
-            + vtkOFFReaderPrivate::ProcessorPatchesIdentifier);
-        if (!this->Parent->PatchDataArraySelection->ArrayExists(
-            selectionName.c_str()))
+        return;
+        }
+      for (vtksys::hash_map<vtkstd::string, bool>::const_iterator fileI
+          = dir.Files.begin(); fileI != dir.Files.end(); ++fileI)
+        {
+        if (!fileI->second)
           {
-          this->Parent->PatchDataArraySelection->DisableArray(
-              selectionName.c_str());
+          return;
           }
         }
-
-      // when in decommposed case (appended) mode, memorize processor
-      // boundaries for quick lookup afterwards as processor boundary
-      // faces has to be included in surface mesh appropriately
-      const bool doProcBoundaries = this->SurfaceMeshSelectionStatus &&
-          this->ProcessorName != "" && this->Parent->OutputProcessorPatches
-          == vtkOFFReader::PROCESSOR_PATCHES_OFF;
-
-      // iterate through each entry in the boundary file
-      int allBoundariesNextStartFace = 0;
-      this->BoundaryDict.resize(boundaryDict->size());
-      for (size_t i = 0; i < boundaryDict->size(); i++)
+      const vtkstd::vector<vtkStdString> &expected
+          = this->ExpectedFiles[dir.Parent];
+      for (size_t fileI = 0; fileI < expected.size(); fileI++)
         {
-        vtkFoamEntry *boundaryEntryI = boundaryDict->operator[](i);
-        const vtkFoamEntry *nFacesEntry = boundaryEntryI->Dictionary().Lookup("nFaces");
-        if (nFacesEntry == NULL)
+        if (dir.Files.find(expected[fileI]) == dir.Files.end())
           {
-          vtkErrorMacro(<< "nFaces entry not found in boundary entry "
-              << boundaryEntryI->GetKeyword().c_str());
-          this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-          delete boundaryDict;
-          return 0;
+          return;
           }
-        const int nFaces = nFacesEntry->ToInt();
+        }
 
-        // extract name of the current patch for insertion
-        const vtkStdString &boundaryNameI = boundaryEntryI->GetKeyword();
+      vtkstd::vector<vtkStdString> &files = this->ExpectedFiles[dir.Parent];
+      files.clear();
+      for (vtksys::hash_map<vtkstd::string, bool>::const_iterator fileI
+          = dir.Files.begin(); fileI != dir.Files.end(); ++fileI)
+        {
+        files.push_back(fileI->first);
+        }
+      vtkstd::sort(files.begin(), files.end());
+      }
 
-        // create BoundaryDict entry
-        vtkFoamBoundaryEntry &BoundaryEntryI = this->BoundaryDict[i];
-        BoundaryEntryI.NFaces = nFaces;
-        BoundaryEntryI.BoundaryName = boundaryNameI;
-        const vtkFoamEntry *startFaceEntry = boundaryEntryI->Dictionary().Lookup("startFace");
-        if (startFaceEntry == NULL)
-          {
-          vtkErrorMacro(<< "startFace entry not found in boundary entry "
-              << boundaryNameI.c_str());
-          this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-          delete boundaryDict;
-          return 0;
-          }
-        BoundaryEntryI.StartFace = startFaceEntry->ToInt();
-        const vtkFoamEntry *typeEntry = boundaryEntryI->Dictionary().Lookup("type");
-        if (typeEntry == NULL)
-          {
-          vtkErrorMacro(<< "type entry not found in boundary entry "
-              << boundaryNameI.c_str());
-          this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-          delete boundaryDict;
-          return 0;
-          }
-        BoundaryEntryI.AllBoundariesStartFace = allBoundariesNextStartFace;
-        const vtkStdString typeNameI(typeEntry->ToWord());
-        // if the basic type of the patch is one of the followings the
-        // point-filtered values at patches are overridden by patch values
-        if (typeNameI == "patch" || typeNameI == "wall" || typeNameI == "ggi"
-            || typeNameI == "cyclicGgi" || typeNameI == "overlapGgi")
-          {
-          BoundaryEntryI.BoundaryType = vtkFoamBoundaryEntry::PHYSICAL;
-          allBoundariesNextStartFace += nFaces;
-          }
-        else if (typeNameI == "processor")
-          {
-          BoundaryEntryI.BoundaryType = vtkFoamBoundaryEntry::PROCESSOR;
-          allBoundariesNextStartFace += nFaces;
+    const vtkStdString timeName(dir.TimeName);
+    vtkstd::vector<int> wds;
+    for (vtkFoamWatchedDirMap::iterator subDirI = this->Dirs.begin();
+        subDirI != this->Dirs.end(); ++subDirI)
+      {
+      if (subDirI->second.TimeName != "" && subDirI->second.Root == wd)
+        {
+        wds.push_back(subDirI->first);
+        }
+      }
+    for (size_t wdI = 0; wdI < wds.size(); wdI++)
+      {
+      inotify_rm_watch(this->Fd, wds[wdI]);
+      this->Dirs.erase(wds[wdI]);
+      }
+    if (++this->NCompleted[timeName] == static_cast<int>(this->Parents.size()))
+      {
+      this->NCompleted.erase(timeName);
+      completed->InsertNextValue(timeName);
+      }
+  }
+#endif
+};
 
-          const vtkFoamEntry *procNoEntry
-              = boundaryEntryI->Dictionary().Lookup("myProcNo");
-          if (!procNoEntry)
-            {
-            vtkErrorMacro(<< "myProcNo entry not found in boundary entry "
-                << boundaryNameI.c_str());
-            this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-            delete boundaryDict;
-            return 0;
-            }
-          BoundaryEntryI.MyProcNo = procNoEntry->ToInt();
-          procNoEntry = boundaryEntryI->Dictionary().Lookup("neighbProcNo");
-          if (!procNoEntry)
-            {
-            vtkErrorMacro(<< "neighbProcNo entry not found in boundary entry "
-                << boundaryEntryI->GetKeyword().c_str());
-            this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-            delete boundaryDict;
-            return 0;
-            }
-          BoundaryEntryI.NeighbProcNo = procNoEntry->ToInt();
+//-----------------------------------------------------------------------------
+// vtkOFFReaderPrivate static members
+const char *vtkOFFReaderPrivate::InternalMeshIdentifier
+    = "[InternalMesh]";
+const char *vtkOFFReaderPrivate::SurfaceMeshIdentifier
+    = "[InternalSurfaceMesh]";
+const char *vtkOFFReaderPrivate::ProcessorPatchesIdentifier
+    = "[ProcessorPatches]";
 
-          if (BoundaryEntryI.MyProcNo > BoundaryEntryI.NeighbProcNo)
-            {
-            if (BoundaryEntryI.StartFace
-                < this->BoundaryDict.LowestUpperProcFaceNo)
-              {
-              this->BoundaryDict.LowestUpperProcFaceNo
-                  = BoundaryEntryI.StartFace;
-              }
-            const size_t rangeSize = this->BoundaryDict.UpperProcRanges.size();
-            if (rangeSize > 1
-                && this->BoundaryDict.UpperProcRanges[rangeSize - 1]
-                == BoundaryEntryI.StartFace)
-              {
-              this->BoundaryDict.UpperProcRanges[rangeSize - 1]
-                = BoundaryEntryI.StartFace + nFaces;
-              }
-            else
-              {
-              this->BoundaryDict.UpperProcRanges.push_back(
-                  BoundaryEntryI.StartFace);
-              this->BoundaryDict.UpperProcRanges.push_back(
-                  BoundaryEntryI.StartFace + nFaces);
-              }
-            }
+//-----------------------------------------------------------------------------
+int vtkOFFReaderPrivate::GetBoundaryTypeProcessor()
+{
+  return static_cast<int>(vtkFoamBoundaryEntry::PROCESSOR);
+}
 
-          if (doProcBoundaries)
-            {
-            this->BoundaryDict.ProcBoundaries.push_back(static_cast<int>(i));
-            }
-          }
-        else
-          {
-          BoundaryEntryI.BoundaryType = vtkFoamBoundaryEntry::GEOMETRICAL;
-          }
-        BoundaryEntryI.IsActive = false;
+//-----------------------------------------------------------------------------
+int vtkOFFReaderPrivate::GetBoundaryTypeInternal()
+{
+  return static_cast<int>(vtkFoamBoundaryEntry::INTERNAL);
+}
 
-        // always hide processor patches for decomposed cases (appended) to keep
-        // vtkAppendCompositeDataLeaves happy
-        if (this->Parent->OutputProcessorPatches
-            == vtkOFFReader::PROCESSOR_PATCHES_OFF
-            && BoundaryEntryI.BoundaryType == vtkFoamBoundaryEntry::PROCESSOR)
-          {
-          continue;
-          }
-        const vtkStdString selectionName(this->RegionPrefix()
-            + (BoundaryEntryI.BoundaryType == vtkFoamBoundaryEntry::PROCESSOR
-            && this->Parent->OutputProcessorPatches
-            == vtkOFFReader::PROCESSOR_PATCHES_AGGREGATE
-            ? vtkOFFReaderPrivate::ProcessorPatchesIdentifier
-            : boundaryNameI));
-        if (this->Parent->PatchDataArraySelection->
-            ArrayExists(selectionName.c_str()))
-          {
-          // Mark boundary if selected for display
-          if (this->Parent->GetPatchArrayStatus(selectionName.c_str()))
-            {
-            BoundaryEntryI.IsActive = true;
-            }
-          }
-        else
-          {
-          // add patch to list with selection status turned off:
-          // the patch is added to list even if its size is zero
-          this->Parent->PatchDataArraySelection->DisableArray(selectionName.c_str());
-          }
-        }
+//-----------------------------------------------------------------------------
+// vtkOFFReaderPrivate constructor and destructor
+vtkOFFReaderPrivate::vtkOFFReaderPrivate()
+{
+  // the directory index is owned by vtkOFFReader
+  this->CaseIndex = NULL;
 
-      delete boundaryDict;
-      }
-    }
+  // DATA TIMES
+  this->TimeStep = 0;
+  this->TimeStepOld = -1;
+  this->RereadFields = false;
+  this->TimeValues = vtkDoubleArray::New();
+  this->TimeNames = vtkStringArray::New();
 
-  // Add scalars and vectors to metadata
-  vtkStdString timePath(this->CurrentTimePath());
-  // do not do "RemoveAllArrays()" to accumulate array selections
-  // this->CellDataArraySelection->RemoveAllArrays();
-  this->VolFieldFiles->Initialize();
-  this->SurfaceFieldFiles->Initialize();
-  this->PointFieldFiles->Initialize();
-  vtkStringArray *cellObjectNames = vtkStringArray::New();
-  vtkStringArray *surfaceObjectNames = vtkStringArray::New();
-  vtkStringArray *pointObjectNames = vtkStringArray::New();
-  this->GetFieldNames(timePath + this->RegionPath(), false, cellObjectNames,
-      surfaceObjectNames, pointObjectNames);
+  // selection
+  this->InternalMeshSelectionStatus = 0;
+  this->InternalMeshSelectionStatusOld = 0;
 
-  this->LagrangianFieldFiles->Initialize();
-  if (listNextTimeStep)
-    {
-    this->Parent->LagrangianPaths->Initialize();
-    }
-  vtkStringArray *lagrangianObjectNames = vtkStringArray::New();
-  this->LocateLagrangianClouds(lagrangianObjectNames, timePath);
+  // DATA COUNTS
+  this->NumCells = 0;
+  this->NumPoints = 0;
+  this->NumInternalFaces = 0;
 
-  // if the requested timestep is 0 then we also look at the next
-  // timestep to add extra objects that don't exist at timestep 0 into
-  // selection lists. Note the ObjectNames array will be recreated in
-  // RequestData() so we don't have to worry about duplicated fields.
-  if (listNextTimeStep && this->TimeValues->GetNumberOfTuples() >= 2
-      && this->TimeStep == 0)
-    {
-    const vtkStdString timePath2(this->TimePath(1));
-    this->GetFieldNames(timePath2 + this->RegionPath(), false, cellObjectNames,
-        surfaceObjectNames, pointObjectNames);
-    // if lagrangian clouds were not found at timestep 0
-    if (this->Parent->LagrangianPaths->GetNumberOfTuples() == 0)
-      {
-      this->LocateLagrangianClouds(lagrangianObjectNames, timePath2);
-      }
-    }
+  this->VolFieldFiles = vtkStringArray::New();
+  this->SurfaceFieldFiles = vtkStringArray::New();
+  this->PointFieldFiles = vtkStringArray::New();
+  this->LagrangianFieldFiles = vtkStringArray::New();
+  this->PolyMeshPointsDir = vtkStringArray::New();
+  this->PolyMeshFacesDir = vtkStringArray::New();
 
-  // sort array names
-  this->SortFieldFiles(cellSelectionNames, this->VolFieldFiles, cellObjectNames);
-  this->SortFieldFiles(surfaceSelectionNames, this->SurfaceFieldFiles,
-      surfaceObjectNames);
-  this->SortFieldFiles(pointSelectionNames, this->PointFieldFiles,
-      pointObjectNames);
-  this->SortFieldFiles(lagrangianSelectionNames, this->LagrangianFieldFiles,
-      lagrangianObjectNames);
+  // for creating cell-to-point translated data
+  this->BoundaryPointMap = NULL;
+  this->AllBoundariesPointFaces = NULL;
+  this->NumAllBoundariesFaces = 0;
+  this->PointCells = NULL;
 
-  return 1;
+  // for caching mesh
+  this->InternalMesh = NULL;
+  this->SurfaceMesh = NULL;
+  this->BoundaryMesh = NULL;
+  this->BoundaryPointMap = NULL;
+#if 0
+  this->ReciprocalDelta = NULL;
+#endif
+  this->FaceOwner = NULL;
+  this->ProcessorFaces = NULL;
+  this->BoundaryOwnerCells = NULL;
+  this->LagrangianMesh = NULL;
+  this->PointZoneMesh = NULL;
+  this->FaceZoneMesh = NULL;
+  this->CellZoneMesh = NULL;
+
+  // for decomposing polyhedra
+  this->NumAdditionalCells = 0;
+  this->AdditionalCellIds = NULL;
+  this->NumAdditionalCells = NULL;
+  this->AdditionalCellPoints = NULL;
 }
 
 //-----------------------------------------------------------------------------
-// list time directories according to controlDict
-bool vtkOFFReaderPrivate::ListTimeDirectoriesByControlDict(
-    vtkFoamDict* dictPtr)
+vtkOFFReaderPrivate::~vtkOFFReaderPrivate()
 {
-  vtkFoamDict& dict = *dictPtr;
+  this->TimeValues->Delete();
+  this->TimeNames->Delete();
 
-  const vtkFoamEntry *startTimeEntry = dict.Lookup("startTime");
-  if (startTimeEntry == NULL)
+  this->VolFieldFiles->Delete();
+  this->SurfaceFieldFiles->Delete();
+  this->PointFieldFiles->Delete();
+  this->LagrangianFieldFiles->Delete();
+  this->PolyMeshPointsDir->Delete();
+  this->PolyMeshFacesDir->Delete();
+
+  this->ClearMeshes();
+}
+
+//-----------------------------------------------------------------------------
+void vtkOFFReaderPrivate::PrintSelf(ostream &os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Case Path: "
+      << (this->CasePath.length() ? this->CasePath.c_str() : "(none)") << endl;
+  os << indent << "Region Name: "
+      << (this->RegionName.length() ? this->RegionName.c_str() : "(none)")
+      << endl;
+  os << indent << "Processor Name: "
+      << (this->ProcessorName.length() ? this->ProcessorName.c_str() : "(none)")
+      << endl;
+  if (this->TimeValues)
     {
-    vtkErrorMacro(<< "startTime entry not found in controlDict");
-    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-    return false;
+    os << indent << "Number of Time Steps: "
+        << this->TimeValues->GetNumberOfTuples() << endl;
     }
-  // using double to precisely handle time values
-  const double startTime = startTimeEntry->ToDouble();
+  os << indent << "Time Step: " << this->TimeStep << endl;
+  os << indent << "Number of Cells: " << this->NumCells << endl;
+  os << indent << "Number of Points: " << this->NumPoints << endl;
+}
 
-  const vtkFoamEntry *endTimeEntry = dict.Lookup("endTime");
-  if (endTimeEntry == NULL)
+//-----------------------------------------------------------------------------
+void vtkOFFReaderPrivate::ClearInternalMeshes()
+{
+  if (this->FaceOwner != NULL)
     {
-    vtkErrorMacro(<< "endTime entry not found in controlDict");
-    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-    return false;
+    this->FaceOwner->Delete();
+    this->FaceOwner = NULL;
     }
-  const double endTime = endTimeEntry->ToDouble();
+  delete this->ProcessorFaces;
+  this->ProcessorFaces = NULL;
+  if (this->BoundaryOwnerCells != NULL)
+    {
+    this->BoundaryOwnerCells->Delete();
+    this->BoundaryOwnerCells = NULL;
+    }
+  if (this->InternalMesh != NULL)
+    {
+    this->InternalMesh->Delete();
+    this->InternalMesh = NULL;
+    }
+  if (this->SurfaceMesh != NULL)
+    {
+    this->SurfaceMesh->Delete();
+    this->SurfaceMesh = NULL;
+    }
+  if (this->AdditionalCellIds != NULL)
+    {
+    this->AdditionalCellIds->Delete();
+    this->AdditionalCellIds = NULL;
+    }
+  if (this->NumAdditionalCells != NULL)
+    {
+    this->NumAdditionalCells->Delete();
+    this->NumAdditionalCells = NULL;
+    }
+  delete this->AdditionalCellPoints;
+  this->AdditionalCellPoints = NULL;
+  delete this->PointCells;
+  this->PointCells = NULL;
 
-  const vtkFoamEntry *deltaTEntry = dict.Lookup("deltaT");
-  if (deltaTEntry == NULL)
+  this->ClearZoneMeshes();
+}
+
+//-----------------------------------------------------------------------------
+void vtkOFFReaderPrivate::ClearZoneMeshes()
+{
+  if (this->PointZoneMesh != NULL)
     {
-    vtkErrorMacro(<< "deltaT entry not found in controlDict");
-    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-    return false;
+    this->PointZoneMesh->Delete();
+    this->PointZoneMesh = NULL;
     }
-  const double deltaT = deltaTEntry->ToDouble();
+  if (this->FaceZoneMesh != NULL)
+    {
+    this->FaceZoneMesh->Delete();
+    this->FaceZoneMesh = NULL;
+    }
+  if (this->CellZoneMesh != NULL)
+    {
+    this->CellZoneMesh->Delete();
+    this->CellZoneMesh = NULL;
+    }
+}
 
-  const vtkFoamEntry *writeIntervalEntry = dict.Lookup("writeInterval");
-  if (writeIntervalEntry == NULL)
+//-----------------------------------------------------------------------------
+void vtkOFFReaderPrivate::ClearBoundaryMeshes()
+{
+  if (this->BoundaryMesh != NULL)
     {
-    vtkErrorMacro(<< "writeInterval entry not found in controlDict");
-    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-    return false;
+    this->BoundaryMesh->Delete();
+    this->BoundaryMesh = NULL;
     }
-  const double writeInterval = writeIntervalEntry->ToDouble();
 
-  const vtkFoamEntry *timeFormatEntry = dict.Lookup("timeFormat");
-  if (timeFormatEntry == NULL)
+  delete this->BoundaryPointMap;
+  this->BoundaryPointMap = NULL;
+#if 0
+  delete this->ReciprocalDelta;
+  this->ReciprocalDelta = NULL;
+#endif
+
+  delete this->AllBoundariesPointFaces;
+  this->AllBoundariesPointFaces = NULL;
+  this->NumAllBoundariesFaces = 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkOFFReaderPrivate::ClearLagrangianMeshes()
+{
+  if (this->LagrangianMesh)
     {
-    vtkErrorMacro(<< "timeFormat entry not found in controlDict");
-    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-    return false;
+    this->LagrangianMesh->Delete();
+    this->LagrangianMesh = 0;
     }
-  const vtkStdString timeFormat(timeFormatEntry->ToWord());
+}
+
+//-----------------------------------------------------------------------------
+void vtkOFFReaderPrivate::ClearMeshes()
+{
+  this->ClearInternalMeshes();
+  this->ClearBoundaryMeshes();
+  this->ClearLagrangianMeshes();
+}
+
+//-----------------------------------------------------------------------------
+void vtkOFFReaderPrivate::SetTimeValue(const double requestedTime)
+{
+  const int nTimeValues = this->TimeValues->GetNumberOfTuples();
+  if (nTimeValues > 0)
+    {
+    int minTimeI = 0;
+    double minTimeDiff = fabs(this->TimeValues->GetValue(0) - requestedTime);
+    for (int timeI = 1; timeI < nTimeValues; timeI++)
+      {
+      const double timeDiff(fabs(this->TimeValues->GetValue(timeI)
+          - requestedTime));
+      if (timeDiff < minTimeDiff)
+        {
+        minTimeI = timeI;
+        minTimeDiff = timeDiff;
+        }
+      }
+    this->SetTimeStep(minTimeI); // set Modified() if TimeStep changed
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkOFFReaderPrivate::SetupInformation(const vtkStdString &casePath,
+    const vtkStdString &regionName, const vtkStdString &procName,
+    vtkOFFReaderPrivate *master)
+{
+  // copy parent, path and timestep information from master
+  this->CasePath = casePath;
+  this->RegionName = regionName;
+  this->ProcessorName = procName;
+  this->Parent = master->Parent;
+  this->CaseIndex = master->CaseIndex;
+  this->TimeValues->Delete();
+  this->TimeValues = master->TimeValues;
+  this->TimeValues->Register(0);
+  this->TimeNames->Delete();
+  this->TimeNames = master->TimeNames;
+  this->TimeNames->Register(0);
+
+  this->PopulatePolyMeshDirArrays(NULL);
+}
+
+//-----------------------------------------------------------------------------
+void vtkOFFReaderPrivate::GetFieldNames(const vtkStdString &tempPath,
+    const bool isLagrangian, vtkStringArray *cellObjectNames,
+    vtkStringArray *surfaceObjectNames, vtkStringArray *pointObjectNames)
+{
+  // get the headers of the files in the directory
+  const vtkFoamCaseIndex::vtkFoamDirEntry *directory
+      = this->CaseIndex->Lookup(tempPath, true,
+      this->Parent->GetIsSinglePrecisionBinary() != 0);
+  if (directory == NULL)
+    {
+    // no data
+    return;
+    }
+
+  // loop over all files and locate valid fields
+  const size_t nFieldFiles = directory->Headers.size();
+  for (size_t j = 0; j < nFieldFiles; j++)
+    {
+    const vtkFoamCaseIndex::vtkFoamFileHeader &header = directory->Headers[j];
+    const vtkStdString &fieldFile = header.FileName;
+    const vtkStdString &cn = header.ClassName;
+    if (isLagrangian)
+      {
+      if (cn == "labelField" || cn == "scalarField" || cn == "vectorField"
+          || cn == "sphericalTensorField" || cn == "symmTensorField" || cn
+          == "tensorField")
+        {
+        // real file name
+        this->LagrangianFieldFiles->InsertNextValue(fieldFile);
+        // object name
+        pointObjectNames->InsertNextValue(header.ObjectName);
+        }
+      }
+    else
+      {
+      if (cn == "volScalarField" || cn == "surfaceScalarField"
+          || cn == "pointScalarField" || cn == "volVectorField"
+          || cn == "surfaceVectorField" || cn == "pointVectorField"
+          || cn == "volSphericalTensorField"
+          || cn == "surfaceSphericalTensorField"
+          || cn == "pointSphericalTensorField"
+          || cn == "volSymmTensorField" || cn == "surfaceSymmTensorField"
+          || cn == "pointSymmTensorField" || cn == "volTensorField"
+          || cn == "surfaceTensorField" || cn == "pointTensorField"
+          || cn == "volScalarField::DimensionedInternalField"
+          || cn == "volVectorField::DimensionedInternalField"
+          || cn == "volSphericalTensorField::DimensionedInternalField"
+          || cn == "volSymmTensorField::DimensionedInternalField"
+          || cn == "volTensorField::DimensionedInternalField")
+        {
+        if (cn.substr(0, 3) == "vol")
+          {
+          // real file name
+          this->VolFieldFiles->InsertNextValue(fieldFile);
+          // object name
+          cellObjectNames->InsertNextValue(header.ObjectName);
+          }
+        else if (cn.substr(0, 7) == "surface")
+          {
+          // real file name
+          this->SurfaceFieldFiles->InsertNextValue(fieldFile);
+          // object name
+          surfaceObjectNames->InsertNextValue(header.ObjectName);
+          }
+        else
+          {
+          this->PointFieldFiles->InsertNextValue(fieldFile);
+          pointObjectNames->InsertNextValue(header.ObjectName);
+          }
+        }
+      }
+    }
+  // inserted objects are squeezed later in SortFieldFiles()
+}
+
+//-----------------------------------------------------------------------------
+// locate laglangian clouds
+void vtkOFFReaderPrivate::LocateLagrangianClouds(
+    vtkStringArray *lagrangianObjectNames, const vtkStdString &timePath)
+{
+  const vtkFoamCaseIndex::vtkFoamDirEntry *directory
+      = this->CaseIndex->Lookup(timePath + this->RegionPath() + "/lagrangian",
+      false, this->Parent->GetIsSinglePrecisionBinary() != 0);
+  if (directory != NULL)
+    {
+    // search for sub-clouds (OF 1.5 format)
+    const size_t nSubDirs = directory->SubDirs.size();
+    bool isSubCloud = false;
+    for (size_t dirI = 0; dirI < nSubDirs; dirI++)
+      {
+      const vtkStdString &fileNameI = directory->SubDirs[dirI];
+      const vtkStdString subCloudName(this->RegionPrefix() + "lagrangian/"
+          + fileNameI);
+      const vtkStdString subCloudFullPath(timePath + "/" + subCloudName);
+      if (this->IsCloudDirectory(subCloudFullPath))
+        {
+        isSubCloud = true;
+        // a lagrangianPath has to be in a bit different format from
+        // subCloudName to make the "lagrangian" reserved path
+        // component and a mesh region with the same name
+        // distinguishable later
+        const vtkStdString subCloudPath(this->RegionName + "/lagrangian/"
+            + fileNameI);
+        if (this->Parent->LagrangianPaths->LookupValue(subCloudPath) == -1)
+          {
+          this->Parent->LagrangianPaths->InsertNextValue(subCloudPath);
+          }
+        this->GetFieldNames(subCloudFullPath, true, NULL, NULL,
+            lagrangianObjectNames);
+        this->Parent->PatchDataArraySelection->AddArray(subCloudName.c_str());
+        }
+      }
+    // if there's no sub-cloud then OF < 1.5 format
+    if (!isSubCloud)
+      {
+      const vtkStdString cloudName(this->RegionPrefix() + "lagrangian");
+      const vtkStdString cloudFullPath(timePath + "/" + cloudName);
+      if (this->IsCloudDirectory(cloudFullPath))
+        {
+        const vtkStdString cloudPath(this->RegionName + "/lagrangian");
+        if (this->Parent->LagrangianPaths->LookupValue(cloudPath) == -1)
+          {
+          this->Parent->LagrangianPaths->InsertNextValue(cloudPath);
+          }
+        this->GetFieldNames(cloudFullPath, true, NULL, NULL,
+            lagrangianObjectNames);
+        this->Parent->PatchDataArraySelection->AddArray(cloudName.c_str());
+        }
+      }
+    this->Parent->LagrangianPaths->Squeeze();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// whether a directory holds lagrangian positions
+bool vtkOFFReaderPrivate::IsCloudDirectory(const vtkStdString &cloudPath)
+{
+  const vtkFoamCaseIndex::vtkFoamFileHeader *header
+      = this->CaseIndex->LookupHeader(cloudPath, "positions",
+      this->Parent->GetIsSinglePrecisionBinary() != 0);
+  // there are many concrete class names e. g. Cloud<parcel>,
+  // basicKinematicCloud etc.
+  return header != NULL
+      && header->ClassName.find("Cloud") != vtkStdString::npos
+      && header->ObjectName == "positions";
+}
+
+//-----------------------------------------------------------------------------
+void vtkOFFReaderPrivate::SortFieldFiles(vtkStringArray *selections,
+    vtkStringArray *files, vtkStringArray *objects)
+{
+  objects->Squeeze();
+  files->Squeeze();
+  vtkSortDataArray::Sort(objects, files);
+  for (int nameI = 0; nameI < objects->GetNumberOfValues(); nameI++)
+    {
+    selections->InsertNextValue(objects->GetValue(nameI));
+    }
+  objects->Delete();
+}
+
+//-----------------------------------------------------------------------------
+// create field data lists and cell/point array selection lists
+int vtkOFFReaderPrivate::MakeMetaDataAtTimeStep(
+    vtkStringArray *cellSelectionNames, vtkStringArray *surfaceSelectionNames,
+    vtkStringArray *pointSelectionNames,
+    vtkStringArray *lagrangianSelectionNames, const bool listNextTimeStep)
+{
+  vtkFoamMaxThreadsScope maxThreads(this->Parent->GetNumberOfThreads());
+
+  // Read the patches from the boundary file into selection array
+  if (this->PolyMeshFacesDir->GetValue(this->TimeStep)
+      != this->BoundaryDict.TimeDir
+      || this->Parent->PatchDataArraySelection->GetMTime()
+          != this->Parent->PatchSelectionMTimeOld)
+    {
+    this->BoundaryDict.clear();
+    this->BoundaryDict.TimeDir
+        = this->PolyMeshFacesDir->GetValue(this->TimeStep);
+    this->BoundaryDict.UpperProcRanges.clear();
+    this->BoundaryDict.LowestUpperProcFaceNo = VTK_ID_MAX;
+    this->BoundaryDict.ProcBoundaries.clear();
+
+    vtkFoamDict *boundaryDict = this->GatherBlocks("boundary", this->TimeStep);
+    if (boundaryDict == NULL && listNextTimeStep
+        && this->TimeValues->GetNumberOfTuples() >= 2 && this->TimeStep == 0)
+      {
+      this->BoundaryDict.TimeDir
+          = this->PolyMeshFacesDir->GetValue(1);
+      boundaryDict = this->GatherBlocks("boundary", 1);
+      }
+    if (boundaryDict != NULL)
+      {
+      // Add the internal mesh by default always
+      const vtkStdString internalMeshName(this->RegionPrefix()
+          + vtkOFFReaderPrivate::InternalMeshIdentifier);
+      if (this->RegionName == ""
+          && this->Parent->Readers->GetNumberOfItems() > 1
+          && !this->Parent->PatchDataArraySelection
+          ->ArrayExists(internalMeshName.c_str()))
+        {
+        this->Parent->PatchDataArraySelection->DisableArray(
+            internalMeshName.c_str());
+        }
+      else
+        {
+        this->Parent->PatchDataArraySelection
+            ->AddArray(internalMeshName.c_str());
+        }
+      this->InternalMeshSelectionStatus
+          = this->Parent->GetPatchArrayStatus(internalMeshName.c_str());
+
+      // Add the surface mesh by default always
+      const vtkStdString surfaceMeshName(this->RegionPrefix()
+          + vtkOFFReaderPrivate::SurfaceMeshIdentifier);
+      if (!this->Parent->PatchDataArraySelection
+          ->ArrayExists(surfaceMeshName.c_str()))
+        {
+        this->Parent->PatchDataArraySelection
+            ->DisableArray(surfaceMeshName.c_str());
+        }
+      this->SurfaceMeshSelectionStatus
+          = this->Parent->GetPatchArrayStatus(surfaceMeshName.c_str());
+
+      if (this->Parent->OutputProcessorPatches
+          == vtkOFFReader::PROCESSOR_PATCHES_AGGREGATE)
+        {
+        const vtkStdString selectionName(this->RegionPrefix()
+            + vtkOFFReaderPrivate::ProcessorPatchesIdentifier);
+        if (!this->Parent->PatchDataArraySelection->ArrayExists(
+            selectionName.c_str()))
+          {
+          this->Parent->PatchDataArraySelection->DisableArray(
+              selectionName.c_str());
+          }
+        }
+
+      // when in decommposed case (appended) mode, memorize processor
+      // boundaries for quick lookup afterwards as processor boundary
+      // faces has to be included in surface mesh appropriately
+      const bool doProcBoundaries = this->SurfaceMeshSelectionStatus &&
+          this->ProcessorName != "" && this->Parent->OutputProcessorPatches
+          == vtkOFFReader::PROCESSOR_PATCHES_OFF;
+
+      // iterate through each entry in the boundary file
+      vtkIdType allBoundariesNextStartFace = 0;
+      this->BoundaryDict.resize(boundaryDict->size());
+      for (size_t i = 0; i < boundaryDict->size(); i++)
+        {
+        vtkFoamEntry *boundaryEntryI = boundaryDict->operator[](i);
+        const vtkFoamEntry *nFacesEntry = boundaryEntryI->Dictionary().Lookup("nFaces");
+        if (nFacesEntry == NULL)
+          {
+          vtkErrorMacro(<< "nFaces entry not found in boundary entry "
+              << boundaryEntryI->GetKeyword().c_str());
+          this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+          delete boundaryDict;
+          return 0;
+          }
+        const vtkIdType nFaces = nFacesEntry->ToIdType();
+
+        // extract name of the current patch for insertion
+        const vtkStdString &boundaryNameI = boundaryEntryI->GetKeyword();
+
+        // create BoundaryDict entry
+        vtkFoamBoundaryEntry &BoundaryEntryI = this->BoundaryDict[i];
+        BoundaryEntryI.NFaces = nFaces;
+        BoundaryEntryI.BoundaryName = boundaryNameI;
+        const vtkFoamEntry *startFaceEntry = boundaryEntryI->Dictionary().Lookup("startFace");
+        if (startFaceEntry == NULL)
+          {
+          vtkErrorMacro(<< "startFace entry not found in boundary entry "
+              << boundaryNameI.c_str());
+          this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+          delete boundaryDict;
+          return 0;
+          }
+        BoundaryEntryI.StartFace = startFaceEntry->ToIdType();
+        const vtkFoamEntry *typeEntry = boundaryEntryI->Dictionary().Lookup("type");
+        if (typeEntry == NULL)
+          {
+          vtkErrorMacro(<< "type entry not found in boundary entry "
+              << boundaryNameI.c_str());
+          this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+          delete boundaryDict;
+          return 0;
+          }
+        BoundaryEntryI.AllBoundariesStartFace = allBoundariesNextStartFace;
+        const vtkStdString typeNameI(typeEntry->ToWord());
+        // if the basic type of the patch is one of the followings the
+        // point-filtered values at patches are overridden by patch values
+        if (typeNameI == "patch" || typeNameI == "wall" || typeNameI == "ggi"
+            || typeNameI == "cyclicGgi" || typeNameI == "overlapGgi")
+          {
+          BoundaryEntryI.BoundaryType = vtkFoamBoundaryEntry::PHYSICAL;
+          allBoundariesNextStartFace += nFaces;
+          }
+        else if (typeNameI == "processor")
+          {
+          BoundaryEntryI.BoundaryType = vtkFoamBoundaryEntry::PROCESSOR;
+          allBoundariesNextStartFace += nFaces;
+
+          const vtkFoamEntry *procNoEntry
+              = boundaryEntryI->Dictionary().Lookup("myProcNo");
+          if (!procNoEntry)
+            {
+            vtkErrorMacro(<< "myProcNo entry not found in boundary entry "
+                << boundaryNameI.c_str());
+            this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+            delete boundaryDict;
+            return 0;
+            }
+          BoundaryEntryI.MyProcNo = procNoEntry->ToInt();
+          procNoEntry = boundaryEntryI->Dictionary().Lookup("neighbProcNo");
+          if (!procNoEntry)
+            {
+            vtkErrorMacro(<< "neighbProcNo entry not found in boundary entry "
+                << boundaryEntryI->GetKeyword().c_str());
+            this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+            delete boundaryDict;
+            return 0;
+            }
+          BoundaryEntryI.NeighbProcNo = procNoEntry->ToInt();
+
+          if (BoundaryEntryI.MyProcNo > BoundaryEntryI.NeighbProcNo)
+            {
+            if (BoundaryEntryI.StartFace
+                < this->BoundaryDict.LowestUpperProcFaceNo)
+              {
+              this->BoundaryDict.LowestUpperProcFaceNo
+                  = BoundaryEntryI.StartFace;
+              }
+            const size_t rangeSize = this->BoundaryDict.UpperProcRanges.size();
+            if (rangeSize > 1
+                && this->BoundaryDict.UpperProcRanges[rangeSize - 1]
+                == BoundaryEntryI.StartFace)
+              {
+              this->BoundaryDict.UpperProcRanges[rangeSize - 1]
+                = BoundaryEntryI.StartFace + nFaces;
+              }
+            else
+              {
+              this->BoundaryDict.UpperProcRanges.push_back(
+                  BoundaryEntryI.StartFace);
+              this->BoundaryDict.UpperProcRanges.push_back(
+                  BoundaryEntryI.StartFace + nFaces);
+              }
+            }
+
+          if (doProcBoundaries)
+            {
+            this->BoundaryDict.ProcBoundaries.push_back(static_cast<int>(i));
+            }
+          }
+        else
+          {
+          BoundaryEntryI.BoundaryType = vtkFoamBoundaryEntry::GEOMETRICAL;
+          }
+        BoundaryEntryI.IsActive = false;
+
+        // always hide processor patches for decomposed cases (appended) to keep
+        // vtkAppendCompositeDataLeaves happy
+        if (this->Parent->OutputProcessorPatches
+            == vtkOFFReader::PROCESSOR_PATCHES_OFF
+            && BoundaryEntryI.BoundaryType == vtkFoamBoundaryEntry::PROCESSOR)
+          {
+          continue;
+          }
+        const vtkStdString selectionName(this->RegionPrefix()
+            + (BoundaryEntryI.BoundaryType == vtkFoamBoundaryEntry::PROCESSOR
+            && this->Parent->OutputProcessorPatches
+            == vtkOFFReader::PROCESSOR_PATCHES_AGGREGATE
+            ? vtkOFFReaderPrivate::ProcessorPatchesIdentifier
+            : boundaryNameI));
+        if (this->Parent->PatchDataArraySelection->
+            ArrayExists(selectionName.c_str()))
+          {
+          // Mark boundary if selected for display
+          if (this->Parent->GetPatchArrayStatus(selectionName.c_str()))
+            {
+            BoundaryEntryI.IsActive = true;
+            }
+          }
+        else
+          {
+          // add patch to list with selection status turned off:
+          // the patch is added to list even if its size is zero
+          this->Parent->PatchDataArraySelection->DisableArray(selectionName.c_str());
+          }
+        }
+
+      delete boundaryDict;
+      }
+    }
+
+  // Read the zone names into selection array
+  if (this->Parent->GetReadZones() && this->PolyMeshFacesDir
+      ->GetValue(this->TimeStep) != this->ZonesTimeDir)
+    {
+    this->ZonesTimeDir = this->PolyMeshFacesDir->GetValue(this->TimeStep);
+    this->ListZoneNames("pointZones");
+    this->ListZoneNames("faceZones");
+    this->ListZoneNames("cellZones");
+    }
+
+  // Add scalars and vectors to metadata
+  vtkStdString timePath(this->CurrentTimePath());
+  // do not do "RemoveAllArrays()" to accumulate array selections
+  // this->CellDataArraySelection->RemoveAllArrays();
+  this->VolFieldFiles->Initialize();
+  this->SurfaceFieldFiles->Initialize();
+  this->PointFieldFiles->Initialize();
+  vtkStringArray *cellObjectNames = vtkStringArray::New();
+  vtkStringArray *surfaceObjectNames = vtkStringArray::New();
+  vtkStringArray *pointObjectNames = vtkStringArray::New();
+  this->GetFieldNames(timePath + this->RegionPath(), false, cellObjectNames,
+      surfaceObjectNames, pointObjectNames);
+
+  this->LagrangianFieldFiles->Initialize();
+  if (listNextTimeStep)
+    {
+    this->Parent->LagrangianPaths->Initialize();
+    }
+  vtkStringArray *lagrangianObjectNames = vtkStringArray::New();
+  this->LocateLagrangianClouds(lagrangianObjectNames, timePath);
+
+  // if the requested timestep is 0 then we also look at the next
+  // timestep to add extra objects that don't exist at timestep 0 into
+  // selection lists. Note the ObjectNames array will be recreated in
+  // RequestData() so we don't have to worry about duplicated fields.
+  if (listNextTimeStep && this->TimeValues->GetNumberOfTuples() >= 2
+      && this->TimeStep == 0)
+    {
+    const vtkStdString timePath2(this->TimePath(1));
+    this->GetFieldNames(timePath2 + this->RegionPath(), false, cellObjectNames,
+        surfaceObjectNames, pointObjectNames);
+    // if lagrangian clouds were not found at timestep 0
+    if (this->Parent->LagrangianPaths->GetNumberOfTuples() == 0)
+      {
+      this->LocateLagrangianClouds(lagrangianObjectNames, timePath2);
+      }
+    }
+
+  // sort array names
+  this->SortFieldFiles(cellSelectionNames, this->VolFieldFiles, cellObjectNames);
+  this->SortFieldFiles(surfaceSelectionNames, this->SurfaceFieldFiles,
+      surfaceObjectNames);
+  this->SortFieldFiles(pointSelectionNames, this->PointFieldFiles,
+      pointObjectNames);
+  this->SortFieldFiles(lagrangianSelectionNames, this->LagrangianFieldFiles,
+      lagrangianObjectNames);
+
+  return 1;
+}
+
+//-----------------------------------------------------------------------------
+// list time directories according to controlDict
+bool vtkOFFReaderPrivate::ListTimeDirectoriesByControlDict(
+    vtkFoamDict* dictPtr)
+{
+  vtkFoamDict& dict = *dictPtr;
+
+  const vtkFoamEntry *startTimeEntry = dict.Lookup("startTime");
+  if (startTimeEntry == NULL)
+    {
+    vtkErrorMacro(<< "startTime entry not found in controlDict");
+    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+    return false;
+    }
+  // using double to precisely handle time values
+  const double startTime = startTimeEntry->ToDouble();
+
+  const vtkFoamEntry *endTimeEntry = dict.Lookup("endTime");
+  if (endTimeEntry == NULL)
+    {
+    vtkErrorMacro(<< "endTime entry not found in controlDict");
+    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+    return false;
+    }
+  const double endTime = endTimeEntry->ToDouble();
+
+  const vtkFoamEntry *deltaTEntry = dict.Lookup("deltaT");
+  if (deltaTEntry == NULL)
+    {
+    vtkErrorMacro(<< "deltaT entry not found in controlDict");
+    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+    return false;
+    }
+  const double deltaT = deltaTEntry->ToDouble();
+
+  const vtkFoamEntry *writeIntervalEntry = dict.Lookup("writeInterval");
+  if (writeIntervalEntry == NULL)
+    {
+    vtkErrorMacro(<< "writeInterval entry not found in controlDict");
+    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+    return false;
+    }
+  const double writeInterval = writeIntervalEntry->ToDouble();
+
+  const vtkFoamEntry *timeFormatEntry = dict.Lookup("timeFormat");
+  if (timeFormatEntry == NULL)
+    {
+    vtkErrorMacro(<< "timeFormat entry not found in controlDict");
+    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+    return false;
+    }
+  const vtkStdString timeFormat(timeFormatEntry->ToWord());
+
+  const vtkFoamEntry *timePrecisionEntry = dict.Lookup("timePrecision");
+  const int timePrecision // default is 6
+      = (timePrecisionEntry != NULL ? timePrecisionEntry->ToInt() : 6);
+
+  // calculate the time step increment based on type of run
+  const vtkFoamEntry *writeControlEntry = dict.Lookup("writeControl");
+  if (writeControlEntry == NULL)
+    {
+    vtkErrorMacro(<< "writeControl entry not found in controlDict");
+    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+    return false;
+    }
+  const vtkStdString writeControl(writeControlEntry->ToWord());
+  double timeStepIncrement;
+  if (writeControl == "timeStep")
+    {
+    timeStepIncrement = writeInterval * deltaT;
+    }
+  else if (writeControl == "runTime" || writeControl == "adjustableRunTime")
+    {
+    timeStepIncrement = writeInterval;
+    }
+  else
+    {
+    vtkErrorMacro(<<"Time step can't be determined because writeControl is"
+        " set to " << writeControl.c_str());
+    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+    return false;
+    }
+
+  // calculate how many timesteps there should be
+  const double tempResult = (endTime - startTime) / timeStepIncrement;
+  // +0.5 to round up
+  const int tempNumTimeSteps = static_cast<int>(tempResult + 0.5) + 1;
+
+  // make sure time step dir exists
+  const vtkFoamCaseIndex::vtkFoamDirEntry *caseDir
+      = this->CaseIndex->Lookup(this->CasePath, false,
+      this->Parent->GetIsSinglePrecisionBinary() != 0);
+  this->TimeValues->Initialize();
+  this->TimeNames->Initialize();
+
+  // determine time name based on Foam::Time::timeName()
+  // cf. src/OpenFOAM/db/Time/Time.C
+  vtksys_ios::ostringstream parser;
+#ifdef _MSC_VER
+  bool correctExponent = true;
+#endif
+  if (timeFormat == "general")
+    {
+    parser.setf(vtksys_ios::ios_base::fmtflags(0), vtksys_ios::ios_base::floatfield);
+    }
+  else if (timeFormat == "fixed")
+    {
+    parser.setf(vtksys_ios::ios_base::fmtflags(vtksys_ios::ios_base::fixed),
+        vtksys_ios::ios_base::floatfield);
+#ifdef _MSC_VER
+    correctExponent = false;
+#endif
+    }
+  else if (timeFormat == "scientific")
+    {
+    parser.setf(vtksys_ios::ios_base::fmtflags(vtksys_ios::ios_base::scientific),
+        vtksys_ios::ios_base::floatfield);
+    }
+  else
+    {
+    vtkWarningMacro("Warning: unsupported time format. Assuming general.");
+    parser.setf(vtksys_ios::ios_base::fmtflags(0), vtksys_ios::ios_base::floatfield);
+    }
+  parser.precision(timePrecision);
+
+  for (int i = 0; i < tempNumTimeSteps; i++)
+    {
+    parser.str("");
+    const double tempStep = i * timeStepIncrement + startTime;
+    parser << tempStep; // stringstream doesn't require ends
+#ifdef _MSC_VER
+    // workaround for format difference in MSVC++:
+    // remove an extra 0 from exponent
+    if(correctExponent)
+      {
+      vtkStdString tempStr(parser.str());
+      vtkStdString::size_type pos = tempStr.find('e');
+      if(pos != vtkStdString::npos && tempStr.length() >= pos + 3
+          && tempStr[pos + 2] == '0')
+        {
+        tempStr.erase(pos + 2, 1);
+        parser.str(tempStr);
+        }
+      }
+#endif
+    // Add the time steps that actually exist to steps
+    // allows the run to be stopped short of controlDict spec
+    // allows for removal of timesteps
+    if (caseDir != NULL && caseDir->HasSubDir(parser.str()))
+      {
+      this->TimeValues->InsertNextValue(tempStep);
+      this->TimeNames->InsertNextValue(parser.str());
+      }
+    // necessary for reading the case/0 directory whatever the timeFormat is
+    // based on Foam::Time::operator++() cf. src/OpenFOAM/db/Time/Time.C
+    else if ((fabs(tempStep) < 1.0e-14L) // 10*SMALL
+        && caseDir != NULL && caseDir->HasSubDir("0"))
+      {
+      this->TimeValues->InsertNextValue(tempStep);
+      this->TimeNames->InsertNextValue(vtkStdString("0"));
+      }
+    }
+  this->TimeValues->Squeeze();
+  this->TimeNames->Squeeze();
+
+  if (this->TimeValues->GetNumberOfTuples() == 0)
+    {
+    // set the number of timesteps to 1 if the constant subdirectory exists
+    if (caseDir != NULL && caseDir->HasSubDir("constant"))
+      {
+      parser.str("");
+      parser << startTime;
+      this->TimeValues->InsertNextValue(startTime);
+      this->TimeValues->Squeeze();
+      this->TimeNames->InsertNextValue(parser.str());
+      this->TimeNames->Squeeze();
+      }
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// list time directories by searching all valid time instances in a
+// case directory
+bool vtkOFFReaderPrivate::ListTimeDirectoriesByInstances()
+{
+  // open the case directory
+  const vtkFoamCaseIndex::vtkFoamDirEntry *caseDir
+      = this->CaseIndex->Lookup(this->CasePath, false,
+      this->Parent->GetIsSinglePrecisionBinary() != 0);
+  if (caseDir == NULL)
+    {
+    vtkErrorMacro(<< "Can't open directory " << this->CasePath.c_str());
+    this->Parent->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+    return false;
+    }
+
+  // the time directories listed before keep their time values unless
+  // they have been removed so that only the new directories are
+  // converted and sorted
+  typedef vtkstd::pair<double, vtkStdString> timePair;
+  vtkstd::vector<timePair> timesOld, timesNew;
+  vtksys::hash_map<vtkstd::string, int> knownTimes;
+  for (int timeI = 0; timeI < this->TimeNames->GetNumberOfValues(); timeI++)
+    {
+    const vtkStdString &timeName = this->TimeNames->GetValue(timeI);
+    knownTimes[timeName] = timeI;
+    if (caseDir->HasSubDir(timeName))
+      {
+      timesOld.push_back(timePair(this->TimeValues->GetValue(timeI),
+          timeName));
+      }
+    }
+
+  // search all the directories in the case directory and detect
+  // directories with names convertible to numbers
+  const size_t nSubDirs = caseDir->SubDirs.size();
+  for (size_t i = 0; i < nSubDirs; i++)
+    {
+    const vtkStdString &dir = caseDir->SubDirs[i];
+    if (knownTimes.find(dir) != knownTimes.end())
+      {
+      continue;
+      }
+
+    // check if the name is convertible to a number
+    bool isTimeDir = true;
+    for (size_t j = 0; j < dir.length(); j++)
+      {
+      const char c = dir[j];
+      if (!isdigit(c) && c != '+' && c != '-' && c != '.' && c != 'e' && c
+          != 'E')
+        {
+        isTimeDir = false;
+        break;
+        }
+      }
+    if (!isTimeDir)
+      {
+      continue;
+      }
+
+    // convert to a number
+    char *endptr;
+    double timeValue = strtod(dir.c_str(), &endptr);
+    // check if the value really was converted to a number
+    if (timeValue == 0.0 && endptr == dir.c_str())
+      {
+      continue;
+      }
+
+    // add to the instance list
+    timesNew.push_back(timePair(timeValue, dir));
+    }
+
+  // sort the new time directories and merge them into the ones listed
+  // before. If there are duplicated timeValues found, the one listed
+  // before is retained (e.g. "0" and "0.000")
+  vtkstd::sort(timesNew.begin(), timesNew.end());
+  this->TimeValues->Initialize();
+  this->TimeNames->Initialize();
+  size_t oldI = 0, newI = 0;
+  while (oldI < timesOld.size() || newI < timesNew.size())
+    {
+    const timePair &timeI = newI == timesNew.size()
+        || (oldI < timesOld.size() && timesOld[oldI].first
+        <= timesNew[newI].first) ? timesOld[oldI++] : timesNew[newI++];
+    const vtkIdType nTimes = this->TimeValues->GetNumberOfTuples();
+    // compare by exact match
+    if (nTimes > 0 && this->TimeValues->GetValue(nTimes - 1) == timeI.first)
+      {
+      vtkWarningMacro(<<"Different time directories with the same time value "
+          << this->TimeNames->GetValue(nTimes - 1).c_str() << " and "
+          << timeI.second.c_str() << " found. " << timeI.second.c_str()
+          << " will be ignored.");
+      continue;
+      }
+    this->TimeValues->InsertNextValue(timeI.first);
+    this->TimeNames->InsertNextValue(timeI.second);
+    }
+  this->TimeValues->Squeeze();
+  this->TimeNames->Squeeze();
+
+  if (this->TimeValues->GetNumberOfTuples() == 0)
+    {
+    // set the number of timesteps to 1 if the constant subdirectory exists
+    if (caseDir->HasSubDir("constant"))
+      {
+      this->TimeValues->InsertNextValue(0.0);
+      this->TimeValues->Squeeze();
+      this->TimeNames->InsertNextValue("0");
+      this->TimeNames->Squeeze();
+      }
+    }
+
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// gather the necessary information to create a path to the data
+bool vtkOFFReaderPrivate::MakeInformationVector(
+    const vtkStdString &casePath, const vtkStdString &controlDictPath,
+    const vtkStdString &procName, vtkOFFReader *parent,
+    vtkFoamCaseIndex *caseIndex, vtkStringArray *timeNamesOld)
+{
+  this->CasePath = casePath;
+  this->ProcessorName = procName;
+  this->Parent = parent;
+  this->CaseIndex = caseIndex;
+
+  vtkFoamMaxThreadsScope maxThreads(this->Parent->GetNumberOfThreads());
+
+  // restore the index kept in the cache directory from the last session
+  const char *cacheDir = this->Parent->GetMeshCacheDirectory();
+  if (!this->CaseIndex->IsRead && cacheDir != NULL && *cacheDir != '\0')
+    {
+    this->ReadCaseIndex();
+    }
+
+  // list timesteps (skip parsing controlDict entirely if
+  // ListTimeStepsByControlDict is set to 0)
+  bool ret = false; // tentatively set to false to suppress warning by older compilers
+  if (this->Parent->GetListTimeStepsByControlDict())
+    {
+    vtkFoamIOobject io(this->CasePath,
+        this->Parent->GetIsSinglePrecisionBinary() != 0);
+
+    // open and check if controlDict is readable
+    if (!io.Open(controlDictPath))
+      {
+      vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
+          << io.GetError().c_str());
+      this->Parent->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+      return false;
+      }
+    vtkFoamDict dict;
+    if (!dict.Read(io))
+      {
+      vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
+          << " of " << io.GetFileName().c_str() << ": " << io.GetError().c_str());
+      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+      return false;
+      }
+    if (dict.GetType() != vtkFoamToken::DICTIONARY)
+      {
+      vtkErrorMacro(<<"The file type of " << io.GetFileName().c_str()
+          << " is not a dictionary");
+      this->Parent->SetErrorCode(vtkErrorCode::UnrecognizedFileTypeError);
+      return false;
+      }
+
+    const vtkFoamEntry *writeControlEntry = dict.Lookup("writeControl");
+    if (writeControlEntry == NULL)
+      {
+      vtkErrorMacro(<< "writeControl entry not found in "
+          << io.GetFileName().c_str());
+      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+      return false;
+      }
+    const vtkStdString writeControl(writeControlEntry->ToWord());
+
+    // empty if not found
+    const vtkFoamEntry *adjustTimeStepEntry = dict.Lookup("adjustTimeStep");
+    const vtkStdString
+        adjustTimeStep = adjustTimeStepEntry == NULL ? vtkStdString()
+            : adjustTimeStepEntry->ToWord();
+
+    // list time directories according to controlDict if (adjustTimeStep
+    // writeControl) == (off, timeStep) or (on, adjustableRunTime); list
+    // by time instances in the case directory otherwise (different behavior
+    // from paraFoam)
+    // valid switching words cf. src/OpenFOAM/db/Switch/Switch.C
+    if ((((adjustTimeStep == "off" || adjustTimeStep == "no" || adjustTimeStep
+        == "n" || adjustTimeStep == "false" || adjustTimeStep == "")
+        && writeControl == "timeStep") || ((adjustTimeStep == "on"
+        || adjustTimeStep == "yes" || adjustTimeStep == "y" || adjustTimeStep
+        == "true") && writeControl == "adjustableRunTime")))
+      {
+      ret = this->ListTimeDirectoriesByControlDict(&dict);
+      }
+    else
+      {
+      ret = this->ListTimeDirectoriesByInstances();
+      }
+    }
+  else
+    {
+    ret = this->ListTimeDirectoriesByInstances();
+    }
+
+  if (!ret)
+    {
+    return ret;
+    }
+
+  this->PopulatePolyMeshDirArrays(timeNamesOld);
+  return ret;
+}
+
+//-----------------------------------------------------------------------------
+void vtkOFFReaderPrivate::AppendMeshDirToArray(
+    vtkStringArray* polyMeshDir, const bool isFound,
+    const vtkStdString &fileName, const int timeI)
+{
+  if (isFound)
+    {
+    // set points/faces location to current timesteps value
+    polyMeshDir->SetValue(timeI, this->TimeNames->GetValue(timeI));
+    }
+  else
+    {
+    if (timeI != 0)
+      {
+      // set points/faces location to previous timesteps value
+      polyMeshDir->SetValue(timeI, polyMeshDir->GetValue(timeI - 1));
+      }
+    else
+      {
+      if (this->CaseIndex->LookupHeader(this->CasePath + "constant"
+          + this->RegionPath() + "/polyMesh", fileName,
+          this->Parent->GetIsSinglePrecisionBinary() != 0) != NULL)
+        {
+        // set points/faces to constant
+        polyMeshDir->SetValue(timeI, "constant");
+        }
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+// create a Lookup Table containing the location of the points
+// and faces files for each time steps mesh. If the time directories
+// have been listed again, only the timesteps not listed before and
+// the last timestep listed before, whose directory may have been
+// being written, are searched for mesh files.
+void vtkOFFReaderPrivate::PopulatePolyMeshDirArrays(
+    vtkStringArray *timeNamesOld)
+{
+  vtksys::hash_map<vtkstd::string, int> knownTimes;
+  const int nStepsOld
+      = timeNamesOld != NULL ? timeNamesOld->GetNumberOfValues() : 0;
+  for (int i = 0; i < nStepsOld - 1; i++)
+    {
+    knownTimes[timeNamesOld->GetValue(i)] = i;
+    }
+  vtkStringArray *pointsDirOld = this->PolyMeshPointsDir;
+  vtkStringArray *facesDirOld = this->PolyMeshFacesDir;
+  this->PolyMeshPointsDir = vtkStringArray::New();
+  this->PolyMeshFacesDir = vtkStringArray::New();
+
+  // intialize size to number of timesteps
+  const int nSteps = this->TimeValues->GetNumberOfTuples();
+  this->PolyMeshPointsDir->SetNumberOfValues(nSteps);
+  this->PolyMeshFacesDir->SetNumberOfValues(nSteps);
+
+  // loop through each timestep
+  for (int i = 0; i < nSteps; i++)
+    {
+    const vtkStdString &timeName = this->TimeNames->GetValue(i);
+    vtksys::hash_map<vtkstd::string, int>::const_iterator knownI
+        = knownTimes.find(timeName);
+    bool hasPoints, hasFaces;
+    if (knownI != knownTimes.end())
+      {
+      // a timestep has its own mesh files if its mesh locations are
+      // its own
+      hasPoints = (pointsDirOld->GetValue(knownI->second) == timeName);
+      hasFaces = (facesDirOld->GetValue(knownI->second) == timeName);
+      }
+    else
+      {
+      // the files in the polyMesh directory of the timestep
+      const vtkFoamCaseIndex::vtkFoamDirEntry *polyMeshDir
+          = this->CaseIndex->Lookup(this->TimeRegionPath(i) + "/polyMesh",
+          true, this->Parent->GetIsSinglePrecisionBinary() != 0);
+      hasPoints = polyMeshDir != NULL
+          && polyMeshDir->GetHeader("points") != NULL;
+      hasFaces = polyMeshDir != NULL
+          && polyMeshDir->GetHeader("faces") != NULL;
+      }
+    AppendMeshDirToArray(this->PolyMeshPointsDir, hasPoints, "points", i);
+    AppendMeshDirToArray(this->PolyMeshFacesDir, hasFaces, "faces", i);
+    }
+
+  // renumber the timesteps listed before. The meshes are read again if
+  // the mesh of the last timestep read has moved, been removed or been
+  // rewritten in place. The fields are read again if the timestep was
+  // the last one listed before, whose files may have been incomplete
+  // when they were read.
+  if (nStepsOld > 0)
+    {
+    if (this->TimeStepOld >= 0 && this->TimeStepOld < nStepsOld)
+      {
+      this->RereadFields |= this->TimeStepOld == nStepsOld - 1;
+      const int timeI
+          = this->FindTimeName(timeNamesOld->GetValue(this->TimeStepOld));
+      this->TimeStepOld = timeI >= 0
+          && this->PolyMeshPointsDir->GetValue(timeI)
+          == pointsDirOld->GetValue(this->TimeStepOld)
+          && this->PolyMeshFacesDir->GetValue(timeI)
+          == facesDirOld->GetValue(this->TimeStepOld)
+          && this->MeshFilesKey(timeI) == this->MeshFilesKeyOld ? timeI : -1;
+      }
+    if (this->TimeStep < nStepsOld)
+      {
+      const int timeI
+          = this->FindTimeName(timeNamesOld->GetValue(this->TimeStep));
+      if (timeI >= 0)
+        {
+        this->SetTimeStep(timeI);
+        }
+      }
+    }
+  pointsDirOld->Delete();
+  facesDirOld->Delete();
+
+  // does not seem to be required even if number of timesteps reduced
+  // upon refresh since ParaView rewinds TimeStep to 0, but for precaution
+  if (this->TimeValues->GetNumberOfTuples() > 0)
+    {
+    if (this->TimeStep >= this->TimeValues->GetNumberOfTuples())
+      {
+      this->SetTimeStep(this->TimeValues->GetNumberOfTuples() - 1);
+      }
+    }
+  else
+    {
+    this->SetTimeStep(0);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// the index of a timestep by its time name, or -1 if not found
+int vtkOFFReaderPrivate::FindTimeName(const vtkStdString &timeName) const
+{
+  for (int timeI = 0; timeI < this->TimeNames->GetNumberOfValues(); timeI++)
+    {
+    if (this->TimeNames->GetValue(timeI) == timeName)
+      {
+      return timeI;
+      }
+    }
+  return -1;
+}
+
+//-----------------------------------------------------------------------------
+// class vtkFoamMeshFile
+// a faces, owner, neighbour or points file read on a thread of its
+// own by ReadMeshFiles(). Errors are kept to be reported by the
+// calling thread.
+struct vtkOFFReaderPrivate::vtkFoamMeshFile
+{
+  enum fileTypes
+    {
+    FACES, LABELLIST, POINTS
+    };
+
+private:
+  fileTypes Type;
+  vtkStdString Path;
+  void *Ptr;
+  bool IsOpened;
+  vtkStdString Error;
+  unsigned long ErrorCode;
+
+  // not implemented.
+  vtkFoamMeshFile(const vtkFoamMeshFile &);
+  void operator=(const vtkFoamMeshFile &);
+
+public:
+  vtkFoamMeshFile() :
+    Type(FACES), Path(), Ptr(NULL), IsOpened(false), Error(),
+    ErrorCode(vtkErrorCode::NoError)
+  {
+  }
+  ~vtkFoamMeshFile()
+  {
+    if (this->Ptr != NULL)
+      {
+      if (this->Type == FACES)
+        {
+        delete static_cast<vtkFoamIntVectorVector *>(this->Ptr);
+        }
+      else
+        {
+        static_cast<vtkDataArray *>(this->Ptr)->Delete();
+        }
+      }
+  }
+
+  void SetFile(const fileTypes type, const vtkStdString &path)
+  {
+    this->Type = type;
+    this->Path = path;
+  }
+  const vtkStdString &GetPath() const
+  {
+    return this->Path;
+  }
+  // the list read, still owned by the object
+  void *GetPtr() const
+  {
+    return this->Ptr;
+  }
+  // the list read, to be deleted by the caller
+  void *ReleasePtr()
+  {
+    void *ptr = this->Ptr;
+    this->Ptr = NULL;
+    return ptr;
+  }
+  bool GetIsOpened() const
+  {
+    return this->IsOpened;
+  }
+  const vtkStdString &GetError() const
+  {
+    return this->Error;
+  }
+  unsigned long GetErrorCode() const
+  {
+    return this->ErrorCode;
+  }
+
+  // does nothing if the path is empty
+  void Read(const vtkStdString &casePath, const bool isSinglePrecisionBinary)
+  {
+    if (this->Path == "")
+      {
+      return;
+      }
+    vtkFoamIOobject io(casePath, isSinglePrecisionBinary);
+    if (!(io.Open(this->Path) || io.Open(this->Path + ".gz")))
+      {
+      this->Error = vtkFoamError() << "Error opening "
+          << io.GetFileName().c_str() << ": " << io.GetError().c_str();
+      this->ErrorCode = vtkErrorCode::CannotOpenFileError;
+      return;
+      }
+    this->IsOpened = true;
+
+    vtkFoamEntryValue dict(NULL);
+    try
+      {
+      if (this->Type == FACES)
+        {
+        if (io.GetClassName() == "faceCompactList")
+          {
+          dict.ReadCompactIOLabelList(io);
+          }
+        else
+          {
+          dict.ReadLabelListList(io);
+          }
+        }
+      else if (this->Type == LABELLIST)
+        {
+        // read as a vtkIdTypeArray, which only the mesh code below
+        // takes over from the dictionary
+        dict.ReadNonuniformList<vtkFoamToken::LABELLIST,
+        vtkFoamEntryValue::listTraits<vtkIdTypeArray, vtkIdType> >(io);
+        }
+      else
+        {
+        dict.ReadNonuniformList<vtkFoamToken::VECTORLIST,
+        vtkFoamEntryValue::vectorListTraits<vtkFloatArray, float, 3, false> >(
+            io);
+        }
+      }
+    catch(vtkFoamError& e)
+      {
+      this->Error = vtkFoamError() << "Error reading line "
+          << io.GetLineNumber() << " of " << io.GetFileName().c_str() << ": "
+          << e.c_str();
+      this->ErrorCode = vtkErrorCode::FileFormatError;
+      return;
+      }
+    this->Ptr = dict.Ptr();
+  }
+};
+
+//-----------------------------------------------------------------------------
+// reads one of the mesh files per task
+struct vtkOFFReaderPrivate::vtkFoamMeshFileTasks
+{
+  vtkOFFReaderPrivate *Reader;
+  vtkFoamMeshFile *Files;
+
+  void operator()(const vtkIdType taskI) const
+  {
+    this->Files[taskI].Read(this->Reader->CasePath,
+        this->Reader->Parent->GetIsSinglePrecisionBinary() != 0);
+  }
+};
+
+//-----------------------------------------------------------------------------
+// read the mesh files concurrently
+void vtkOFFReaderPrivate::ReadMeshFiles(vtkFoamMeshFile *files,
+    const int nFiles)
+{
+  vtkFoamMeshFileTasks tasks;
+  tasks.Reader = this;
+  tasks.Files = files;
+  vtkFoamParallelTasks(nFiles, this->Parent->GetNumberOfThreads(), tasks);
+}
+
+//-----------------------------------------------------------------------------
+void vtkOFFReaderPrivate::ReportMeshFileError(const vtkFoamMeshFile &file)
+{
+  vtkErrorMacro(<< file.GetError().c_str());
+  this->Parent->SetErrorCode(file.GetErrorCode());
+}
+
+//-----------------------------------------------------------------------------
+// take the points read into a vtkFloatArray
+vtkFloatArray* vtkOFFReaderPrivate::ReadPointsFile(vtkFoamMeshFile &file)
+{
+  if (file.GetPath() == "")
+    {
+    vtkErrorMacro(<<"Cannot find path to points file for region \""
+        << this->RegionName.c_str() << "\" in case " << this->CasePath.c_str());
+    this->Parent->SetErrorCode(vtkErrorCode::UnknownError);
+    return NULL;
+    }
+  if (file.GetPtr() == NULL)
+    {
+    this->ReportMeshFileError(file);
+    return NULL;
+    }
+
+  vtkFloatArray *pointArray = static_cast<vtkFloatArray *>(file.ReleasePtr());
+
+  // set the number of points
+  this->NumPoints = pointArray->GetNumberOfTuples();
+
+  return pointArray;
+}
+
+//-----------------------------------------------------------------------------
+// take the faces read into a vtkFoamIntVectorVector
+vtkFoamIntVectorVector * vtkOFFReaderPrivate::ReadFacesFile(
+    vtkFoamMeshFile &file)
+{
+  if (!file.GetIsOpened())
+    {
+    vtkErrorMacro(<< file.GetError().c_str() << ". If you are trying to read "
+        "a parallel decomposed case, set Case Type to Decomposed Case.");
+    this->Parent->SetErrorCode(file.GetErrorCode());
+    return NULL;
+    }
+  if (file.GetPtr() == NULL)
+    {
+    this->ReportMeshFileError(file);
+    return NULL;
+    }
+  return static_cast<vtkFoamIntVectorVector *>(file.ReleasePtr());
+}
+
+//-----------------------------------------------------------------------------
+// take the owner and neighbor lists read and create cellFaces
+vtkFoamIntVectorVector * vtkOFFReaderPrivate::ReadOwnerNeighborFiles(
+    const vtkStdString &ownerNeighborPath, vtkFoamIntVectorVector *facePoints,
+    vtkFoamMeshFile &ownerFile, vtkFoamMeshFile &neighborFile)
+{
+  vtkFoamIOobject io(this->CasePath,
+      this->Parent->GetIsSinglePrecisionBinary() != 0);
+  if (ownerFile.GetIsOpened())
+    {
+    if (ownerFile.GetPtr() == NULL)
+      {
+      this->ReportMeshFileError(ownerFile);
+      return NULL;
+      }
+    if (neighborFile.GetPtr() == NULL)
+      {
+      this->ReportMeshFileError(neighborFile);
+      return NULL;
+      }
+
+    this->FaceOwner = static_cast<vtkIdTypeArray *>(ownerFile.ReleasePtr());
+    vtkIdTypeArray &faceOwner = *this->FaceOwner;
+    vtkIdTypeArray &faceNeighbor
+        = *static_cast<vtkIdTypeArray *>(neighborFile.GetPtr());
+
+    const vtkIdType nFaces = faceOwner.GetNumberOfTuples();
+    const vtkIdType nNeiFaces = faceNeighbor.GetNumberOfTuples();
+
+    if (nFaces < nNeiFaces)
+      {
+      vtkErrorMacro(<<"Number of owner faces " << nFaces
+          << " must be equal or larger than number of neighbor faces "
+          << nNeiFaces);
+      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+      return NULL;
+      }
+
+    // the number of owner faces can be smaller than the number of
+    // faces in sliding mesh cases
+    if (nFaces > facePoints->GetNumberOfElements())
+      {
+      vtkWarningMacro(<<"Number of faces in faces "
+          << facePoints->GetNumberOfElements()
+          << " must be equal or larger than number of owner faces "
+          << nFaces);
+      return NULL;
+      }
+
+    // add the face numbers to the correct cell cf. Terry's code and
+    // src/OpenFOAM/meshes/primitiveMesh/primitiveMeshCells.C
+    // find the number of cells
+    vtkIdType nCells = -1;
+    for (vtkIdType faceI = 0; faceI < nNeiFaces; faceI++)
+      {
+      const vtkIdType ownerCell = faceOwner.GetValue(faceI);
+      if (nCells < ownerCell) // max(nCells, faceOwner[i])
+        {
+        nCells = ownerCell;
+        }
+      // we do need to take neighbor faces into account since all the
+      // surrounding faces of a cell can be neighbors for a valid mesh
+      const vtkIdType neighborCell = faceNeighbor.GetValue(faceI);
+      if (nCells < neighborCell) // max(nCells, faceNeighbor[i])
+        {
+        nCells = neighborCell;
+        }
+      }
+    for (vtkIdType faceI = nNeiFaces; faceI < nFaces; faceI++)
+      {
+      const vtkIdType ownerCell = faceOwner.GetValue(faceI);
+      if (nCells < ownerCell) // max(nCells, faceOwner[i])
+        {
+        nCells = ownerCell;
+        }
+      }
+    nCells++;
+
+    if (nCells == 0)
+      {
+      vtkWarningMacro(<<"The mesh contains no cells");
+      }
+
+    // set the number of cells
+    this->NumCells = nCells;
+
+    // create cellFaces with the length of the body undetermined
+    vtkFoamIntVectorVector *cells = new vtkFoamIntVectorVector(nCells, 1);
+
+    // count number of faces for each cell
+    vtkIdType *cfiPtr = cells->GetIndices()->GetPointer(0);
+    for (vtkIdType cellI = 0; cellI <= nCells; cellI++)
+      {
+      cfiPtr[cellI] = 0;
+      }
+    vtkIdType nTotalCellFaces = 0;
+    cfiPtr++; // offset +1
+    for (vtkIdType faceI = 0; faceI < nNeiFaces; faceI++)
+      {
+      const vtkIdType ownerCell = faceOwner.GetValue(faceI);
+      // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
+      if (ownerCell >= 0)
+        {
+        cfiPtr[ownerCell]++;
+        nTotalCellFaces++;
+        }
+      const vtkIdType neighborCell = faceNeighbor.GetValue(faceI);
+      if (neighborCell >= 0)
+        {
+        cfiPtr[neighborCell]++;
+        nTotalCellFaces++;
+        }
+      }
+    for (vtkIdType faceI = nNeiFaces; faceI < nFaces; faceI++)
+      {
+      const vtkIdType ownerCell = faceOwner.GetValue(faceI);
+      if (ownerCell >= 0)
+        {
+        cfiPtr[ownerCell]++;
+        nTotalCellFaces++;
+        }
+      }
+    cfiPtr--; // revert offset +1
+
+    // allocate cellFaces. To reduce the numbers of new/delete operations we
+    // allocate memory space for all faces linearly
+    cells->ResizeBody(nTotalCellFaces);
+
+    // accumulate the number of cellFaces to create cellFaces indices
+    // and copy them to a temporary array
+    vtkIdTypeArray *tmpFaceIndices = vtkIdTypeArray::New();
+    tmpFaceIndices->SetNumberOfValues(nCells + 1);
+    vtkIdType *tfiPtr = tmpFaceIndices->GetPointer(0);
+    tfiPtr[0] = 0;
+    for (vtkIdType cellI = 1; cellI <= nCells; cellI++)
+      {
+      tfiPtr[cellI] = (cfiPtr[cellI] += cfiPtr[cellI - 1]);
+      }
+
+    // add face numbers to cell-faces list
+    vtkIdTypeArray *cellFacesList = cells->GetBody();
+    for (vtkIdType faceI = 0; faceI < nNeiFaces; faceI++)
+      {
+      const vtkIdType ownerCell = faceOwner.GetValue(faceI); // must be signed
+      // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
+      if (ownerCell >= 0)
+        {
+        cellFacesList->SetValue(tfiPtr[ownerCell]++, faceI);
+        }
+      const vtkIdType neighborCell = faceNeighbor.GetValue(faceI);
+      if (neighborCell >= 0)
+        {
+        cellFacesList->SetValue(tfiPtr[neighborCell]++, faceI);
+        }
+      }
+    for (vtkIdType faceI = nNeiFaces; faceI < nFaces; faceI++)
+      {
+      const vtkIdType ownerCell = faceOwner.GetValue(faceI); // must be signed
+      // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
+      if (ownerCell >= 0)
+        {
+        cellFacesList->SetValue(tfiPtr[ownerCell]++, faceI);
+        }
+      }
+    tmpFaceIndices->Delete();
+
+    return cells;
+    }
+  else // if owner does not exist look for cells
+    {
+    vtkStdString cellsPath(ownerNeighborPath + "cells");
+    if (!(io.Open(cellsPath) || io.Open(cellsPath + ".gz")))
+      {
+      vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
+          << io.GetError().c_str());
+      this->Parent->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+      return NULL;
+      }
+    vtkFoamEntryValue cellsDict(NULL);
+    try
+      {
+      cellsDict.ReadLabelListList(io);
+      }
+    catch(vtkFoamError& e)
+      {
+      vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
+          << " of " << io.GetFileName().c_str() << ": " << e.c_str());
+      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+      return NULL;
+      }
+
+    vtkFoamIntVectorVector *cells =
+        static_cast<vtkFoamIntVectorVector *>(cellsDict.Ptr());
+    this->NumCells = cells->GetNumberOfElements();
+    const vtkIdType nFaces = facePoints->GetNumberOfElements();
+
+    // create face owner list
+    this->FaceOwner = vtkIdTypeArray::New();
+    this->FaceOwner->SetNumberOfTuples(nFaces);
+    for (vtkIdType faceI = 0; faceI < nFaces; faceI++)
+      {
+      this->FaceOwner->SetValue(faceI, -1);
+      }
+    for (vtkIdType cellI = 0; cellI < this->NumCells; cellI++)
+      {
+      const vtkIdType nCellFaces = cells->GetSize(cellI);
+      const vtkIdType *cellFaces = cells->operator[](cellI);
+      for (vtkIdType faceI = 0; faceI < nCellFaces; faceI++)
+        {
+        const vtkIdType f = cellFaces[faceI];
+        if (f < 0 || f >= nFaces) // make sure the face number is valid
+          {
+          vtkErrorMacro("Face number " << f << " in cell " << cellI
+              << " exceeds the number of faces " << nFaces);
+          this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+          this->FaceOwner->Delete();
+          this->FaceOwner = NULL;
+          delete cells;
+          return NULL;
+          }
+        const vtkIdType owner = this->FaceOwner->GetValue(f);
+        if (owner == -1 || owner > cellI)
+          {
+          this->FaceOwner->SetValue(f, cellI);
+          }
+        }
+      }
+    // check for unused faces
+    for (vtkIdType faceI = 0; faceI < nFaces; faceI++)
+      {
+      if (this->FaceOwner->GetValue(faceI) == -1)
+        {
+        vtkErrorMacro(<<"Face " << faceI << " is not used");
+        this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+        this->FaceOwner->Delete();
+        this->FaceOwner = NULL;
+        delete cells;
+        return NULL;
+        }
+      }
 
-  const vtkFoamEntry *timePrecisionEntry = dict.Lookup("timePrecision");
-  const int timePrecision // default is 6
-      = (timePrecisionEntry != NULL ? timePrecisionEntry->ToInt() : 6);
+    return cells;
+    }
+}
 
-  // calculate the time step increment based on type of run
-  const vtkFoamEntry *writeControlEntry = dict.Lookup("writeControl");
-  if (writeControlEntry == NULL)
+//-----------------------------------------------------------------------------
+// reads the size prefix and the opening parenthesis of a binary list
+static vtkIdType vtkFoamReadBinaryListHead(vtkFoamIOobject& io)
+{
+  vtkFoamToken currToken;
+  if (!io.Read(currToken))
     {
-    vtkErrorMacro(<< "writeControl entry not found in controlDict");
-    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-    return false;
+    throw vtkFoamError() << "Unexpected EOF";
     }
-  const vtkStdString writeControl(writeControlEntry->ToWord());
-  double timeStepIncrement;
-  if (writeControl == "timeStep")
+  if (currToken.GetType() != vtkFoamToken::LABEL)
     {
-    timeStepIncrement = writeInterval * deltaT;
+    throw vtkFoamError() << "Expected integer, found " << currToken;
     }
-  else if (writeControl == "runTime" || writeControl == "adjustableRunTime")
+  const vtkIdType size = currToken.ToIdType();
+  if (size < 0)
     {
-    timeStepIncrement = writeInterval;
+    throw vtkFoamError() << "List size must not be negative: size = " << size;
     }
-  else
+  if (size > 0)
     {
-    vtkErrorMacro(<<"Time step can't be determined because writeControl is"
-        " set to " << writeControl.c_str());
-    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-    return false;
+    // read parentheses only when size > 0
+    io.ReadExpecting('(');
     }
+  return size;
+}
 
-  // calculate how many timesteps there should be
-  const double tempResult = (endTime - startTime) / timeStepIncrement;
-  // +0.5 to round up
-  const int tempNumTimeSteps = static_cast<int>(tempResult + 0.5) + 1;
-
-  // make sure time step dir exists
-  vtkstd::vector<double> tempSteps;
-  vtkDirectory *test = vtkDirectory::New();
-  this->TimeValues->Initialize();
-  this->TimeNames->Initialize();
-
-  // determine time name based on Foam::Time::timeName()
-  // cf. src/OpenFOAM/db/Time/Time.C
-  vtksys_ios::ostringstream parser;
-#ifdef _MSC_VER
-  bool correctExponent = true;
-#endif
-  if (timeFormat == "general")
-    {
-    parser.setf(vtksys_ios::ios_base::fmtflags(0), vtksys_ios::ios_base::floatfield);
-    }
-  else if (timeFormat == "fixed")
-    {
-    parser.setf(vtksys_ios::ios_base::fmtflags(vtksys_ios::ios_base::fixed),
-        vtksys_ios::ios_base::floatfield);
-#ifdef _MSC_VER
-    correctExponent = false;
-#endif
-    }
-  else if (timeFormat == "scientific")
+//-----------------------------------------------------------------------------
+// read only the owner labels and the faces of the active patches,
+// seeking past the internal faces and the inactive patches. The
+// returned faces cover the boundary faces from the start face of the
+// first patch on, the faces of inactive patches being empty. FaceOwner
+// is set up for the boundary faces the same way as by
+// TruncateFaceOwner() except that the owner cells are numbered in the
+// order of BoundaryOwnerCells. Returns NULL if the files are not binary
+// owner and faceCompactList, or on any error, in which case the whole
+// files are to be read, which also reports the error.
+vtkFoamIntVectorVector * vtkOFFReaderPrivate::ReadBoundaryMeshFiles(
+    const vtkStdString &meshDir)
+{
+  const int nBoundaries = static_cast<int>(this->BoundaryDict.size());
+  const vtkIdType boundaryStartFace = this->BoundaryDict[0].StartFace;
+  vtkIdType boundaryEndFace = boundaryStartFace;
+  for (int boundaryI = 0; boundaryI < nBoundaries; boundaryI++)
     {
-    parser.setf(vtksys_ios::ios_base::fmtflags(vtksys_ios::ios_base::scientific),
-        vtksys_ios::ios_base::floatfield);
+    const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
+    if (beI.StartFace != boundaryEndFace || beI.NFaces < 0)
+      {
+      return NULL;
+      }
+    boundaryEndFace += beI.NFaces;
     }
-  else
+  const vtkIdType nBoundaryFaces = boundaryEndFace - boundaryStartFace;
+
+  vtkFoamIOobject io(this->CasePath,
+      this->Parent->GetIsSinglePrecisionBinary() != 0);
+  const vtkStdString ownerPath(meshDir + "owner");
+  if (!(io.Open(ownerPath) || io.Open(ownerPath + ".gz"))
+      || io.GetFormat() != vtkFoamIOobject::BINARY)
     {
-    vtkWarningMacro("Warning: unsupported time format. Assuming general.");
-    parser.setf(vtksys_ios::ios_base::fmtflags(0), vtksys_ios::ios_base::floatfield);
+    return NULL;
     }
-  parser.precision(timePrecision);
 
-  for (int i = 0; i < tempNumTimeSteps; i++)
+  vtkIdTypeArray *faceOwner = vtkIdTypeArray::New();
+  faceOwner->SetNumberOfValues(nBoundaryFaces);
+  vtkIdTypeArray *ownerCells = vtkIdTypeArray::New();
+  vtkFoamIntVectorVector *facePoints = NULL;
+  try
     {
-    parser.str("");
-    const double tempStep = i * timeStepIncrement + startTime;
-    parser << tempStep; // stringstream doesn't require ends
-#ifdef _MSC_VER
-    // workaround for format difference in MSVC++:
-    // remove an extra 0 from exponent
-    if(correctExponent)
+    // owner labels of the active patches
+    const size_t labelSize = io.GetUse64BitLabels() ? sizeof(vtkTypeInt64)
+        : sizeof(int);
+    const vtkIdType nOwnerFaces = vtkFoamReadBinaryListHead(io);
+    if (boundaryEndFace > nOwnerFaces)
       {
-      vtkStdString tempStr(parser.str());
-      vtkStdString::size_type pos = tempStr.find('e');
-      if(pos != vtkStdString::npos && tempStr.length() >= pos + 3
-          && tempStr[pos + 2] == '0')
-        {
-        tempStr.erase(pos + 2, 1);
-        parser.str(tempStr);
-        }
+      throw vtkFoamError() << "The end face number " << boundaryEndFace - 1
+          << " of the last patch exceeds the number of owner faces "
+          << nOwnerFaces;
       }
-#endif
-    // Add the time steps that actually exist to steps
-    // allows the run to be stopped short of controlDict spec
-    // allows for removal of timesteps
-    if (test->Open((this->CasePath + parser.str()).c_str()))
+    vtkIdType nActiveFaces = 0;
+    vtkIdType faceI = 0;
+    for (int boundaryI = 0; boundaryI < nBoundaries; boundaryI++)
       {
-      this->TimeValues->InsertNextValue(tempStep);
-      this->TimeNames->InsertNextValue(parser.str());
+      const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
+      vtkIdType *owner
+          = faceOwner->GetPointer(beI.StartFace - boundaryStartFace);
+      if (!beI.IsActive)
+        {
+        for (vtkIdType j = 0; j < beI.NFaces; j++)
+          {
+          owner[j] = -1;
+          }
+        continue;
+        }
+      io.Skip(labelSize * (beI.StartFace - faceI));
+      vtkFoamReadBinaryLabels(io, owner, beI.NFaces);
+      faceI = beI.StartFace + beI.NFaces;
+      nActiveFaces += beI.NFaces;
       }
-    // necessary for reading the case/0 directory whatever the timeFormat is
-    // based on Foam::Time::operator++() cf. src/OpenFOAM/db/Time/Time.C
-    else if ((fabs(tempStep) < 1.0e-14L) // 10*SMALL
-        && test->Open((this->CasePath + vtkStdString("0")).c_str()))
+    if (nOwnerFaces > 0)
       {
-      this->TimeValues->InsertNextValue(tempStep);
-      this->TimeNames->InsertNextValue(vtkStdString("0"));
+      io.Skip(labelSize * (nOwnerFaces - faceI));
+      io.ReadExpecting(')');
       }
-    }
-  test->Delete();
-  this->TimeValues->Squeeze();
-  this->TimeNames->Squeeze();
+    io.Close();
 
-  if (this->TimeValues->GetNumberOfTuples() == 0)
-    {
-    // set the number of timesteps to 1 if the constant subdirectory exists
-    test = vtkDirectory::New();
-    if (test->Open((this->CasePath + "constant").c_str()))
+    // the distinct owner cells in ascending order
+    ownerCells->SetNumberOfValues(nActiveFaces);
+    for (int boundaryI = 0, activeFaceI = 0; boundaryI < nBoundaries;
+        boundaryI++)
       {
-      parser.str("");
-      parser << startTime;
-      this->TimeValues->InsertNextValue(startTime);
-      this->TimeValues->Squeeze();
-      this->TimeNames->InsertNextValue(parser.str());
-      this->TimeNames->Squeeze();
+      const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
+      if (beI.IsActive)
+        {
+        memcpy(ownerCells->GetPointer(activeFaceI),
+            faceOwner->GetPointer(beI.StartFace - boundaryStartFace),
+            sizeof(vtkIdType) * beI.NFaces);
+        activeFaceI += beI.NFaces;
+        }
       }
-    test->Delete();
-    }
-  return true;
-}
-
-//-----------------------------------------------------------------------------
-// list time directories by searching all valid time instances in a
-// case directory
-bool vtkOFFReaderPrivate::ListTimeDirectoriesByInstances()
-{
-  // open the case directory
-  vtkDirectory* test = vtkDirectory::New();
-  if (!test->Open(this->CasePath.c_str()))
-    {
-    test->Delete();
-    vtkErrorMacro(<< "Can't open directory " << this->CasePath.c_str());
-    this->Parent->SetErrorCode(vtkErrorCode::CannotOpenFileError);
-    return false;
-    }
-
-  // search all the directories in the case directory and detect
-  // directories with names convertible to numbers
-  this->TimeValues->Initialize();
-  this->TimeNames->Initialize();
-  const int nFiles = test->GetNumberOfFiles();
-  for (int i = 0; i < nFiles; i++)
-    {
-    const vtkStdString dir = test->GetFile(i);
-    if (test->FileIsDirectory(dir.c_str()))
+    vtkSortDataArray::Sort(ownerCells);
+    vtkIdType nOwnerCells = 0;
+    for (vtkIdType j = 0; j < nActiveFaces; j++)
       {
-      // check if the name is convertible to a number
-      bool isTimeDir = true;
-      for (size_t j = 0; j < dir.length(); j++)
+      const vtkIdType cellI = ownerCells->GetValue(j);
+      if (cellI < 0)
         {
-        const char c = dir[j];
-        if (!isdigit(c) && c != '+' && c != '-' && c != '.' && c != 'e' && c
-            != 'E')
-          {
-          isTimeDir = false;
-          break;
-          }
+        throw vtkFoamError() << "Negative owner cell " << cellI;
         }
-      if (!isTimeDir)
+      if (nOwnerCells == 0 || cellI != ownerCells->GetValue(nOwnerCells - 1))
         {
-        continue;
+        ownerCells->SetValue(nOwnerCells, cellI);
+        nOwnerCells++;
         }
+      }
+    ownerCells->Resize(nOwnerCells);
 
-      // convert to a number
-      char *endptr;
-      double timeValue = strtod(dir.c_str(), &endptr);
-      // check if the value really was converted to a number
-      if (timeValue == 0.0 && endptr == dir.c_str())
+    // renumber the owner cells by binary search
+    for (vtkIdType j = 0; j < nBoundaryFaces; j++)
+      {
+      const vtkIdType cellI = faceOwner->GetValue(j);
+      if (cellI < 0)
         {
         continue;
         }
-
-      // add to the instance list
-      this->TimeValues->InsertNextValue(timeValue);
-      this->TimeNames->InsertNextValue(dir);
+      vtkIdType lower = 0, upper = nOwnerCells - 1;
+      while (lower < upper)
+        {
+        const vtkIdType middle = (lower + upper) / 2;
+        if (ownerCells->GetValue(middle) < cellI)
+          {
+          lower = middle + 1;
+          }
+        else
+          {
+          upper = middle;
+          }
+        }
+      faceOwner->SetValue(j, lower);
       }
-    }
-  test->Delete();
 
-  this->TimeValues->Squeeze();
-  this->TimeNames->Squeeze();
+    // faces of the active patches
+    const vtkStdString facePath(meshDir + "faces");
+    if (!(io.Open(facePath) || io.Open(facePath + ".gz"))
+        || io.GetFormat() != vtkFoamIOobject::BINARY
+        || io.GetClassName() != "faceCompactList")
+      {
+      faceOwner->Delete();
+      ownerCells->Delete();
+      return NULL;
+      }
+    const size_t faceLabelSize = io.GetUse64BitLabels()
+        ? sizeof(vtkTypeInt64) : sizeof(int);
+    const vtkIdType nOffsets = vtkFoamReadBinaryListHead(io);
+    if (boundaryEndFace >= nOffsets)
+      {
+      throw vtkFoamError() << "The end face number " << boundaryEndFace - 1
+          << " of the last patch exceeds the number of faces "
+          << nOffsets - 1;
+      }
+    vtkstd::vector<vtkIdType> offsets(nBoundaryFaces + 1);
+    io.Skip(faceLabelSize * boundaryStartFace);
+    vtkFoamReadBinaryLabels(io, &offsets[0], nBoundaryFaces + 1);
+    io.Skip(faceLabelSize * (nOffsets - boundaryEndFace - 1));
+    io.ReadExpecting(')');
 
-  if (this->TimeValues->GetNumberOfTuples() > 1)
-    {
-    // sort the detected time directories
-    vtkSortDataArray::Sort(this->TimeValues, this->TimeNames);
+    vtkIdType nActiveBody = 0;
+    for (int boundaryI = 0; boundaryI < nBoundaries; boundaryI++)
+      {
+      const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
+      if (beI.IsActive)
+        {
+        const vtkIdType startFace = beI.StartFace - boundaryStartFace;
+        nActiveBody += offsets[startFace + beI.NFaces] - offsets[startFace];
+        }
+      }
+    facePoints = new vtkFoamIntVectorVector(nBoundaryFaces, nActiveBody);
+    vtkIdType *indices = facePoints->GetIndices()->GetPointer(0);
 
-    // if there are duplicated timeValues found, remove duplicates
-    // (e.g. "0" and "0.000")
-    for (int timeI = 1; timeI < this->TimeValues->GetNumberOfTuples();)
+    const vtkIdType bodySize = vtkFoamReadBinaryListHead(io);
+    vtkIdType bodyI = 0, activeBodyI = 0;
+    for (int boundaryI = 0; boundaryI < nBoundaries; boundaryI++)
       {
-      // compare by exact match
-      if (this->TimeValues->GetValue(timeI - 1)
-          == this->TimeValues->GetValue(timeI))
+      const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
+      const vtkIdType startFace = beI.StartFace - boundaryStartFace;
+      const vtkIdType endFace = startFace + beI.NFaces;
+      if (!beI.IsActive)
         {
-        vtkWarningMacro(<<"Different time directories with the same time value "
-            << this->TimeNames->GetValue(timeI - 1).c_str() << " and "
-            << this->TimeNames->GetValue(timeI).c_str() << " found. "
-            << this->TimeNames->GetValue(timeI).c_str() << " will be ignored.");
-        this->TimeValues->RemoveTuple(timeI);
-        // vtkStringArray does not have RemoveTuple()
-        for (int timeJ = timeI + 1; timeJ
-            < this->TimeNames->GetNumberOfTuples(); timeJ++)
+        for (vtkIdType j = startFace; j < endFace; j++)
           {
-          this->TimeNames->SetValue(timeJ - 1, this->TimeNames->GetValue(timeJ));
+          indices[j] = activeBodyI;
           }
-        this->TimeNames->Resize(this->TimeNames->GetNumberOfTuples() - 1);
+        continue;
         }
-      else
+      const vtkIdType startBodyI = offsets[startFace];
+      const vtkIdType endBodyI = offsets[endFace];
+      if (startBodyI < bodyI || endBodyI < startBodyI || endBodyI > bodySize)
+        {
+        throw vtkFoamError() << "Inconsistent face offsets for patch "
+            << beI.BoundaryName;
+        }
+      io.Skip(faceLabelSize * (startBodyI - bodyI));
+      vtkFoamReadBinaryLabels(io,
+          facePoints->GetBody()->GetPointer(activeBodyI),
+          endBodyI - startBodyI);
+      for (vtkIdType j = startFace; j < endFace; j++)
         {
-        timeI++;
+        indices[j] = activeBodyI + offsets[j] - startBodyI;
         }
+      activeBodyI += endBodyI - startBodyI;
+      bodyI = endBodyI;
+      }
+    indices[nBoundaryFaces] = activeBodyI;
+    if (bodySize > 0)
+      {
+      io.Skip(faceLabelSize * (bodySize - bodyI));
+      io.ReadExpecting(')');
       }
     }
-  else if (this->TimeValues->GetNumberOfTuples() == 0)
+  catch(vtkFoamError& e)
     {
-    // set the number of timesteps to 1 if the constant subdirectory exists
-    test = vtkDirectory::New();
-    if (test->Open((this->CasePath + "constant").c_str()))
+    vtkDebugMacro(<<"Reading the whole mesh files since reading patches of "
+        << io.GetFileName().c_str() << " failed: " << e.c_str());
+    faceOwner->Delete();
+    ownerCells->Delete();
+    delete facePoints;
+    return NULL;
+    }
+
+  this->FaceOwner = faceOwner;
+  this->BoundaryOwnerCells = ownerCells;
+  this->NumCells = ownerCells->GetNumberOfTuples();
+  return facePoints;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkOFFReaderPrivate::CheckFacePoints(
+    vtkFoamIntVectorVector *facePoints)
+{
+  const vtkIdType nFaces = facePoints->GetNumberOfElements();
+
+  for (vtkIdType faceI = 0; faceI < nFaces; faceI++)
+    {
+    const vtkIdType nPoints = facePoints->GetSize(faceI);
+    const vtkIdType *pointList = facePoints->operator[](faceI);
+    if (nPoints < 3)
       {
-      this->TimeValues->InsertNextValue(0.0);
-      this->TimeValues->Squeeze();
-      this->TimeNames->InsertNextValue("0");
-      this->TimeNames->Squeeze();
+      vtkErrorMacro(<< "Face " << faceI << " has only " << nPoints
+          << " points which is not enough to constitute a face"
+          " (a face must have at least 3 points)");
+      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+      return false;
+      }
+    for (vtkIdType pointI = 0; pointI < nPoints; pointI++)
+      {
+      const vtkIdType p = pointList[pointI];
+      if (p < 0 || p >= this->NumPoints)
+        {
+        vtkErrorMacro(<< "The point number " << p << " at face number " << faceI
+            << " is out of range for " << this->NumPoints << " points");
+        this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+        return false;
+        }
       }
-    test->Delete();
     }
-
   return true;
 }
 
 //-----------------------------------------------------------------------------
-// gather the necessary information to create a path to the data
-bool vtkOFFReaderPrivate::MakeInformationVector(
-    const vtkStdString &casePath, const vtkStdString &controlDictPath,
-    const vtkStdString &procName, vtkOFFReader *parent)
+// class vtkOFFReaderPrivate::vtkFoamMeshCacheFile
+// a mesh cache file holding the arrays of a built internal mesh one
+// after another in the native byte order. Each record is preceded by
+// its size in bytes. The file is memory-mapped for reading where
+// mmap() is available.
+struct vtkOFFReaderPrivate::vtkFoamMeshCacheFile
 {
-  this->CasePath = casePath;
-  this->ProcessorName = procName;
-  this->Parent = parent;
+private:
+  FILE *File;
+  const unsigned char *Map;
+  size_t MapSize, MapPos;
+  // the file being written and the temporary file actually written
+  vtkStdString Path, TempPath;
 
-  // list timesteps (skip parsing controlDict entirely if
-  // ListTimeStepsByControlDict is set to 0)
-  bool ret = false; // tentatively set to false to suppress warning by older compilers
-  if (this->Parent->GetListTimeStepsByControlDict())
-    {
-    vtkFoamIOobject io(this->CasePath,
-        this->Parent->GetIsSinglePrecisionBinary() != 0);
+  // not implemented.
+  vtkFoamMeshCacheFile(const vtkFoamMeshCacheFile &);
+  void operator=(const vtkFoamMeshCacheFile &);
+
+  bool ReadBytes(void *ptr, const size_t size)
+  {
+    if (this->Map != NULL)
+      {
+      if (size > this->MapSize - this->MapPos)
+        {
+        return false;
+        }
+      memcpy(ptr, this->Map + this->MapPos, size);
+      this->MapPos += size;
+      return true;
+      }
+    return size == 0 || fread(ptr, size, 1, this->File) == 1;
+  }
+  bool ReadRecordSize(size_t &size)
+  {
+    vtkTypeUInt64 size64;
+    if (!this->ReadBytes(&size64, sizeof(size64)))
+      {
+      return false;
+      }
+    size = static_cast<size_t>(size64);
+    // reject sizes beyond the end of a mapped file before allocating
+    return size == size64
+        && (this->Map == NULL || size <= this->MapSize - this->MapPos);
+  }
+
+public:
+  vtkFoamMeshCacheFile() :
+    File(NULL), Map(NULL), MapSize(0), MapPos(0)
+  {
+  }
+  ~vtkFoamMeshCacheFile()
+  {
+    this->Close();
+  }
 
-    // open and check if controlDict is readable
-    if (!io.Open(controlDictPath))
+  bool OpenForReading(const vtkStdString &path)
+  {
+    if ((this->File = fopen(path.c_str(), "rb")) == NULL)
       {
-      vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
-          << io.GetError().c_str());
-      this->Parent->SetErrorCode(vtkErrorCode::CannotOpenFileError);
       return false;
       }
-    vtkFoamDict dict;
-    if (!dict.Read(io))
+#if VTK_FOAMFILE_USE_MMAP
+    struct stat fileStat;
+    const int fd = fileno(this->File);
+    if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
       {
-      vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
-          << " of " << io.GetFileName().c_str() << ": " << io.GetError().c_str());
-      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+      const size_t mapSize = static_cast<size_t>(fileStat.st_size);
+      void *mapPtr = mmap(NULL, mapSize, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapPtr != MAP_FAILED)
+        {
+#if defined(MADV_SEQUENTIAL)
+        madvise(mapPtr, mapSize, MADV_SEQUENTIAL);
+#endif
+        this->Map = static_cast<const unsigned char *>(mapPtr);
+        this->MapSize = mapSize;
+        }
+      }
+#endif
+    return true;
+  }
+  // write to a temporary file first so that a cache being read is
+  // never seen half-written
+  bool OpenForWriting(const vtkStdString &path)
+  {
+    vtksys_ios::ostringstream tempPath;
+    tempPath << path.c_str() << ".";
+#if !(defined(_WIN32) && !defined(__CYGWIN__) || defined(__LIBCATAMOUNT__))
+    tempPath << getpid() << ".";
+#endif
+    tempPath << "tmp";
+    this->Path = path;
+    this->TempPath = tempPath.str();
+    return (this->File = fopen(this->TempPath.c_str(), "wb")) != NULL;
+  }
+  // replace the file with the temporary file if all the records have
+  // been written. Returns false if the file has not been replaced.
+  bool Commit(const bool isWritten)
+  {
+    const bool isClosed = this->Close();
+    // rename() does not replace an existing file on Windows
+    if (!isWritten || !isClosed
+        || (rename(this->TempPath.c_str(), this->Path.c_str()) != 0
+        && (remove(this->Path.c_str()) != 0
+        || rename(this->TempPath.c_str(), this->Path.c_str()) != 0)))
+      {
+      remove(this->TempPath.c_str());
       return false;
       }
-    if (dict.GetType() != vtkFoamToken::DICTIONARY)
+    return true;
+  }
+  // returns false if flushing the written records has failed
+  bool Close()
+  {
+#if VTK_FOAMFILE_USE_MMAP
+    if (this->Map != NULL)
       {
-      vtkErrorMacro(<<"The file type of " << io.GetFileName().c_str()
-          << " is not a dictionary");
-      this->Parent->SetErrorCode(vtkErrorCode::UnrecognizedFileTypeError);
-      return false;
+      munmap(const_cast<unsigned char *>(this->Map), this->MapSize);
+      this->Map = NULL;
       }
-
-    const vtkFoamEntry *writeControlEntry = dict.Lookup("writeControl");
-    if (writeControlEntry == NULL)
+#endif
+    bool isClosed = true;
+    if (this->File != NULL)
       {
-      vtkErrorMacro(<< "writeControl entry not found in "
-          << io.GetFileName().c_str());
-      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-      return false;
+      isClosed = (fclose(this->File) == 0);
+      this->File = NULL;
       }
-    const vtkStdString writeControl(writeControlEntry->ToWord());
+    return isClosed;
+  }
 
-    // empty if not found
-    const vtkFoamEntry *adjustTimeStepEntry = dict.Lookup("adjustTimeStep");
-    const vtkStdString
-        adjustTimeStep = adjustTimeStepEntry == NULL ? vtkStdString()
-            : adjustTimeStepEntry->ToWord();
+  bool WriteRecord(const void *ptr, const size_t size)
+  {
+    const vtkTypeUInt64 size64 = size;
+    return fwrite(&size64, sizeof(size64), 1, this->File) == 1
+        && (size == 0 || fwrite(ptr, size, 1, this->File) == 1);
+  }
+  bool WriteString(const vtkStdString &str)
+  {
+    return this->WriteRecord(str.c_str(), str.length());
+  }
+  bool WriteArray(vtkDataArray *array)
+  {
+    return this->WriteRecord(array->GetVoidPointer(0),
+        static_cast<size_t>(array->GetNumberOfTuples())
+        * array->GetNumberOfComponents() * array->GetDataTypeSize());
+  }
+  bool WriteIntVectorVector(vtkFoamIntVectorVector *ivv)
+  {
+    return this->WriteArray(ivv->GetIndices())
+        && this->WriteArray(ivv->GetBody());
+  }
 
-    // list time directories according to controlDict if (adjustTimeStep
-    // writeControl) == (off, timeStep) or (on, adjustableRunTime); list
-    // by time instances in the case directory otherwise (different behavior
-    // from paraFoam)
-    // valid switching words cf. src/OpenFOAM/db/Switch/Switch.C
-    if ((((adjustTimeStep == "off" || adjustTimeStep == "no" || adjustTimeStep
-        == "n" || adjustTimeStep == "false" || adjustTimeStep == "")
-        && writeControl == "timeStep") || ((adjustTimeStep == "on"
-        || adjustTimeStep == "yes" || adjustTimeStep == "y" || adjustTimeStep
-        == "true") && writeControl == "adjustableRunTime")))
+  bool ReadRecord(void *ptr, const size_t size)
+  {
+    size_t recordSize;
+    return this->ReadRecordSize(recordSize) && recordSize == size
+        && this->ReadBytes(ptr, size);
+  }
+  bool ReadString(vtkStdString &str)
+  {
+    size_t size;
+    if (!this->ReadRecordSize(size))
       {
-      ret = this->ListTimeDirectoriesByControlDict(&dict);
+      return false;
       }
-    else
+    str.resize(size);
+    return size == 0 || this->ReadBytes(&str[0], size);
+  }
+  // the number of components has to be set beforehand
+  bool ReadArray(vtkDataArray *array)
+  {
+    size_t size;
+    const size_t tupleSize = static_cast<size_t>(
+        array->GetNumberOfComponents()) * array->GetDataTypeSize();
+    if (!this->ReadRecordSize(size) || size % tupleSize != 0
+        || size / tupleSize > static_cast<size_t>(VTK_ID_MAX))
       {
-      ret = this->ListTimeDirectoriesByInstances();
+      return false;
       }
-    }
-  else
+    array->SetNumberOfTuples(static_cast<vtkIdType>(size / tupleSize));
+    return size == 0 || this->ReadBytes(array->GetVoidPointer(0), size);
+  }
+  bool ReadIntVectorVector(vtkFoamIntVectorVector *ivv)
+  {
+    return this->ReadArray(ivv->GetIndices())
+        && ivv->GetIndices()->GetNumberOfTuples() > 0
+        && this->ReadArray(ivv->GetBody());
+  }
+};
+
+//-----------------------------------------------------------------------------
+// the key of the mesh cache: the sizes and modification times of the
+// mesh files plus the reader options the internal mesh depends on. The
+// points are those in the faces directory so that a mesh moving at the
+// later timesteps is still restored from the cache, and then moved.
+vtkStdString vtkOFFReaderPrivate::MeshCacheKey(const vtkStdString &meshDir)
+{
+  const int byteOrderProbe = 1;
+  vtksys_ios::ostringstream key;
+  key << "vtkOFFReader mesh cache 2 byteOrder "
+      << static_cast<int>(*reinterpret_cast<const char *>(&byteOrderProbe))
+      << " idType " << sizeof(vtkIdType)
+      << " decomposePolyhedra " << this->Parent->GetDecomposePolyhedra()
+      << " singlePrecisionBinary "
+      << this->Parent->GetIsSinglePrecisionBinary();
+
+  const vtkStdString paths[] = {meshDir + "boundary", meshDir + "faces",
+      meshDir + "owner", meshDir + "neighbour", meshDir + "points"};
+  for (size_t pathI = 0; pathI < sizeof(paths) / sizeof(paths[0]); pathI++)
     {
-    ret = this->ListTimeDirectoriesByInstances();
+    vtkStdString path(paths[pathI]);
+    if (!vtksys::SystemTools::FileExists(path.c_str(), true))
+      {
+      path += ".gz";
+      }
+    key << "\n" << path << " " << vtksys::SystemTools::FileLength(path.c_str())
+        << " " << vtksys::SystemTools::ModifiedTime(path.c_str());
     }
+  return key.str();
+}
 
-  if (!ret)
+//-----------------------------------------------------------------------------
+// the sizes and modification times of the mesh files of a timestep, by
+// which a mesh kept across a refresh is checked for files rewritten in
+// place
+vtkStdString vtkOFFReaderPrivate::MeshFilesKey(const int timeI)
+{
+  if (this->PolyMeshFacesDir->GetValue(timeI) == "")
     {
-    return ret;
+    return vtkStdString();
     }
-
-  // does not seem to be required even if number of timesteps reduced
-  // upon refresh since ParaView rewinds TimeStep to 0, but for precaution
-  if (this->TimeValues->GetNumberOfTuples() > 0)
+  // the key of the faces directory covers the points there
+  vtksys_ios::ostringstream key;
+  key << this->MeshCacheKey(
+      this->TimeRegionMeshPath(this->PolyMeshFacesDir, timeI)).c_str();
+  if (this->PolyMeshPointsDir->GetValue(timeI) != "")
     {
-    if (this->TimeStep >= this->TimeValues->GetNumberOfTuples())
+    vtkStdString path(this->TimeRegionMeshPath(this->PolyMeshPointsDir, timeI)
+        + "points");
+    if (!vtksys::SystemTools::FileExists(path.c_str(), true))
       {
-      this->SetTimeStep(this->TimeValues->GetNumberOfTuples() - 1);
+      path += ".gz";
       }
+    key << "\n" << path << " " << vtksys::SystemTools::FileLength(path.c_str())
+        << " " << vtksys::SystemTools::ModifiedTime(path.c_str());
     }
-  else
+  return key.str();
+}
+
+//-----------------------------------------------------------------------------
+// the cache file of a mesh or a case directory, named by the FNV-1a
+// hash of the directory path
+vtkStdString vtkOFFReaderPrivate::CachePath(const vtkStdString &dirPath,
+    const char *extension)
+{
+  vtkTypeUInt64 hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < dirPath.length(); i++)
     {
-    this->SetTimeStep(0);
+    hash = (hash ^ static_cast<unsigned char>(dirPath[i]))
+        * 1099511628211ULL;
+    }
+  char name[17];
+  for (int i = 15; i >= 0; i--, hash >>= 4)
+    {
+    name[i] = "0123456789abcdef"[hash & 0xf];
     }
+  name[16] = '\0';
+  return vtkStdString(this->Parent->GetMeshCacheDirectory()) + "/" + name
+      + extension;
+}
 
-  this->PopulatePolyMeshDirArrays();
-  return ret;
+//-----------------------------------------------------------------------------
+bool vtkOFFReaderPrivate::MakeCacheDirectory()
+{
+  const vtkStdString cacheDir(this->Parent->GetMeshCacheDirectory());
+  if (!vtksys::SystemTools::FileIsDirectory(cacheDir.c_str())
+      && !vtksys::SystemTools::MakeDirectory(cacheDir.c_str()))
+    {
+    vtkWarningMacro(<< "Can't create cache directory " << cacheDir.c_str());
+    return false;
+    }
+  return true;
 }
 
 //-----------------------------------------------------------------------------
-void vtkOFFReaderPrivate::AppendMeshDirToArray(
-    vtkStringArray* polyMeshDir, const vtkStdString &path,
-    const vtkStdString &fileName, const int timeI)
+// the validation of the arrays restored from a mesh cache, which may
+// have been truncated or overwritten by anything. Returns true if the
+// nElements lists of a vtkFoamIntVectorVector are consecutive and
+// hold values in [0, maxValue).
+static bool vtkFoamIsValidCache(vtkFoamIntVectorVector *ivv,
+    const vtkIdType nElements, const vtkIdType maxValue)
 {
-  vtkFoamIOobject io(this->CasePath,
-      this->Parent->GetIsSinglePrecisionBinary() != 0);
-  vtkStdString filePath(path + fileName);
-  if (io.Open(filePath) || io.Open(filePath + ".gz"))
+  if (ivv->GetNumberOfElements() != nElements)
     {
-    io.Close();
-    // set points/faces location to current timesteps value
-    polyMeshDir->SetValue(timeI, this->TimeNames->GetValue(timeI));
+    return false;
     }
-  else
+  const vtkIdType *indices = ivv->GetIndices()->GetPointer(0);
+  const vtkIdType *body = ivv->GetBody()->GetPointer(0);
+  if (indices[0] != 0
+      || indices[nElements] != ivv->GetBody()->GetNumberOfTuples())
     {
-    if (timeI != 0)
+    return false;
+    }
+  for (vtkIdType elementI = 0; elementI < nElements; elementI++)
+    {
+    if (indices[elementI] > indices[elementI + 1])
       {
-      // set points/faces location to previous timesteps value
-      polyMeshDir->SetValue(timeI, polyMeshDir->GetValue(timeI - 1));
+      return false;
       }
-    else
+    }
+  for (vtkIdType bodyI = 0; bodyI < indices[nElements]; bodyI++)
+    {
+    if (body[bodyI] < 0 || body[bodyI] >= maxValue)
       {
-      filePath = this->CasePath + "constant" + this->RegionPath()
-          + "/polyMesh/" + fileName;
-      if(io.Open(filePath) || io.Open(filePath + ".gz"))
-        {
-        // set points/faces to constant
-        polyMeshDir->SetValue(timeI, "constant");
-        }
+      return false;
       }
     }
+  return true;
 }
 
-//-----------------------------------------------------------------------------
-// create a Lookup Table containing the location of the points
-// and faces files for each time steps mesh
-void vtkOFFReaderPrivate::PopulatePolyMeshDirArrays()
+// the same for the cell array and the polyhedron face streams of an
+// unstructured grid. A cell location of -1 marks a cell without a
+// face stream.
+static bool vtkFoamIsValidCache(vtkIdTypeArray *locationsArray,
+    vtkIdTypeArray *connectivityArray, const bool isFaceStream,
+    const vtkIdType maxPointId)
 {
-  // intialize size to number of timesteps
-  const int nSteps = this->TimeValues->GetNumberOfTuples();
-  this->PolyMeshPointsDir->SetNumberOfValues(nSteps);
-  this->PolyMeshFacesDir->SetNumberOfValues(nSteps);
-
-  // loop through each timestep
-  for (int i = 0; i < nSteps; i++)
+  const vtkIdType nCells = locationsArray->GetNumberOfTuples();
+  const vtkIdType size = connectivityArray->GetNumberOfTuples();
+  const vtkIdType *locations = locationsArray->GetPointer(0);
+  const vtkIdType *connectivity = connectivityArray->GetPointer(0);
+  for (vtkIdType cellI = 0; cellI < nCells; cellI++)
     {
-    // create the path to the timestep
-    vtkStdString polyMeshPath = this->TimeRegionPath(i) + "/polyMesh/";
-    AppendMeshDirToArray(this->PolyMeshPointsDir, polyMeshPath, "points", i);
-    AppendMeshDirToArray(this->PolyMeshFacesDir, polyMeshPath, "faces", i);
+    vtkIdType i = locations[cellI];
+    if (isFaceStream && i == -1)
+      {
+      continue;
+      }
+    if (i < 0 || i >= size)
+      {
+      return false;
+      }
+    // a face stream is a list of faces, each a list of points
+    const vtkIdType nFaces = isFaceStream ? connectivity[i++] : 1;
+    if (nFaces < 0)
+      {
+      return false;
+      }
+    for (vtkIdType faceI = 0; faceI < nFaces; faceI++)
+      {
+      if (i >= size)
+        {
+        return false;
+        }
+      const vtkIdType nPoints = connectivity[i++];
+      if (nPoints < 0 || nPoints > size - i)
+        {
+        return false;
+        }
+      for (const vtkIdType end = i + nPoints; i < end; i++)
+        {
+        if (connectivity[i] < 0 || connectivity[i] >= maxPointId)
+          {
+          return false;
+          }
+        }
+      }
     }
-  return;
+  return true;
 }
 
 //-----------------------------------------------------------------------------
-// read the points file into a vtkFloatArray
-vtkFloatArray* vtkOFFReaderPrivate::ReadPointsFile()
+// restore the internal mesh and its topology from the mesh cache.
+// Returns the faces list of the boundary faces, the first of which is
+// face faceOffset, or NULL if there is no valid cache for the mesh.
+vtkFoamIntVectorVector *vtkOFFReaderPrivate::ReadMeshCache(
+    const vtkStdString &meshDir, vtkIdType &faceOffset)
 {
-  if (this->PolyMeshPointsDir->GetValue(this->TimeStep) == "")
+  vtkFoamMeshCacheFile file;
+  if (!file.OpenForReading(this->CachePath(meshDir, ".vtkfoammesh")))
+    {
+    return NULL;
+    }
+  // a stale cache is silently rebuilt
+  vtkStdString key;
+  if (!file.ReadString(key) || key != this->MeshCacheKey(meshDir))
     {
-    vtkErrorMacro(<<"Cannot find path to points file for region \""
-        << this->RegionName.c_str() << "\" in case " << this->CasePath.c_str());
-    this->Parent->SetErrorCode(vtkErrorCode::UnknownError);
     return NULL;
     }
 
-  // path to points file
-  const vtkStdString pointPath =
-      this->CurrentTimeRegionMeshPath(this->PolyMeshPointsDir) + "points";
+  // NumPoints, NumCells, NumTotalAdditionalCells, the first boundary
+  // face and whether the polyhedron faces and the point cells follow
+  vtkTypeInt64 sizes[6];
+  vtkFloatArray *pointArray = vtkFloatArray::New();
+  pointArray->SetNumberOfComponents(3);
+  vtkUnsignedCharArray *cellTypesArray = vtkUnsignedCharArray::New();
+  vtkIdTypeArray *cellLocationsArray = vtkIdTypeArray::New();
+  vtkIdTypeArray *connectivityArray = vtkIdTypeArray::New();
+  vtkIdTypeArray *faceLocationsArray = vtkIdTypeArray::New();
+  vtkIdTypeArray *facesArray = vtkIdTypeArray::New();
+  vtkIdTypeArray *faceOwner = vtkIdTypeArray::New();
+  vtkIdTypeArray *additionalCellIds = vtkIdTypeArray::New();
+  vtkIntArray *numAdditionalCells = vtkIntArray::New();
+  vtkFoamIntVectorVector *additionalCellPoints = new vtkFoamIntVectorVector;
+  vtkFoamIntVectorVector *boundaryFacesPoints = new vtkFoamIntVectorVector;
+  vtkFoamIntVectorVector *pointCells = new vtkFoamIntVectorVector;
+  const bool decomposePolyhedra = (this->Parent->GetDecomposePolyhedra() != 0);
+
+  bool isRead = file.ReadRecord(sizes, sizeof(sizes))
+      && file.ReadArray(pointArray) && file.ReadArray(cellTypesArray)
+      && file.ReadArray(cellLocationsArray)
+      && file.ReadArray(connectivityArray)
+      && (!sizes[4] || (file.ReadArray(faceLocationsArray)
+      && file.ReadArray(facesArray))) && file.ReadArray(faceOwner)
+      && (!decomposePolyhedra || (file.ReadArray(additionalCellIds)
+      && file.ReadArray(numAdditionalCells)
+      && file.ReadIntVectorVector(additionalCellPoints)))
+      && file.ReadIntVectorVector(boundaryFacesPoints)
+      && (!sizes[5] || file.ReadIntVectorVector(pointCells));
+  isRead = isRead && sizes[0] >= 0 && sizes[0] <= VTK_ID_MAX
+      && sizes[1] >= 0 && sizes[1] <= VTK_ID_MAX && sizes[2] >= 0
+      && sizes[2] <= VTK_ID_MAX - sizes[1] && sizes[3] >= 0
+      && sizes[3] <= VTK_ID_MAX;
+  const vtkIdType nTotalCells = isRead ? sizes[1] + sizes[2] : 0;
+
+  // the decomposed polyhedra: the cell ids in ascending order, the
+  // numbers of their additional cells summing up to the total number
+  // of the additional cells, and their point lists, whose centroids
+  // follow the points
+  const vtkIdType nPolyhedra = decomposePolyhedra
+      ? additionalCellIds->GetNumberOfTuples() : 0;
+  if (isRead && decomposePolyhedra)
+    {
+    isRead = numAdditionalCells->GetNumberOfTuples() == nPolyhedra
+        && vtkFoamIsValidCache(additionalCellPoints, nPolyhedra, sizes[0]);
+    vtkTypeInt64 nAdditionalCells = 0;
+    for (vtkIdType polyI = 0; isRead && polyI < nPolyhedra; polyI++)
+      {
+      const vtkIdType cellId = additionalCellIds->GetValue(polyI);
+      const int n = numAdditionalCells->GetValue(polyI);
+      isRead = cellId >= 0 && cellId < sizes[1] && n >= 0
+          && (polyI == 0 || cellId > additionalCellIds->GetValue(polyI - 1));
+      nAdditionalCells += n;
+      }
+    isRead = isRead && nAdditionalCells == sizes[2];
+    }
+  else if (isRead)
+    {
+    isRead = sizes[2] == 0;
+    }
+
+  const vtkIdType nTotalPoints = sizes[0] + nPolyhedra;
+  isRead = isRead && pointArray->GetNumberOfTuples() == nTotalPoints
+      && cellTypesArray->GetNumberOfTuples() == nTotalCells
+      && cellLocationsArray->GetNumberOfTuples() == nTotalCells
+      && vtkFoamIsValidCache(cellLocationsArray, connectivityArray, false,
+      nTotalPoints)
+      && (!sizes[4] || (faceLocationsArray->GetNumberOfTuples() == nTotalCells
+      && vtkFoamIsValidCache(faceLocationsArray, facesArray, true,
+      nTotalPoints)))
+      && vtkFoamIsValidCache(boundaryFacesPoints,
+      faceOwner->GetNumberOfTuples(), sizes[0])
+      && (!sizes[5] || vtkFoamIsValidCache(pointCells, sizes[0], sizes[1]));
+  for (vtkIdType faceI = 0; isRead && faceI < faceOwner->GetNumberOfTuples();
+      faceI++)
+    {
+    const vtkIdType cellId = faceOwner->GetValue(faceI);
+    isRead = cellId >= 0 && cellId < sizes[1];
+    }
+  for (vtkIdType cellI = 0; isRead && cellI < nTotalCells; cellI++)
+    {
+    isRead = cellTypesArray->GetValue(cellI) < VTK_NUMBER_OF_CELL_TYPES;
+    }
+  // the patches are to be found in the boundary faces
+  for (size_t patchI = 0; isRead && patchI < this->BoundaryDict.size();
+      patchI++)
+    {
+    const vtkFoamBoundaryEntry &beI = this->BoundaryDict[patchI];
+    isRead = beI.StartFace >= sizes[3] && beI.NFaces >= 0
+        && static_cast<vtkTypeInt64>(beI.StartFace) + beI.NFaces - sizes[3]
+        <= boundaryFacesPoints->GetNumberOfElements();
+    }
+  file.Close();
+
+  if (isRead)
+    {
+    this->NumPoints = sizes[0];
+    this->NumCells = sizes[1];
+    this->NumTotalAdditionalCells = sizes[2];
+    faceOffset = sizes[3];
+
+    this->InternalMesh = vtkUnstructuredGrid::New();
+    vtkCellArray *cells = vtkCellArray::New();
+    cells->SetCells(nTotalCells, connectivityArray);
+    if (sizes[4])
+      {
+      this->InternalMesh->SetCells(cellTypesArray, cellLocationsArray, cells,
+          faceLocationsArray, facesArray);
+      }
+    else
+      {
+      this->InternalMesh->SetCells(cellTypesArray, cellLocationsArray, cells);
+      }
+    cells->Delete();
+    vtkPoints *points = vtkPoints::New();
+    points->SetData(pointArray);
+    this->InternalMesh->SetPoints(points);
+    points->Delete();
 
-  vtkFoamIOobject io(this->CasePath,
-      this->Parent->GetIsSinglePrecisionBinary() != 0);
-  if (!(io.Open(pointPath) || io.Open(pointPath + ".gz")))
+    this->FaceOwner = faceOwner;
+    faceOwner = NULL;
+    if (decomposePolyhedra)
+      {
+      this->AdditionalCellIds = additionalCellIds;
+      this->NumAdditionalCells = numAdditionalCells;
+      this->AdditionalCellPoints = additionalCellPoints;
+      additionalCellIds = NULL;
+      numAdditionalCells = NULL;
+      additionalCellPoints = NULL;
+      }
+    if (sizes[5])
+      {
+      this->PointCells = pointCells;
+      pointCells = NULL;
+      }
+    }
+  else
     {
-    vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
-        << io.GetError().c_str());
-    this->Parent->SetErrorCode(vtkErrorCode::CannotOpenFileError);
-    return NULL;
+    vtkWarningMacro(<< "Ignoring broken mesh cache "
+        << this->CachePath(meshDir, ".vtkfoammesh").c_str());
+    delete boundaryFacesPoints;
+    boundaryFacesPoints = NULL;
     }
 
-  vtkFoamEntryValue dict(NULL);
-  try
+  pointArray->Delete();
+  cellTypesArray->Delete();
+  cellLocationsArray->Delete();
+  connectivityArray->Delete();
+  faceLocationsArray->Delete();
+  facesArray->Delete();
+  if (faceOwner != NULL)
     {
-    dict.ReadNonuniformList<vtkFoamToken::VECTORLIST,
-    vtkFoamEntryValue::vectorListTraits<vtkFloatArray, float, 3, false> >(io);
+    faceOwner->Delete();
     }
-  catch(vtkFoamError& e)
+  if (additionalCellIds != NULL)
     {
-    vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
-        << " of " << io.GetFileName().c_str() << ": " << e.c_str());
-    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-    return NULL;
+    additionalCellIds->Delete();
+    numAdditionalCells->Delete();
     }
-
-  vtkFloatArray *pointArray = static_cast<vtkFloatArray *>(dict.Ptr());
-
-  // set the number of points
-  this->NumPoints = pointArray->GetNumberOfTuples();
-
-  return pointArray;
+  delete additionalCellPoints;
+  delete pointCells;
+  return boundaryFacesPoints;
 }
 
 //-----------------------------------------------------------------------------
-// read the faces into a vtkFoamIntVectorVector
-vtkFoamIntVectorVector * vtkOFFReaderPrivate::ReadFacesFile(
-    const vtkStdString &facePathIn)
+// store the internal mesh just built and its topology to the mesh
+// cache. FaceOwner must have been truncated to the boundary faces.
+void vtkOFFReaderPrivate::WriteMeshCache(const vtkStdString &meshDir,
+    const vtkFoamIntVectorVector *facesPoints)
 {
-  const vtkStdString facePath(facePathIn + "faces");
-
-  vtkFoamIOobject io(this->CasePath,
-      this->Parent->GetIsSinglePrecisionBinary() != 0);
-  if (!(io.Open(facePath) || io.Open(facePath + ".gz")))
+  // the cell-to-point adjacency is built now to be cached as well
+  if (this->Parent->GetCreateCellToPoint() && this->PointCells == NULL)
     {
-    vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
-        << io.GetError().c_str() << ". If you are trying to read a parallel "
-        "decomposed case, set Case Type to Decomposed Case.");
-    this->Parent->SetErrorCode(vtkErrorCode::CannotOpenFileError);
-    return NULL;
+    this->BuildPointCells();
     }
 
-  vtkFoamEntryValue dict(NULL);
-  try
+  if (!this->MakeCacheDirectory())
     {
-    if (io.GetClassName() == "faceCompactList")
-      {
-      dict.ReadCompactIOLabelList(io);
-      }
-    else
-      {
-      dict.ReadLabelListList(io);
-      }
+    return;
     }
-  catch(vtkFoamError& e)
-    {
-    vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
-        << " of " << io.GetFileName().c_str() << ": " << e.c_str());
-    this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-    return NULL;
+
+  // the boundary faces as a faces list of their own
+  const vtkIdType nFaces = facesPoints->GetNumberOfElements();
+  const vtkIdType boundaryStartFace = this->BoundaryDict.size() > 0
+      ? this->BoundaryDict[0].StartFace : nFaces;
+  const vtkIdType *boundaryBody = facesPoints->operator[](boundaryStartFace);
+  vtkstd::vector<vtkIdType> boundaryIndices(nFaces - boundaryStartFace + 1);
+  for (vtkIdType faceI = boundaryStartFace; faceI <= nFaces; faceI++)
+    {
+    boundaryIndices[faceI - boundaryStartFace]
+        = facesPoints->operator[](faceI) - boundaryBody;
+    }
+
+  vtkIdTypeArray *facesArray = this->InternalMesh->GetFaces();
+  const vtkTypeInt64 sizes[6] = {this->NumPoints, this->NumCells,
+      this->NumTotalAdditionalCells, boundaryStartFace, facesArray != NULL,
+      this->PointCells != NULL};
+
+  const vtkStdString cachePath(this->CachePath(meshDir, ".vtkfoammesh"));
+  vtkFoamMeshCacheFile file;
+  bool isWritten = file.OpenForWriting(cachePath);
+  isWritten = isWritten && file.WriteString(this->MeshCacheKey(meshDir))
+      && file.WriteRecord(sizes, sizeof(sizes))
+      && file.WriteArray(this->InternalMesh->GetPoints()->GetData())
+      && file.WriteArray(this->InternalMesh->GetCellTypesArray())
+      && file.WriteArray(this->InternalMesh->GetCellLocationsArray())
+      && file.WriteArray(this->InternalMesh->GetCells()->GetData())
+      && (facesArray == NULL
+      || (file.WriteArray(this->InternalMesh->GetFaceLocations())
+      && file.WriteArray(facesArray))) && file.WriteArray(this->FaceOwner)
+      && (this->AdditionalCellPoints == NULL
+      || (file.WriteArray(this->AdditionalCellIds)
+      && file.WriteArray(this->NumAdditionalCells)
+      && file.WriteIntVectorVector(this->AdditionalCellPoints)))
+      && file.WriteRecord(&boundaryIndices[0],
+      boundaryIndices.size() * sizeof(vtkIdType))
+      && file.WriteRecord(boundaryBody, (facesPoints->operator[](nFaces)
+      - boundaryBody) * sizeof(vtkIdType))
+      && (this->PointCells == NULL
+      || file.WriteIntVectorVector(this->PointCells));
+  if (!file.Commit(isWritten))
+    {
+    vtkWarningMacro(<< "Can't write mesh cache " << cachePath.c_str());
     }
-  return static_cast<vtkFoamIntVectorVector *>(dict.Ptr());
 }
 
 //-----------------------------------------------------------------------------
-// read the owner and neighbor file and create cellFaces
-vtkFoamIntVectorVector * vtkOFFReaderPrivate::ReadOwnerNeighborFiles(
-    const vtkStdString &ownerNeighborPath, vtkFoamIntVectorVector *facePoints)
+// the key of the case index, which also names the index file
+vtkStdString vtkOFFReaderPrivate::CaseIndexKey()
 {
-  vtkFoamIOobject io(this->CasePath,
-      this->Parent->GetIsSinglePrecisionBinary() != 0);
-  vtkStdString ownerPath(ownerNeighborPath + "owner");
-  if (io.Open(ownerPath) || io.Open(ownerPath + ".gz"))
-    {
-    vtkFoamEntryValue ownerDict(NULL);
-    try
-      {
-      ownerDict.ReadNonuniformList<vtkFoamToken::LABELLIST,
-      vtkFoamEntryValue::listTraits<vtkIntArray, int> >(io);
-      }
-    catch(vtkFoamError& e)
-      {
-      vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
-          << " of " << io.GetFileName().c_str() << ": " << e.c_str());
-      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-      return NULL;
-      }
+  return "vtkOFFReader case index 2\n"
+      + vtksys::SystemTools::CollapseFullPath(this->CasePath.c_str());
+}
 
-    io.Close();
+//-----------------------------------------------------------------------------
+// restore the case index from the cache directory. The entries
+// already in the index are retained.
+void vtkOFFReaderPrivate::ReadCaseIndex()
+{
+  this->CaseIndex->IsRead = true;
 
-    const vtkStdString neighborPath(ownerNeighborPath + "neighbour");
-    if (!(io.Open(neighborPath) || io.Open(neighborPath + ".gz")))
-      {
-      vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
-          << io.GetError().c_str());
-      this->Parent->SetErrorCode(vtkErrorCode::CannotOpenFileError);
-      return NULL;
+  const vtkStdString key(this->CaseIndexKey());
+  const vtkStdString indexPath(this->CachePath(key, ".vtkfoamindex"));
+  vtkFoamMeshCacheFile file;
+  vtkStdString fileKey;
+  if (!file.OpenForReading(indexPath) || !file.ReadString(fileKey)
+      || fileKey != key)
+    {
+    return;
+    }
+
+  // each entry consists of the directory path relative to the case,
+  // the modification time, whether the headers have been read, the
+  // numbers of the subdirectories and the headers, the names of the
+  // subdirectories and the file, class and object names, the sizes and
+  // the modification times of the headers
+  vtkFoamCaseIndex::vtkFoamDirMap dirs;
+  vtkTypeInt64 nEntries;
+  bool isRead = file.ReadRecord(&nEntries, sizeof(nEntries));
+  for (vtkTypeInt64 entryI = 0; isRead && entryI < nEntries; entryI++)
+    {
+    vtkStdString dirPath;
+    vtkTypeInt64 sizes[4];
+    isRead = file.ReadString(dirPath) && file.ReadRecord(sizes, sizeof(sizes));
+    if (!isRead)
+      {
+      break;
       }
-
-    vtkFoamEntryValue neighborDict(NULL);
-    try
+    vtkFoamCaseIndex::vtkFoamDirEntry &entry = dirs[this->CasePath + dirPath];
+    entry.MTime = static_cast<long>(sizes[0]);
+    entry.HasHeaders = (sizes[1] != 0);
+    for (vtkTypeInt64 dirI = 0; isRead && dirI < sizes[2]; dirI++)
       {
-      neighborDict.ReadNonuniformList<vtkFoamToken::LABELLIST,
-      vtkFoamEntryValue::listTraits<vtkIntArray, int> >(io);
+      entry.SubDirs.push_back(vtkStdString());
+      isRead = file.ReadString(entry.SubDirs.back());
       }
-    catch(vtkFoamError& e)
+    for (vtkTypeInt64 headerI = 0; isRead && headerI < sizes[3]; headerI++)
       {
-      vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
-          << " of " << io.GetFileName().c_str() << ": " << e.c_str());
-      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-      return NULL;
+      entry.Headers.push_back(vtkFoamCaseIndex::vtkFoamFileHeader());
+      vtkFoamCaseIndex::vtkFoamFileHeader &header = entry.Headers.back();
+      vtkTypeInt64 times[2] = {0, -1};
+      isRead = file.ReadString(header.FileName)
+          && file.ReadString(header.ClassName)
+          && file.ReadString(header.ObjectName)
+          && file.ReadRecord(times, sizeof(times));
+      header.Length = static_cast<unsigned long>(times[0]);
+      header.MTime = static_cast<long>(times[1]);
       }
+    }
+  file.Close();
 
-    this->FaceOwner = static_cast<vtkIntArray *>(ownerDict.Ptr());
-    vtkIntArray &faceOwner = *this->FaceOwner;
-    vtkIntArray &faceNeighbor = neighborDict.LabelList();
+  if (!isRead)
+    {
+    vtkWarningMacro(<< "Ignoring broken case index " << indexPath.c_str());
+    return;
+    }
+  for (vtkFoamCaseIndex::vtkFoamDirMap::iterator dirI = dirs.begin();
+      dirI != dirs.end(); ++dirI)
+    {
+    this->CaseIndex->Dirs.insert(*dirI);
+    }
+}
 
-    const int nFaces = faceOwner.GetNumberOfTuples();
-    const int nNeiFaces = faceNeighbor.GetNumberOfTuples();
+//-----------------------------------------------------------------------------
+// store the case index to the cache directory if it has been modified
+void vtkOFFReaderPrivate::WriteCaseIndex()
+{
+  const char *cacheDir = this->Parent->GetMeshCacheDirectory();
+  if (!this->CaseIndex->IsModified || cacheDir == NULL || *cacheDir == '\0'
+      || !this->MakeCacheDirectory())
+    {
+    return;
+    }
+  this->CaseIndex->IsModified = false;
 
-    if (nFaces < nNeiFaces)
+  // the entries to be rescanned anyway are not stored
+  const size_t casePathLength = this->CasePath.length();
+  vtkstd::vector<const vtkFoamCaseIndex::vtkFoamDirMap::value_type *> dirs;
+  for (vtkFoamCaseIndex::vtkFoamDirMap::const_iterator dirI
+      = this->CaseIndex->Dirs.begin(); dirI != this->CaseIndex->Dirs.end();
+      ++dirI)
+    {
+    if (dirI->second.MTime != -1
+        && dirI->first.compare(0, casePathLength, this->CasePath) == 0)
       {
-      vtkErrorMacro(<<"Number of owner faces " << nFaces
-          << " must be equal or larger than number of neighbor faces "
-          << nNeiFaces);
-      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-      return NULL;
+      dirs.push_back(&*dirI);
       }
+    }
 
-    // the number of owner faces can be smaller than the number of
-    // faces in sliding mesh cases
-    if (nFaces > facePoints->GetNumberOfElements())
+  const vtkStdString key(this->CaseIndexKey());
+  const vtkStdString indexPath(this->CachePath(key, ".vtkfoamindex"));
+  const vtkTypeInt64 nEntries = static_cast<vtkTypeInt64>(dirs.size());
+  vtkFoamMeshCacheFile file;
+  bool isWritten = file.OpenForWriting(indexPath) && file.WriteString(key)
+      && file.WriteRecord(&nEntries, sizeof(nEntries));
+  for (size_t entryI = 0; isWritten && entryI < dirs.size(); entryI++)
+    {
+    const vtkFoamCaseIndex::vtkFoamDirEntry &entry = dirs[entryI]->second;
+    const vtkTypeInt64 sizes[4] = {entry.MTime, entry.HasHeaders,
+        static_cast<vtkTypeInt64>(entry.SubDirs.size()),
+        static_cast<vtkTypeInt64>(entry.Headers.size())};
+    isWritten = file.WriteString(dirs[entryI]->first.substr(casePathLength))
+        && file.WriteRecord(sizes, sizeof(sizes));
+    for (size_t dirI = 0; isWritten && dirI < entry.SubDirs.size(); dirI++)
       {
-      vtkWarningMacro(<<"Number of faces in faces "
-          << facePoints->GetNumberOfElements()
-          << " must be equal or larger than number of owner faces "
-          << nFaces);
-      return NULL;
+      isWritten = file.WriteString(entry.SubDirs[dirI]);
       }
-
-    // add the face numbers to the correct cell cf. Terry's code and
-    // src/OpenFOAM/meshes/primitiveMesh/primitiveMeshCells.C
-    // find the number of cells
-    int nCells = -1;
-    for (int faceI = 0; faceI < nNeiFaces; faceI++)
+    for (size_t headerI = 0; isWritten && headerI < entry.Headers.size();
+        headerI++)
       {
-      const int ownerCell = faceOwner.GetValue(faceI);
-      if (nCells < ownerCell) // max(nCells, faceOwner[i])
-        {
-        nCells = ownerCell;
-        }
-      // we do need to take neighbor faces into account since all the
-      // surrounding faces of a cell can be neighbors for a valid mesh
-      const int neighborCell = faceNeighbor.GetValue(faceI);
-      if (nCells < neighborCell) // max(nCells, faceNeighbor[i])
-        {
-        nCells = neighborCell;
-        }
+      const vtkFoamCaseIndex::vtkFoamFileHeader &header
+          = entry.Headers[headerI];
+      const vtkTypeInt64 times[2] = {
+          static_cast<vtkTypeInt64>(header.Length), header.MTime};
+      isWritten = file.WriteString(header.FileName)
+          && file.WriteString(header.ClassName)
+          && file.WriteString(header.ObjectName)
+          && file.WriteRecord(times, sizeof(times));
       }
-    for (int faceI = nNeiFaces; faceI < nFaces; faceI++)
+    }
+  if (!file.Commit(isWritten))
+    {
+    vtkWarningMacro(<< "Can't write case index " << indexPath.c_str());
+    }
+}
+
+//-----------------------------------------------------------------------------
+// determine the cell shape from the number of faces and face points
+// cf. src/OpenFOAM/meshes/meshShapes/cellMatcher/{hex|prism|pyr|tet}-
+// Matcher.C
+static int vtkFoamGetCellType(const vtkIdType *cellFaces,
+    const vtkIdType nCellFaces, const vtkFoamIntVectorVector &facePoints)
+{
+  int cellType = VTK_CONVEX_POINT_SET;
+  if (nCellFaces == 6)
+    {
+    vtkIdType j = 0;
+    for (; j < nCellFaces; j++)
       {
-      const int ownerCell = faceOwner.GetValue(faceI);
-      if (nCells < ownerCell) // max(nCells, faceOwner[i])
+      if (facePoints.GetSize(cellFaces[j]) != 4)
         {
-        nCells = ownerCell;
+        break;
         }
       }
-    nCells++;
-
-    if (nCells == 0)
-      {
-      vtkWarningMacro(<<"The mesh contains no cells");
-      }
-
-    // set the number of cells
-    this->NumCells = nCells;
-
-    // create cellFaces with the length of the body undetermined
-    vtkFoamIntVectorVector *cells = new vtkFoamIntVectorVector(nCells, 1);
-
-    // count number of faces for each cell
-    int *cfiPtr = cells->GetIndices()->GetPointer(0);
-    for (int cellI = 0; cellI <= nCells; cellI++)
+    if (j == nCellFaces)
       {
-      cfiPtr[cellI] = 0;
+      cellType = VTK_HEXAHEDRON;
       }
-    int nTotalCellFaces = 0;
-    cfiPtr++; // offset +1
-    for (int faceI = 0; faceI < nNeiFaces; faceI++)
+    }
+  else if (nCellFaces == 5)
+    {
+    vtkIdType nTris = 0, nQuads = 0;
+    for (vtkIdType j = 0; j < nCellFaces; j++)
       {
-      const int ownerCell = faceOwner.GetValue(faceI);
-      // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
-      if (ownerCell >= 0)
+      const vtkIdType nPoints = facePoints.GetSize(cellFaces[j]);
+      if (nPoints == 3)
         {
-        cfiPtr[ownerCell]++;
-        nTotalCellFaces++;
+        nTris++;
         }
-      const int neighborCell = faceNeighbor.GetValue(faceI);
-      if (neighborCell >= 0)
+      else if (nPoints == 4)
         {
-        cfiPtr[neighborCell]++;
-        nTotalCellFaces++;
+        nQuads++;
         }
-      }
-    for (int faceI = nNeiFaces; faceI < nFaces; faceI++)
-      {
-      const int ownerCell = faceOwner.GetValue(faceI);
-      if (ownerCell >= 0)
+      else
         {
-        cfiPtr[ownerCell]++;
-        nTotalCellFaces++;
+        break;
         }
       }
-    cfiPtr--; // revert offset +1
-
-    // allocate cellFaces. To reduce the numbers of new/delete operations we
-    // allocate memory space for all faces linearly
-    cells->ResizeBody(nTotalCellFaces);
-
-    // accumulate the number of cellFaces to create cellFaces indices
-    // and copy them to a temporary array
-    vtkIntArray *tmpFaceIndices = vtkIntArray::New();
-    tmpFaceIndices->SetNumberOfValues(nCells + 1);
-    int *tfiPtr = tmpFaceIndices->GetPointer(0);
-    tfiPtr[0] = 0;
-    for (int cellI = 1; cellI <= nCells; cellI++)
+    if (nTris == 2 && nQuads == 3)
       {
-      tfiPtr[cellI] = (cfiPtr[cellI] += cfiPtr[cellI - 1]);
+      cellType = VTK_WEDGE;
       }
-
-    // add face numbers to cell-faces list
-    vtkIntArray *cellFacesList = cells->GetBody();
-    for (int faceI = 0; faceI < nNeiFaces; faceI++)
+    else if (nTris == 4 && nQuads == 1)
       {
-      const int ownerCell = faceOwner.GetValue(faceI); // must be a signed int
-      // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
-      if (ownerCell >= 0)
-        {
-        cellFacesList->SetValue(tfiPtr[ownerCell]++, faceI);
-        }
-      const int neighborCell = faceNeighbor.GetValue(faceI);
-      if (neighborCell >= 0)
-        {
-        cellFacesList->SetValue(tfiPtr[neighborCell]++, faceI);
-        }
+      cellType = VTK_PYRAMID;
       }
-    for (int faceI = nNeiFaces; faceI < nFaces; faceI++)
+    }
+  else if (nCellFaces == 4)
+    {
+    vtkIdType j = 0;
+    for (; j < nCellFaces; j++)
       {
-      const int ownerCell = faceOwner.GetValue(faceI); // must be a signed int
-      // simpleFoam/pitzDaily3Blocks has faces with owner cell number -1
-      if (ownerCell >= 0)
+      if (facePoints.GetSize(cellFaces[j]) != 3)
         {
-        cellFacesList->SetValue(tfiPtr[ownerCell]++, faceI);
+        break;
         }
       }
-    tmpFaceIndices->Delete();
-
-    return cells;
-    }
-  else // if owner does not exist look for cells
-    {
-    vtkStdString cellsPath(ownerNeighborPath + "cells");
-    if (!(io.Open(cellsPath) || io.Open(cellsPath + ".gz")))
+    if (j == nCellFaces)
       {
-      vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
-          << io.GetError().c_str());
-      this->Parent->SetErrorCode(vtkErrorCode::CannotOpenFileError);
-      return NULL;
+      cellType = VTK_TETRA;
       }
-    vtkFoamEntryValue cellsDict(NULL);
-    try
+    }
+
+  // not a Hex/Wedge/Pyramid/Tetra
+  if (cellType == VTK_CONVEX_POINT_SET)
+    {
+    vtkIdType nPoints = 0;
+    for (vtkIdType j = 0; j < nCellFaces; j++)
       {
-      cellsDict.ReadLabelListList(io);
+      nPoints += facePoints.GetSize(cellFaces[j]);
       }
-    catch(vtkFoamError& e)
+    if (nPoints == 0)
       {
-      vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
-          << " of " << io.GetFileName().c_str() << ": " << e.c_str());
-      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-      return NULL;
+      cellType = VTK_EMPTY_CELL;
       }
+    }
+  return cellType;
+}
 
-    vtkFoamIntVectorVector *cells =
-        static_cast<vtkFoamIntVectorVector *>(cellsDict.Ptr());
-    this->NumCells = cells->GetNumberOfElements();
-    const int nFaces = facePoints->GetNumberOfElements();
+//-----------------------------------------------------------------------------
+// number of tetrahedra and pyramids a polyhedron face is decomposed into
+static void vtkFoamCountDecomposedFace(const vtkIdType nFacePoints,
+    vtkIdType &nTets, vtkIdType &nPyramids)
+{
+  if (nFacePoints < 3)
+    {
+    nTets = nPyramids = 0;
+    }
+  else
+    {
+    nTets = nFacePoints % 2;
+    nPyramids = (nFacePoints - 2 - nTets) / 2;
+    }
+}
 
-    // create face owner list
-    this->FaceOwner = vtkIntArray::New();
-    this->FaceOwner->SetNumberOfTuples(nFaces);
-    for (int faceI = 0; faceI < nFaces; faceI++)
-      {
-      this->FaceOwner->SetValue(faceI, -1);
-      }
-    for (int cellI = 0; cellI < this->NumCells; cellI++)
+//-----------------------------------------------------------------------------
+// a set of the point ids of a cell for eliminating duplicate points in
+// linear time. The slots of the hash table are marked by a stamp that
+// is incremented for every cell, so that the table is reused across
+// cells without being cleared.
+class vtkFoamCellPointSet
+{
+private:
+  vtkstd::vector<vtkIdType> Keys;
+  vtkstd::vector<unsigned int> Stamps;
+  unsigned int Stamp;
+  int Shift;
+
+public:
+  vtkFoamCellPointSet() :
+    Keys(), Stamps(), Stamp(0), Shift(32)
+  {
+  }
+
+  // start a new cell of at most nPoints points
+  void Reset(const size_t nPoints)
+  {
+    size_t size = this->Keys.size();
+    if (size < 2 * nPoints)
       {
-      const int nCellFaces = cells->GetSize(cellI);
-      const int *cellFaces = cells->operator[](cellI);
-      for (int faceI = 0; faceI < nCellFaces; faceI++)
+      // keep the load factor of the table at most 1/2
+      for (size = 16, this->Shift = 28; size < 2 * nPoints; size *= 2)
         {
-        const int f = cellFaces[faceI];
-        if (f < 0 || f >= nFaces) // make sure the face number is valid
-          {
-          vtkErrorMacro("Face number " << f << " in cell " << cellI
-              << " exceeds the number of faces " << nFaces);
-          this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-          this->FaceOwner->Delete();
-          this->FaceOwner = NULL;
-          delete cells;
-          return NULL;
-          }
-        const int owner = this->FaceOwner->GetValue(f);
-        if (owner == -1 || owner > cellI)
-          {
-          this->FaceOwner->SetValue(f, cellI);
-          }
+        this->Shift--;
         }
+      this->Keys.resize(size);
+      this->Stamps.assign(size, 0);
+      this->Stamp = 0;
       }
-    // check for unused faces
-    for (int faceI = 0; faceI < nFaces; faceI++)
+    if (++this->Stamp == 0)
       {
-      if (this->FaceOwner->GetValue(faceI) == -1)
+      this->Stamps.assign(size, 0);
+      this->Stamp = 1;
+      }
+  }
+
+  // add a point to the set; returns false if already there
+  bool Insert(const vtkIdType pointId)
+  {
+    const unsigned int mask = static_cast<unsigned int>(this->Keys.size())
+        - 1;
+    // Fibonacci hashing
+    unsigned int slot = (static_cast<unsigned int>(pointId) * 2654435769U)
+        >> this->Shift;
+    while (this->Stamps[slot] == this->Stamp)
+      {
+      if (this->Keys[slot] == pointId)
         {
-        vtkErrorMacro(<<"Face " << faceI << " is not used");
-        this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-        this->FaceOwner->Delete();
-        this->FaceOwner = NULL;
-        delete cells;
-        return NULL;
+        return false;
         }
+      slot = (slot + 1) & mask;
       }
-
-    return cells;
-    }
-}
+    this->Stamps[slot] = this->Stamp;
+    this->Keys[slot] = pointId;
+    return true;
+  }
+};
 
 //-----------------------------------------------------------------------------
-bool vtkOFFReaderPrivate::CheckFacePoints(
-    vtkFoamIntVectorVector *facePoints)
+// cell types, cell locations and the connectivity list (in the legacy
+// vtkCellArray layout) preallocated by the counting pass of
+// InsertCellsToGrid() and filled by the fill pass
+struct vtkFoamCellArrays
 {
-  const int nFaces = facePoints->GetNumberOfElements();
+  unsigned char *Types;
+  vtkIdType *Locations;
+  vtkIdType *Connectivity;
 
-  for (int faceI = 0; faceI < nFaces; faceI++)
-    {
-    const int nPoints = facePoints->GetSize(faceI);
-    const int *pointList = facePoints->operator[](faceI);
-    if (nPoints < 3)
-      {
-      vtkErrorMacro(<< "Face " << faceI << " has only " << nPoints
-          << " points which is not enough to constitute a face"
-          " (a face must have at least 3 points)");
-      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-      return false;
-      }
-    for (int pointI = 0; pointI < nPoints; pointI++)
+  // get the place to write the points of a cell in place
+  vtkIdType *GetCellPoints(const vtkIdType connectivityI)
+  {
+    return this->Connectivity + connectivityI + 1;
+  }
+  // set a cell whose points have been written in place
+  void SetCell(const vtkIdType cellI, vtkIdType &connectivityI,
+      const int cellType, const vtkIdType nPoints)
+  {
+    this->Types[cellI] = static_cast<unsigned char>(cellType);
+    this->Locations[cellI] = connectivityI;
+    this->Connectivity[connectivityI] = nPoints;
+    connectivityI += nPoints + 1;
+  }
+  // copy the points of a cell and set the cell
+  void SetCell(const vtkIdType cellI, vtkIdType &connectivityI,
+      const int cellType, const vtkIdType nPoints,
+      const vtkIdType *points)
+  {
+    vtkIdType *cellPoints = this->GetCellPoints(connectivityI);
+    for (vtkIdType pointI = 0; pointI < nPoints; pointI++)
       {
-      const int p = pointList[pointI];
-      if (p < 0 || p >= this->NumPoints)
-        {
-        vtkErrorMacro(<< "The point number " << p << " at face number " << faceI
-            << " is out of range for " << this->NumPoints << " points");
-        this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-        return false;
-        }
+      cellPoints[pointI] = points[pointI];
       }
-    }
-  return true;
-}
+    this->SetCell(cellI, connectivityI, cellType, nPoints);
+  }
+};
 
 //-----------------------------------------------------------------------------
-// determine cell shape and insert the cell into the mesh
-// hexahedron, prism, pyramid, tetrahedron and decompose polyhedron
-void vtkOFFReaderPrivate::InsertCellsToGrid(
-    vtkUnstructuredGrid* internalMesh,
-    const vtkFoamIntVectorVector *cellsFaces,
-    const vtkFoamIntVectorVector *facesPoints, vtkFloatArray *pointArray,
-    vtkIdTypeArray *additionalCells, vtkIntArray *cellList)
+// a range of cells processed by a thread in InsertCellsToGrid()
+struct vtkOFFReaderPrivate::vtkFoamCellRange
 {
-  const int maxNPoints = 256; // assume max number of points per cell
-  vtkIdList* cellPoints = vtkIdList::New();
-  cellPoints->SetNumberOfIds(maxNPoints);
+  vtkIdType Begin, End;
 
-  // assume max number of nPoints per face + points per cell
-  const int maxNPolyPoints = 1024;
-  vtkIdList* polyPoints = vtkIdList::New();
-  polyPoints->SetNumberOfIds(maxNPolyPoints);
+  // sizes counted by the first pass
+  vtkIdType ConnectivitySize, AdditionalConnectivitySize, FacesSize;
+  vtkIdType NPolyhedra, NAdditionalCells, AdditionalCellPointsSize;
 
-  const int nCells = (cellList == NULL ? this->NumCells
-      : cellList->GetNumberOfTuples());
-  int nAdditionalPoints = 0;
-  this->NumTotalAdditionalCells = 0;
+  // positions in the cell arrays where the second pass starts writing,
+  // given by the prefix sums of the sizes of the preceding ranges
+  vtkIdType ConnectivityStart, AdditionalConnectivityStart, FacesStart,
+      AdditionalCellStart;
+  vtkIdType PolyhedronStart, AdditionalCellPointsStart;
 
-  // alias
-  const vtkFoamIntVectorVector& facePoints = *facesPoints;
+  // ends of the lists actually written by the second pass
+  vtkIdType ConnectivityEnd;
+  vtkIdType AdditionalCellPointsEnd;
 
-  for (int cellI = 0; cellI < nCells; cellI++)
-    {
-    int cellId;
-    if (cellList == NULL)
+  // warnings of the second pass, reported by the calling thread since
+  // vtkOutputWindow is not thread-safe
+  vtkstd::vector<vtkStdString> Warnings;
+
+  void AddWarning(const vtksys_ios::ostringstream &message)
+  {
+    this->Warnings.push_back(message.str());
+  }
+};
+
+//-----------------------------------------------------------------------------
+// runs either pass of InsertCellsToGrid() over the cell ranges
+struct vtkOFFReaderPrivate::vtkFoamCellTasks
+{
+  vtkOFFReaderPrivate *Reader;
+  const vtkFoamIntVectorVector *CellsFaces;
+  const vtkFoamIntVectorVector *FacesPoints;
+  vtkFloatArray *PointArray;
+  bool DecomposePolyhedra;
+  vtkIntArray *CellList;
+  vtkstd::vector<vtkFoamCellRange> *Ranges;
+
+  // the second pass if true
+  bool Fill;
+
+  // the preallocated output of the first pass
+  vtkFoamCellArrays Arrays;
+  vtkIdType *FaceLocations;
+  vtkIdType *Faces;
+  float *Centroids;
+  vtkIdType *AdditionalCellIds;
+  int *NumAdditionalCells;
+  vtkIdType *AdditionalCellPointIndices;
+  vtkIdType *AdditionalCellPointIds;
+
+  void operator()(const vtkIdType taskI) const
+  {
+    vtkFoamCellRange &range = (*this->Ranges)[taskI];
+    if (this->Fill)
       {
-      cellId = cellI;
+      this->Reader->InsertCellsInRange(*this, range);
       }
     else
       {
-      cellId = cellList->GetValue(cellI);
-      if (cellId >= this->NumCells)
-        {
-        vtkWarningMacro(<<"cellLabels id " << cellId
-            << " exceeds the number of cells " << nCells
-            << ". Inserting an empty cell.");
-        internalMesh->InsertNextCell(VTK_EMPTY_CELL, 0,
-            cellPoints->GetPointer(0));
-        continue;
-        }
+      this->Reader->CountCellsInRange(*this, range);
       }
-    const int *cellFaces = cellsFaces->operator[](cellId);
-    const int nCellFaces = cellsFaces->GetSize(cellId);
+  }
+};
 
-    // determine type of the cell
-    // cf. src/OpenFOAM/meshes/meshShapes/cellMatcher/{hex|prism|pyr|tet}-
-    // Matcher.C
-    int cellType = VTK_CONVEX_POINT_SET;
-    if (nCellFaces == 6)
-      {
-      int j = 0;
-      for (; j < nCellFaces; j++)
-        {
-        if (facePoints.GetSize(cellFaces[j]) != 4)
-          {
-          break;
-          }
-        }
-      if (j == nCellFaces)
-        {
-        cellType = VTK_HEXAHEDRON;
-        }
+//-----------------------------------------------------------------------------
+// first pass of InsertCellsToGrid(): classify the cells and count the
+// sizes of the cell arrays. The cell types of the original cells are
+// retained for the second pass.
+void vtkOFFReaderPrivate::CountCellsInRange(const vtkFoamCellTasks &tasks,
+    vtkFoamCellRange &range)
+{
+  const vtkFoamIntVectorVector *cellsFaces = tasks.CellsFaces;
+  const vtkFoamIntVectorVector &facePoints = *tasks.FacesPoints;
+  vtkIntArray *cellList = tasks.CellList;
+  unsigned char *cellTypes = tasks.Arrays.Types;
+
+  range.ConnectivitySize = range.AdditionalConnectivitySize
+      = range.FacesSize = 0;
+  range.NPolyhedra = range.NAdditionalCells = range.AdditionalCellPointsSize
+      = 0;
+  for (vtkIdType cellI = range.Begin; cellI < range.End; cellI++)
+    {
+    const vtkIdType cellId
+        = (cellList == NULL ? cellI : cellList->GetValue(cellI));
+    if (cellId >= this->NumCells)
+      {
+      cellTypes[cellI] = VTK_EMPTY_CELL;
+      range.ConnectivitySize++;
+      continue;
       }
-    else if (nCellFaces == 5)
+    const vtkIdType *cellFaces = cellsFaces->operator[](cellId);
+    const vtkIdType nCellFaces = cellsFaces->GetSize(cellId);
+
+    const int cellType = vtkFoamGetCellType(cellFaces, nCellFaces, facePoints);
+    cellTypes[cellI] = static_cast<unsigned char>(cellType);
+    switch (cellType)
       {
-      int nTris = 0, nQuads = 0;
-      for (int j = 0; j < nCellFaces; j++)
-        {
-        const int nPoints = facePoints.GetSize(cellFaces[j]);
-        if (nPoints == 3)
-          {
-          nTris++;
-          }
-        else if (nPoints == 4)
+      case VTK_HEXAHEDRON:
+        range.ConnectivitySize += 9;
+        break;
+      case VTK_WEDGE:
+        range.ConnectivitySize += 7;
+        break;
+      case VTK_PYRAMID:
+        range.ConnectivitySize += 6;
+        break;
+      case VTK_TETRA:
+        range.ConnectivitySize += 5;
+        break;
+      case VTK_EMPTY_CELL:
+        range.ConnectivitySize++;
+        break;
+      default: // polyhedron
+        range.NPolyhedra++;
+        if (tasks.DecomposePolyhedra)
           {
-          nQuads++;
+          // the first decomposed cell goes to the original position and
+          // the rest to the additional cells
+          vtkIdType nFirstCellPoints = 0, nDecomposedCells = 0;
+          vtkIdType decomposedSize = 0;
+          for (vtkIdType j = 0; j < nCellFaces; j++)
+            {
+            const vtkIdType cellFacesJ = cellFaces[j];
+            const vtkIdType nFaceJPoints = facePoints.GetSize(cellFacesJ);
+            vtkIdType nTets, nPyramids;
+            vtkFoamCountDecomposedFace(nFaceJPoints, nTets, nPyramids);
+            if (nFirstCellPoints == 0 && nTets + nPyramids > 0)
+              {
+              // a face starts with a triangle if reversed or if it is
+              // a triangle itself
+              nFirstCellPoints = (nTets
+                  && (nFaceJPoints == 3
+                  || this->BoundaryDict.IsUpperProcFace(cellFacesJ)) ? 4 : 5);
+              }
+            nDecomposedCells += nTets + nPyramids;
+            decomposedSize += 5 * nTets + 6 * nPyramids;
+            // the number of unique points is bounded by the total
+            // number of face points
+            range.AdditionalCellPointsSize += nFaceJPoints;
+            }
+          if (nDecomposedCells == 0)
+            {
+            // no decomposable face; will be an empty cell
+            range.ConnectivitySize++;
+            }
+          else
+            {
+            range.ConnectivitySize += nFirstCellPoints + 1;
+            range.AdditionalConnectivitySize += decomposedSize
+                - nFirstCellPoints - 1;
+            range.NAdditionalCells += nDecomposedCells - 1;
+            }
           }
         else
           {
-          break;
-          }
-        }
-      if (nTris == 2 && nQuads == 3)
-        {
-        cellType = VTK_WEDGE;
-        }
-      else if (nTris == 4 && nQuads == 1)
-        {
-        cellType = VTK_PYRAMID;
-        }
-      }
-    else if (nCellFaces == 4)
-      {
-      int j = 0;
-      for (; j < nCellFaces; j++)
-        {
-        if (facePoints.GetSize(cellFaces[j]) != 3)
-          {
-          break;
+          // the number of unique points is bounded by the total
+          // number of face points
+          vtkIdType nFacesPoints = 0;
+          for (vtkIdType j = 0; j < nCellFaces; j++)
+            {
+            nFacesPoints += facePoints.GetSize(cellFaces[j]);
+            }
+          range.ConnectivitySize += nFacesPoints + 1;
+          range.FacesSize += nFacesPoints + nCellFaces + 1;
           }
-        }
-      if (j == nCellFaces)
-        {
-        cellType = VTK_TETRA;
-        }
+        break;
       }
+    }
+}
 
-    // not a Hex/Wedge/Pyramid/Tetra
-    if (cellType == VTK_CONVEX_POINT_SET)
-      {
-      int nPoints = 0;
-      for (int j = 0; j < nCellFaces; j++)
-        {
-        nPoints += facePoints.GetSize(cellFaces[j]);
-        }
-      if (nPoints == 0)
-        {
-        cellType = VTK_EMPTY_CELL;
-        }
+//-----------------------------------------------------------------------------
+// second pass of InsertCellsToGrid(): determine cell shape and insert
+// the cell into the preallocated cell arrays
+// hexahedron, prism, pyramid, tetrahedron and decompose polyhedron
+void vtkOFFReaderPrivate::InsertCellsInRange(const vtkFoamCellTasks &tasks,
+    vtkFoamCellRange &range)
+{
+  const vtkFoamIntVectorVector *cellsFaces = tasks.CellsFaces;
+  const vtkFoamIntVectorVector &facePoints = *tasks.FacesPoints;
+  vtkFloatArray *pointArray = tasks.PointArray;
+  vtkIntArray *cellList = tasks.CellList;
+  vtkFoamCellArrays arrays = tasks.Arrays;
+  const unsigned char *cellTypes = arrays.Types;
+  vtkIdType *faceLocations = tasks.FaceLocations;
+
+  vtkIdType connectivityI = range.ConnectivityStart,
+      additionalConnectivityI = range.AdditionalConnectivityStart,
+      facesI = range.FacesStart, additionalCellI = range.AdditionalCellStart;
+  vtkIdType polyI = range.PolyhedronStart,
+      additionalCellPointI = range.AdditionalCellPointsStart;
+  vtkIdType decomposedPoints[5];
+  vtkFoamCellPointSet cellPointSet;
+  for (vtkIdType cellI = range.Begin; cellI < range.End; cellI++)
+    {
+    if (faceLocations != NULL)
+      {
+      faceLocations[cellI] = -1;
+      }
+
+    const vtkIdType cellId
+        = (cellList == NULL ? cellI : cellList->GetValue(cellI));
+    if (cellId >= this->NumCells)
+      {
+      vtksys_ios::ostringstream message;
+      message << "cellLabels id " << cellId
+          << " exceeds the number of cells " << this->NumCells
+          << ". Inserting an empty cell.";
+      range.AddWarning(message);
+      arrays.SetCell(cellI, connectivityI, VTK_EMPTY_CELL, 0);
+      continue;
       }
+    const vtkIdType *cellFaces = cellsFaces->operator[](cellId);
+    const vtkIdType nCellFaces = cellsFaces->GetSize(cellId);
+    const int cellType = cellTypes[cellI];
+    vtkIdType *cellPoints = arrays.GetCellPoints(connectivityI);
 
     // Cell shape constructor based on the one implementd by Terry
     // Jordan, with lots of improvements. Not as elegant as the one in
     // OpenFOAM but it's simple and works reasonably fast.
-
     // OFhex | vtkHexahedron
     if (cellType == VTK_HEXAHEDRON)
       {
       // get first face in correct order
-      const int cellBaseFaceId = cellFaces[0];
-      const int *face0Points = facePoints[cellBaseFaceId];
+      const vtkIdType cellBaseFaceId = cellFaces[0];
+      const vtkIdType *face0Points = facePoints[cellBaseFaceId];
 
       if (this->FaceOwner->GetValue(cellBaseFaceId) == cellId)
         {
         // if it is an owner face flip the points
-        for (int j = 0; j < 4; j++)
+        for (vtkIdType j = 0; j < 4; j++)
           {
-          cellPoints->SetId(j, face0Points[3 - j]);
+          cellPoints[j] = face0Points[3 - j];
           }
         }
       else
         {
         // add base face to cell points
-        for (int j = 0; j < 4; j++)
+        for (vtkIdType j = 0; j < 4; j++)
           {
-          cellPoints->SetId(j, face0Points[j]);
+          cellPoints[j] = face0Points[j];
           }
         }
-      const int baseFacePoint0 = cellPoints->GetId(0);
-      const int baseFacePoint2 = cellPoints->GetId(2);
-      int cellOppositeFaceI = -1, pivotPoint = -1;
-      int dupPoint = -1;
-      for (int faceI = 1; faceI < 5; faceI++) // skip face 0 and 5
+      const vtkIdType baseFacePoint0 = cellPoints[0];
+      const vtkIdType baseFacePoint2 = cellPoints[2];
+      vtkIdType cellOppositeFaceI = -1, pivotPoint = -1;
+      vtkIdType dupPoint = -1;
+      for (vtkIdType faceI = 1; faceI < 5; faceI++) // skip face 0 and 5
         {
-        const int cellFaceI = cellFaces[faceI];
-        const int *faceIPoints = facePoints[cellFaceI];
-        int foundDup = -1, pointI = 0;
+        const vtkIdType cellFaceI = cellFaces[faceI];
+        const vtkIdType *faceIPoints = facePoints[cellFaceI];
+        vtkIdType foundDup = -1, pointI = 0;
         for (; pointI < 4; pointI++) // each point
           {
-          const int faceIPointI = faceIPoints[pointI];
+          const vtkIdType faceIPointI = faceIPoints[pointI];
           // matching two points in base face is enough to find a
           // duplicated point since neighboring faces share two
           // neighboring points (i. e. an edge)
@@ -5944,15 +10402,15 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
             {
             dupPoint = foundDup;
 
-            const int faceINextPoint = faceIPoints[(pointI + 1) % 4];
+            const vtkIdType faceINextPoint = faceIPoints[(pointI + 1) % 4];
 
             // if the next point of the faceI-th face matches the
             // previous point of the base face use the previous point
             // of the faceI-th face as the pivot point; or use the
             // next point otherwise
             if (faceINextPoint == (this->FaceOwner->GetValue(cellFaceI)
-                == cellId ? cellPoints->GetId(1 + foundDup)
-                : cellPoints->GetId(3 - foundDup)))
+                == cellId ? cellPoints[1 + foundDup]
+                : cellPoints[3 - foundDup]))
               {
               pivotPoint = faceIPoints[(3 + pointI) % 4];
               }
@@ -5987,8 +10445,8 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
         }
 
       // find the pivot point in opposite face
-      const int *oppositeFacePoints = facePoints[cellOppositeFaceI];
-      int pivotPointI = 0;
+      const vtkIdType *oppositeFacePoints = facePoints[cellOppositeFaceI];
+      vtkIdType pivotPointI = 0;
       for (; pivotPointI < 4; pivotPointI++)
         {
         if (oppositeFacePoints[pivotPointI] == pivotPoint)
@@ -6004,32 +10462,32 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
         pivotPointI = (pivotPointI + 2) % 4;
         }
       // copy the face-point list of the opposite face to cell-point list
-      int basePointI = 4;
+      vtkIdType basePointI = 4;
       if (this->FaceOwner->GetValue(cellOppositeFaceI) == cellId)
         {
-        for (int pointI = pivotPointI; pointI < 4; pointI++)
+        for (vtkIdType pointI = pivotPointI; pointI < 4; pointI++)
           {
-          cellPoints->SetId(basePointI++, oppositeFacePoints[pointI]);
+          cellPoints[basePointI++] = oppositeFacePoints[pointI];
           }
-        for (int pointI = 0; pointI < pivotPointI; pointI++)
+        for (vtkIdType pointI = 0; pointI < pivotPointI; pointI++)
           {
-          cellPoints->SetId(basePointI++, oppositeFacePoints[pointI]);
+          cellPoints[basePointI++] = oppositeFacePoints[pointI];
           }
         }
       else
         {
-        for (int pointI = pivotPointI; pointI >= 0; pointI--)
+        for (vtkIdType pointI = pivotPointI; pointI >= 0; pointI--)
           {
-          cellPoints->SetId(basePointI++, oppositeFacePoints[pointI]);
+          cellPoints[basePointI++] = oppositeFacePoints[pointI];
           }
-        for (int pointI = 3; pointI > pivotPointI; pointI--)
+        for (vtkIdType pointI = 3; pointI > pivotPointI; pointI--)
           {
-          cellPoints->SetId(basePointI++, oppositeFacePoints[pointI]);
+          cellPoints[basePointI++] = oppositeFacePoints[pointI];
           }
         }
 
       // create the hex cell and insert it into the mesh
-      internalMesh->InsertNextCell(cellType, 8, cellPoints->GetPointer(0));
+      arrays.SetCell(cellI, connectivityI, cellType, 8);
       }
 
     // the cell construction is about the same as that of a hex, but
@@ -6037,8 +10495,8 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
     else if (cellType == VTK_WEDGE)
       {
       // find the base face number
-      int baseFaceId = 0;
-      for (int j = 0; j < 5; j++)
+      vtkIdType baseFaceId = 0;
+      for (vtkIdType j = 0; j < 5; j++)
         {
         if (facePoints.GetSize(cellFaces[j]) == 3)
           {
@@ -6048,36 +10506,36 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
         }
 
       // get first face in correct order
-      const int cellBaseFaceId = cellFaces[baseFaceId];
-      const int *face0Points = facePoints[cellBaseFaceId];
+      const vtkIdType cellBaseFaceId = cellFaces[baseFaceId];
+      const vtkIdType *face0Points = facePoints[cellBaseFaceId];
 
       if (this->FaceOwner->GetValue(cellBaseFaceId) == cellId)
         {
-        for (int j = 0; j < 3; j++)
+        for (vtkIdType j = 0; j < 3; j++)
           {
-          cellPoints->SetId(j, face0Points[j]);
+          cellPoints[j] = face0Points[j];
           }
         }
       else
         {
         // if it is a neighbor face flip the points
-        for (int j = 0; j < 3; j++)
+        for (vtkIdType j = 0; j < 3; j++)
           {
           // add base face to cell points
-          cellPoints->SetId(j, face0Points[2 - j]);
+          cellPoints[j] = face0Points[2 - j];
           }
         }
-      const int baseFacePoint0 = cellPoints->GetId(0);
-      const int baseFacePoint2 = cellPoints->GetId(2);
-      int cellOppositeFaceI = -1, pivotPoint = -1;
+      const vtkIdType baseFacePoint0 = cellPoints[0];
+      const vtkIdType baseFacePoint2 = cellPoints[2];
+      vtkIdType cellOppositeFaceI = -1, pivotPoint = -1;
       bool dupPoint2 = false;
-      for (int faceI = 0; faceI < 5; faceI++)
+      for (vtkIdType faceI = 0; faceI < 5; faceI++)
         {
         if (faceI == baseFaceId)
           {
           continue;
           }
-        const int cellFaceI = cellFaces[faceI];
+        const vtkIdType cellFaceI = cellFaces[faceI];
         if (facePoints.GetSize(cellFaceI) == 3)
           {
           cellOppositeFaceI = cellFaceI;
@@ -6085,12 +10543,12 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
         // find the pivot point if still haven't
         else if (pivotPoint == -1)
           {
-          const int *faceIPoints = facePoints[cellFaceI];
+          const vtkIdType *faceIPoints = facePoints[cellFaceI];
           bool found0Dup = false;
-          int pointI = 0;
+          vtkIdType pointI = 0;
           for (; pointI < 4; pointI++) // each point
             {
-            const int faceIPointI = faceIPoints[pointI];
+            const vtkIdType faceIPointI = faceIPoints[pointI];
             // matching two points in base face is enough to find a
             // duplicated point since neighboring faces share two
             // neighboring points (i. e. an edge)
@@ -6105,21 +10563,21 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
               }
             }
           // the matching point must always be found so omit the check
-          int baseFacePrevPoint, baseFaceNextPoint;
+          vtkIdType baseFacePrevPoint, baseFaceNextPoint;
           if (found0Dup)
             {
-            baseFacePrevPoint = cellPoints->GetId(2);
-            baseFaceNextPoint = cellPoints->GetId(1);
+            baseFacePrevPoint = cellPoints[2];
+            baseFaceNextPoint = cellPoints[1];
             }
           else
             {
-            baseFacePrevPoint = cellPoints->GetId(1);
-            baseFaceNextPoint = cellPoints->GetId(0);
+            baseFacePrevPoint = cellPoints[1];
+            baseFaceNextPoint = cellPoints[0];
             dupPoint2 = true;
             }
 
-          const int faceINextPoint = faceIPoints[(pointI + 1) % 4];
-          const int faceIPrevPoint = faceIPoints[(3 + pointI) % 4];
+          const vtkIdType faceINextPoint = faceIPoints[(pointI + 1) % 4];
+          const vtkIdType faceIPrevPoint = faceIPoints[(3 + pointI) % 4];
 
           // if the next point of the faceI-th face matches the
           // previous point of the base face use the previous point of
@@ -6145,8 +10603,8 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
         }
 
       // find the pivot point in opposite face
-      const int *oppositeFacePoints = facePoints[cellOppositeFaceI];
-      int pivotPointI = 0;
+      const vtkIdType *oppositeFacePoints = facePoints[cellOppositeFaceI];
+      vtkIdType pivotPointI = 0;
       for (; pivotPointI < 3; pivotPointI++)
         {
         if (oppositeFacePoints[pivotPointI] == pivotPoint)
@@ -6161,14 +10619,14 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
           {
           pivotPointI = (pivotPointI + 2) % 3;
           }
-        int basePointI = 3;
-        for (int pointI = pivotPointI; pointI >= 0; pointI--)
+        vtkIdType basePointI = 3;
+        for (vtkIdType pointI = pivotPointI; pointI >= 0; pointI--)
           {
-          cellPoints->SetId(basePointI++, oppositeFacePoints[pointI]);
+          cellPoints[basePointI++] = oppositeFacePoints[pointI];
           }
-        for (int pointI = 2; pointI > pivotPointI; pointI--)
+        for (vtkIdType pointI = 2; pointI > pivotPointI; pointI--)
           {
-          cellPoints->SetId(basePointI++, oppositeFacePoints[pointI]);
+          cellPoints[basePointI++] = oppositeFacePoints[pointI];
           }
         }
       else
@@ -6180,28 +10638,28 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
           pivotPointI = (1 + pivotPointI) % 3;
           }
         // copy the face-point list of the opposite face to cell-point list
-        int basePointI = 3;
-        for (int pointI = pivotPointI; pointI < 3; pointI++)
+        vtkIdType basePointI = 3;
+        for (vtkIdType pointI = pivotPointI; pointI < 3; pointI++)
           {
-          cellPoints->SetId(basePointI++, oppositeFacePoints[pointI]);
+          cellPoints[basePointI++] = oppositeFacePoints[pointI];
           }
-        for (int pointI = 0; pointI < pivotPointI; pointI++)
+        for (vtkIdType pointI = 0; pointI < pivotPointI; pointI++)
           {
-          cellPoints->SetId(basePointI++, oppositeFacePoints[pointI]);
+          cellPoints[basePointI++] = oppositeFacePoints[pointI];
           }
         }
 
       // create the wedge cell and insert it into the mesh
-      internalMesh->InsertNextCell(cellType, 6, cellPoints->GetPointer(0));
+      arrays.SetCell(cellI, connectivityI, cellType, 6);
       }
 
     // OFpyramid | vtkPyramid || OFtet | vtkTetrahedron
     else if (cellType == VTK_PYRAMID || cellType == VTK_TETRA)
       {
-      int baseFaceId = -1, nPoints;
+      vtkIdType baseFaceId = -1, nPoints;
       if (cellType == VTK_PYRAMID)
         {
-        for (int j = 0; j < nCellFaces; j++)
+        for (vtkIdType j = 0; j < nCellFaces; j++)
           {
           if (facePoints.GetSize(cellFaces[j]) == 4)
             {
@@ -6218,47 +10676,46 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
         }
 
       // add first face to cell points
-      const int cellBaseFaceId = cellFaces[baseFaceId];
-      const int *baseFacePoints = facePoints[cellBaseFaceId];
+      const vtkIdType cellBaseFaceId = cellFaces[baseFaceId];
+      const vtkIdType *baseFacePoints = facePoints[cellBaseFaceId];
       const vtkIdType nBaseFacePoints = facePoints.GetSize(cellBaseFaceId);
       if (this->FaceOwner->GetValue(cellBaseFaceId) == cellId)
         {
         // if it is an owner face flip the points
         for (vtkIdType j = 0; j < nBaseFacePoints; j++)
           {
-          cellPoints->SetId(j, baseFacePoints[nBaseFacePoints - 1 - j]);
+          cellPoints[j] = baseFacePoints[nBaseFacePoints - 1 - j];
           }
         }
       else
         {
         for (vtkIdType j = 0; j < nBaseFacePoints; j++)
           {
-          cellPoints->SetId(j, baseFacePoints[j]);
+          cellPoints[j] = baseFacePoints[j];
           }
         }
 
       // compare an adjacent face (any non base face is ok) point 1 to
       // base face points
-      const int adjacentFaceId = (baseFaceId == 0) ? 1 : baseFaceId - 1;
-      const int cellAdjacentFaceId = cellFaces[adjacentFaceId];
-      const int *adjacentFacePoints = facePoints[cellAdjacentFaceId];
-      const int adjacentFacePoint1 = adjacentFacePoints[1];
+      const vtkIdType adjacentFaceId = (baseFaceId == 0) ? 1 : baseFaceId - 1;
+      const vtkIdType cellAdjacentFaceId = cellFaces[adjacentFaceId];
+      const vtkIdType *adjacentFacePoints = facePoints[cellAdjacentFaceId];
+      const vtkIdType adjacentFacePoint1 = adjacentFacePoints[1];
       bool foundDup = false;
       for (vtkIdType j = 0; j < nBaseFacePoints; j++)
         {
         // if point 1 of the adjacent face matches point j of the base face...
-        if (cellPoints->GetId(j) == adjacentFacePoint1)
+        if (cellPoints[j] == adjacentFacePoint1)
           {
           // if point 2 of the adjacent face matches the previous point
           // of the base face use point 0 of the adjacent face as the
           // pivot point; use point 2 otherwise
-          cellPoints->SetId(
-              nBaseFacePoints,
-              (adjacentFacePoints[2]
-                  == cellPoints->GetId((this->FaceOwner->GetValue(cellAdjacentFaceId)
+          cellPoints[nBaseFacePoints]
+              = (adjacentFacePoints[2]
+                  == cellPoints[((this->FaceOwner->GetValue(cellAdjacentFaceId)
                       == cellId ? (j + 1) : (nBaseFacePoints + j - 1))
-                      % nBaseFacePoints)) ? adjacentFacePoints[0]
-                  : adjacentFacePoints[2]);
+                      % nBaseFacePoints)]) ? adjacentFacePoints[0]
+                  : adjacentFacePoints[2];
           foundDup = true;
           break;
           }
@@ -6267,51 +10724,52 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
       // the base face, it's the pivot point
       if (!foundDup)
         {
-        cellPoints->SetId(nBaseFacePoints, adjacentFacePoint1);
+        cellPoints[nBaseFacePoints] = adjacentFacePoint1;
         }
 
       // create the tetra cell and insert it into the mesh
-      internalMesh->InsertNextCell(cellType, nPoints, cellPoints->GetPointer(0));
+      arrays.SetCell(cellI, connectivityI, cellType, nPoints);
       }
 
     // erroneous cells
     else if (cellType == VTK_EMPTY_CELL)
       {
-      vtkWarningMacro("Warning: No points in cellId " << cellId);
-      internalMesh->InsertNextCell(VTK_EMPTY_CELL, 0, cellPoints->GetPointer(0));
+      vtksys_ios::ostringstream message;
+      message << "Warning: No points in cellId " << cellId;
+      range.AddWarning(message);
+      arrays.SetCell(cellI, connectivityI, VTK_EMPTY_CELL, 0);
       }
 
     // OFpolyhedron || vtkConvexPointSet
     else
       {
-      if (additionalCells != NULL) // decompose into tets and pyramids
+      if (tasks.DecomposePolyhedra) // decompose into tets and pyramids
         {
         // calculate cell centroid and insert it to point list
-        this->AdditionalCellPoints->push_back(vtkIdList::New());
-        vtkIdList *polyCellPoints = this->AdditionalCellPoints->back();
-        float centroid[3];
+        tasks.AdditionalCellPointIndices[polyI] = additionalCellPointI;
+        vtkIdType *polyCellPoints = tasks.AdditionalCellPointIds
+            + additionalCellPointI;
+        vtkIdType nPolyCellPoints = 0;
+        float *centroid = tasks.Centroids + 3 * polyI;
         centroid[0] = centroid[1] = centroid[2] = 0.0F;
-        for (int j = 0; j < nCellFaces; j++)
+        size_t nFacesPoints = 0;
+        for (vtkIdType j = 0; j < nCellFaces; j++)
+          {
+          nFacesPoints += facePoints.GetSize(cellFaces[j]);
+          }
+        cellPointSet.Reset(nFacesPoints);
+        for (vtkIdType j = 0; j < nCellFaces; j++)
           {
           // remove duplicate points from faces
-          const int cellFacesJ = cellFaces[j];
-          const int *faceJPoints = facePoints[cellFacesJ];
+          const vtkIdType cellFacesJ = cellFaces[j];
+          const vtkIdType *faceJPoints = facePoints[cellFacesJ];
           const size_t nFaceJPoints = facePoints.GetSize(cellFacesJ);
           for (size_t k = 0; k < nFaceJPoints; k++)
             {
-            const int faceJPointK = faceJPoints[k];
-            bool foundDup = false;
-            for (vtkIdType l = 0; l < static_cast<vtkIdType>(polyCellPoints->GetNumberOfIds()); l++)
-              {
-              if (polyCellPoints->GetId(l) == faceJPointK)
-                {
-                foundDup = true;
-                break; // look no more
-                }
-              }
-            if (!foundDup)
+            const vtkIdType faceJPointK = faceJPoints[k];
+            if (cellPointSet.Insert(faceJPointK))
               {
-              polyCellPoints->InsertNextId(faceJPointK);
+              polyCellPoints[nPolyCellPoints++] = faceJPointK;
               const float *pointK = pointArray->GetPointer(3 * faceJPointK);
               centroid[0] += pointK[0];
               centroid[1] += pointK[1];
@@ -6319,44 +10777,35 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
               }
             }
           }
-        polyCellPoints->Squeeze();
-        const float weight = 1.0F
-            / static_cast<float>(polyCellPoints->GetNumberOfIds());
+        additionalCellPointI += nPolyCellPoints;
+        const float weight = 1.0F / static_cast<float>(nPolyCellPoints);
         centroid[0] *= weight;
         centroid[1] *= weight;
         centroid[2] *= weight;
-        pointArray->InsertNextTuple(centroid);
 
         // polyhedron decomposition.
         // a tweaked algorithm based on applications/utilities/postProcessing/
         // graphics/PVFoamReader/vtkFoam/vtkFoamAddInternalMesh.C
         bool insertDecomposedCell = true;
-        int nAdditionalCells = 0;
-        for (int j = 0; j < nCellFaces; j++)
+        vtkIdType nAdditionalCells = 0;
+        for (vtkIdType j = 0; j < nCellFaces; j++)
           {
-          const int cellFacesJ = cellFaces[j];
-          const int *faceJPoints = facePoints[cellFacesJ];
-          const int nFaceJPoints = facePoints.GetSize(cellFacesJ);
-          const int nTris = nFaceJPoints % 2;
+          const vtkIdType cellFacesJ = cellFaces[j];
+          const vtkIdType *faceJPoints = facePoints[cellFacesJ];
+          const vtkIdType nFaceJPoints = facePoints.GetSize(cellFacesJ);
+          const vtkIdType nTris = nFaceJPoints % 2;
 
-          // check if the face has to be reversed
-          bool reverseFace = false;
-          if (cellFacesJ >= this->BoundaryDict.LowestUpperProcFaceNo)
+          // a degenerate face has no volume to decompose
+          if (nFaceJPoints < 3)
             {
-            vtkstd::vector<int> &ranges = this->BoundaryDict.UpperProcRanges;
-            const size_t rangeSize = ranges.size();
-            for (size_t rangeI = 0; rangeI < rangeSize; rangeI += 2)
-              {
-              if (ranges[rangeI] <= cellFacesJ
-                  && cellFacesJ < ranges[rangeI + 1])
-                {
-                reverseFace = true;
-                break;
-                }
-              }
+            continue;
             }
 
-          int vertI = 2;
+          // check if the face has to be reversed
+          const bool reverseFace = this->BoundaryDict.IsUpperProcFace(
+              cellFacesJ);
+
+          vtkIdType vertI = 2;
 
           // shift the start and end of the vertex loop if the
           // triangle of a decomposed face is going to be flat. Far
@@ -6381,7 +10830,7 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
                   = pointArray->GetPointer(3 * faceJPoints[nFaceJPoints - 2]);
               }
             float vsizeSqr1 = 0.0F, vsizeSqr2 = 0.0F, dotProduct = 0.0F;
-            for (int i = 0; i < 3; i++)
+            for (vtkIdType i = 0; i < 3; i++)
               {
               const float v1 = point1[i] - point0[i], v2 = point2[i]
                   - point0[i];
@@ -6399,55 +10848,53 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
 
           if (reverseFace)
             {
-            cellPoints->SetId(0, faceJPoints[vertI == 2 ? 0 : 1]);
+            decomposedPoints[0] = faceJPoints[vertI == 2 ? 0 : 1];
             // if the number of vertices is odd there's a triangle
             if (nTris)
               {
-              cellPoints->SetId(1, faceJPoints[vertI]);
-              cellPoints->SetId(2, faceJPoints[vertI - 1]);
-              cellPoints->SetId(3, this->NumPoints + nAdditionalPoints);
+              decomposedPoints[1] = faceJPoints[vertI];
+              decomposedPoints[2] = faceJPoints[vertI - 1];
+              decomposedPoints[3] = this->NumPoints + polyI;
 
               if (insertDecomposedCell)
                 {
-                internalMesh->InsertNextCell(VTK_TETRA, 4,
-                    cellPoints->GetPointer(0));
+                arrays.SetCell(cellI, connectivityI, VTK_TETRA, 4,
+                    decomposedPoints);
                 insertDecomposedCell = false;
                 }
               else
                 {
-                // set the 5th vertex number to -1 to distinguish a tetra cell
-                cellPoints->SetId(4, -1);
                 nAdditionalCells++;
-                additionalCells->InsertNextTupleValue(
-                    cellPoints->GetPointer(0));
+                arrays.SetCell(additionalCellI++, additionalConnectivityI,
+                    VTK_TETRA, 4, decomposedPoints);
                 }
 
               ++vertI;
               }
 
-            cellPoints->SetId(4, this->NumPoints + nAdditionalPoints);
+            decomposedPoints[4] = this->NumPoints + polyI;
             // decompose a face into quads in order (flipping the
             // decomposed face if owner)
             for (; vertI < nFaceJPoints; vertI += 2)
               {
-              cellPoints->SetId(1, faceJPoints[(vertI + 1) % nFaceJPoints]);
-              cellPoints->SetId(2, faceJPoints[vertI]);
-              cellPoints->SetId(3, faceJPoints[vertI - 1]);
+              decomposedPoints[1] = faceJPoints[(vertI + 1) % nFaceJPoints];
+              decomposedPoints[2] = faceJPoints[vertI];
+              decomposedPoints[3] = faceJPoints[vertI - 1];
 
               // if the decomposed cell is the first one insert it to
               // the original position; or append to the decomposed cell
               // list otherwise
               if (insertDecomposedCell)
                 {
-                internalMesh->InsertNextCell(VTK_PYRAMID, 5,
-                    cellPoints->GetPointer(0));
+                arrays.SetCell(cellI, connectivityI, VTK_PYRAMID, 5,
+                    decomposedPoints);
                 insertDecomposedCell = false;
                 }
               else
                 {
                 nAdditionalCells++;
-                additionalCells->InsertNextTupleValue(
-                    cellPoints->GetPointer(0));
+                arrays.SetCell(additionalCellI++, additionalConnectivityI,
+                    VTK_PYRAMID, 5, decomposedPoints);
                 }
               }
             }
@@ -6456,33 +10903,33 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
             const int flipNeighbor = (this->FaceOwner->GetValue(cellFacesJ)
                 == cellId ? -1 : 1);
 
-            cellPoints->SetId(0,
-                faceJPoints[vertI == 2 ? 0 : nFaceJPoints - 1]);
-            cellPoints->SetId(4, this->NumPoints + nAdditionalPoints);
+            decomposedPoints[0]
+                = faceJPoints[vertI == 2 ? 0 : nFaceJPoints - 1];
+            decomposedPoints[4] = this->NumPoints + polyI;
 
             // decompose a face into quads in order (flipping the
             // decomposed face if owner)
-            const int nQuadVerts = nFaceJPoints - 1 - nTris;
+            const vtkIdType nQuadVerts = nFaceJPoints - 1 - nTris;
             for (; vertI < nQuadVerts; vertI += 2)
               {
-              cellPoints->SetId(1, faceJPoints[vertI - flipNeighbor]);
-              cellPoints->SetId(2, faceJPoints[vertI]);
-              cellPoints->SetId(3, faceJPoints[vertI + flipNeighbor]);
+              decomposedPoints[1] = faceJPoints[vertI - flipNeighbor];
+              decomposedPoints[2] = faceJPoints[vertI];
+              decomposedPoints[3] = faceJPoints[vertI + flipNeighbor];
 
               // if the decomposed cell is the first one insert it to
               // the original position; or append to the decomposed cell
               // list otherwise
               if (insertDecomposedCell)
                 {
-                internalMesh->InsertNextCell(VTK_PYRAMID, 5,
-                    cellPoints->GetPointer(0));
+                arrays.SetCell(cellI, connectivityI, VTK_PYRAMID, 5,
+                    decomposedPoints);
                 insertDecomposedCell = false;
                 }
               else
                 {
                 nAdditionalCells++;
-                additionalCells->InsertNextTupleValue(
-                    cellPoints->GetPointer(0));
+                arrays.SetCell(additionalCellI++, additionalConnectivityI,
+                    VTK_PYRAMID, 5, decomposedPoints);
                 }
               }
 
@@ -6491,94 +10938,99 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
               {
               if (flipNeighbor == -1)
                 {
-                cellPoints->SetId(1, faceJPoints[vertI]);
-                cellPoints->SetId(2, faceJPoints[vertI - 1]);
+                decomposedPoints[1] = faceJPoints[vertI];
+                decomposedPoints[2] = faceJPoints[vertI - 1];
                 }
               else
                 {
-                cellPoints->SetId(1, faceJPoints[vertI - 1]);
-                cellPoints->SetId(2, faceJPoints[vertI]);
+                decomposedPoints[1] = faceJPoints[vertI - 1];
+                decomposedPoints[2] = faceJPoints[vertI];
                 }
-              cellPoints->SetId(3, this->NumPoints + nAdditionalPoints);
+              decomposedPoints[3] = this->NumPoints + polyI;
 
               if (insertDecomposedCell)
                 {
-                internalMesh->InsertNextCell(VTK_TETRA, 4,
-                    cellPoints->GetPointer(0));
+                arrays.SetCell(cellI, connectivityI, VTK_TETRA, 4,
+                    decomposedPoints);
                 insertDecomposedCell = false;
                 }
               else
                 {
-                // set the 5th vertex number to -1 to distinguish a tetra cell
-                cellPoints->SetId(4, -1);
                 nAdditionalCells++;
-                additionalCells->InsertNextTupleValue(
-                    cellPoints->GetPointer(0));
+                arrays.SetCell(additionalCellI++, additionalConnectivityI,
+                    VTK_TETRA, 4, decomposedPoints);
                 }
               }
             }
           }
-        nAdditionalPoints++;
-        this->AdditionalCellIds->InsertNextValue(cellId);
-        this->NumAdditionalCells->InsertNextValue(nAdditionalCells);
-        this->NumTotalAdditionalCells += nAdditionalCells;
+
+        // a polyhedron without decomposable faces keeps its position
+        // as an empty cell
+        if (insertDecomposedCell)
+          {
+          vtksys_ios::ostringstream message;
+          message << "Warning: No decomposable faces in cellId " << cellId;
+          range.AddWarning(message);
+          arrays.SetCell(cellI, connectivityI, VTK_EMPTY_CELL, 0);
+          }
+        tasks.AdditionalCellIds[polyI] = cellId;
+        tasks.NumAdditionalCells[polyI] = static_cast<int>(nAdditionalCells);
+        polyI++;
         }
       else // don't decompose; use either VTK_POLYHEDRON or VTK_CONVEX_PONIT_SET
         {
+        // the face stream starts with the number of faces
+        faceLocations[cellI] = facesI;
+        vtkIdType *polyPoints = tasks.Faces + facesI;
+        polyPoints[0] = nCellFaces;
+
         // get first face
-        const int cellFaces0 = cellFaces[0];
-        const int *baseFacePoints = facePoints[cellFaces0];
-        const int nBaseFacePoints = facePoints.GetSize(cellFaces0);
+        const vtkIdType cellFaces0 = cellFaces[0];
+        const vtkIdType *baseFacePoints = facePoints[cellFaces0];
+        const vtkIdType nBaseFacePoints = facePoints.GetSize(cellFaces0);
 
-        int nPoints = nBaseFacePoints, nPolyPoints = nBaseFacePoints + 1;
-        if (nPoints > maxNPoints || nPolyPoints > maxNPolyPoints)
+        size_t nFacesPoints = 0;
+        for (vtkIdType j = 0; j < nCellFaces; j++)
           {
-          vtkErrorMacro(<< "Too large polyhedron at cellId = " << cellId);
-          this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-          cellPoints->Delete();
-          polyPoints->Delete();
-          return;
+          nFacesPoints += facePoints.GetSize(cellFaces[j]);
           }
-        polyPoints->SetId(0, nBaseFacePoints);
+        cellPointSet.Reset(nFacesPoints);
+
+        vtkIdType nPoints = nBaseFacePoints, nPolyPoints = nBaseFacePoints + 2;
+        polyPoints[1] = nBaseFacePoints;
         if (this->FaceOwner->GetValue(cellFaces0) == cellId)
           {
           // add first face to cell points
-          for (int j = 0; j < nBaseFacePoints; j++)
+          for (vtkIdType j = 0; j < nBaseFacePoints; j++)
             {
-            const int pointJ = baseFacePoints[j];
-            cellPoints->SetId(j, pointJ);
-            polyPoints->SetId(j + 1, pointJ);
+            const vtkIdType pointJ = baseFacePoints[j];
+            cellPoints[j] = pointJ;
+            polyPoints[j + 2] = pointJ;
+            cellPointSet.Insert(pointJ);
             }
           }
         else
           {
           // if it is a _neighbor_ face flip the points
-          for (int j = 0; j < nBaseFacePoints; j++)
+          for (vtkIdType j = 0; j < nBaseFacePoints; j++)
             {
-            const int pointJ = baseFacePoints[nBaseFacePoints - 1 - j];
-            cellPoints->SetId(j, pointJ);
-            polyPoints->SetId(j + 1, pointJ);
+            const vtkIdType pointJ = baseFacePoints[nBaseFacePoints - 1 - j];
+            cellPoints[j] = pointJ;
+            polyPoints[j + 2] = pointJ;
+            cellPointSet.Insert(pointJ);
             }
           }
 
         // loop through faces and create a list of all points
         // j = 1 skip baseFace
-        for (int j = 1; j < nCellFaces; j++)
+        for (vtkIdType j = 1; j < nCellFaces; j++)
           {
           // remove duplicate points from faces
-          const int cellFacesJ = cellFaces[j];
-          const int *faceJPoints = facePoints[cellFacesJ];
+          const vtkIdType cellFacesJ = cellFaces[j];
+          const vtkIdType *faceJPoints = facePoints[cellFacesJ];
           const size_t nFaceJPoints = facePoints.GetSize(cellFacesJ);
-          if (nPolyPoints >= maxNPolyPoints)
-            {
-            vtkErrorMacro(<< "Too large polyhedron at cellId = " << cellId);
-            this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-            cellPoints->Delete();
-            polyPoints->Delete();
-            return;
-            }
-          polyPoints->SetId(nPolyPoints++, nFaceJPoints);
-          int pointI, delta; // must be signed
+          polyPoints[nPolyPoints++] = nFaceJPoints;
+          vtkIdType pointI, delta; // must be signed
           if (this->FaceOwner->GetValue(cellFacesJ) == cellId)
             {
             pointI = 0;
@@ -6592,48 +11044,248 @@ void vtkOFFReaderPrivate::InsertCellsToGrid(
             }
           for (size_t k = 0; k < nFaceJPoints; k++, pointI += delta)
             {
-            const int faceJPointK = faceJPoints[pointI];
-            bool foundDup = false;
-            for (int l = 0; l < nPoints; l++)
-              {
-              if (cellPoints->GetId(l) == faceJPointK)
-                {
-                foundDup = true;
-                break; // look no more
-                }
-              }
-            if (!foundDup)
+            const vtkIdType faceJPointK = faceJPoints[pointI];
+            if (cellPointSet.Insert(faceJPointK))
               {
-              if (nPoints >= maxNPoints)
-                {
-                vtkErrorMacro(<< "Too large polyhedron at cellId = " << cellId);
-                this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-                cellPoints->Delete();
-                polyPoints->Delete();
-                return;
-                }
-              cellPoints->SetId(nPoints++, faceJPointK);
+              cellPoints[nPoints++] = faceJPointK;
               }
-            if (nPolyPoints >= maxNPolyPoints)
-                {
-                vtkErrorMacro(<< "Too large polyhedron at cellId = " << cellId);
-                this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-                cellPoints->Delete();
-                polyPoints->Delete();
-                return;
-                }
-            polyPoints->SetId(nPolyPoints++, faceJPointK);
+            polyPoints[nPolyPoints++] = faceJPointK;
             }
           }
 
         // create the poly cell and insert it into the mesh
-        internalMesh->InsertNextCell(VTK_POLYHEDRON, nPoints,
-            cellPoints->GetPointer(0), nCellFaces, polyPoints->GetPointer(0));
+        arrays.SetCell(cellI, connectivityI, VTK_POLYHEDRON, nPoints);
+        facesI += nPolyPoints;
         }
       }
     }
-  cellPoints->Delete();
-  polyPoints->Delete();
+
+  range.ConnectivityEnd = connectivityI;
+  range.AdditionalCellPointsEnd = additionalCellPointI;
+}
+
+//-----------------------------------------------------------------------------
+// build the cell arrays of a mesh and hand them to the grid at once.
+// The first pass classifies the cells and counts the sizes of the
+// arrays, the second pass fills the preallocated arrays. Both passes
+// run concurrently over ranges of cells; prefix sums of the counted
+// sizes give each range its own part of the arrays so that the cell
+// ordering does not depend on the number of threads.
+void vtkOFFReaderPrivate::InsertCellsToGrid(
+    vtkUnstructuredGrid* internalMesh,
+    const vtkFoamIntVectorVector *cellsFaces,
+    const vtkFoamIntVectorVector *facesPoints, vtkFloatArray *pointArray,
+    const bool decomposePolyhedra, vtkIntArray *cellList)
+{
+  const vtkIdType nCells = (cellList == NULL ? this->NumCells
+      : cellList->GetNumberOfTuples());
+
+  // split the cells into ranges
+  vtkIdType nRanges = 1;
+  if (VTK_FOAMFILE_MT_MINCELLS > 0)
+    {
+    nRanges = (nCells + VTK_FOAMFILE_MT_MINCELLS - 1)
+        / VTK_FOAMFILE_MT_MINCELLS;
+    if (nRanges < 1)
+      {
+      nRanges = 1;
+      }
+    }
+  vtkstd::vector<vtkFoamCellRange> ranges(nRanges);
+  for (vtkIdType rangeI = 0; rangeI < nRanges; rangeI++)
+    {
+    ranges[rangeI].Begin = static_cast<int>(static_cast<vtkIdType>(nCells)
+        * rangeI / nRanges);
+    ranges[rangeI].End = static_cast<int>(static_cast<vtkIdType>(nCells)
+        * (rangeI + 1) / nRanges);
+    }
+
+  vtkFoamCellTasks tasks;
+  tasks.Reader = this;
+  tasks.CellsFaces = cellsFaces;
+  tasks.FacesPoints = facesPoints;
+  tasks.PointArray = pointArray;
+  tasks.DecomposePolyhedra = decomposePolyhedra;
+  tasks.CellList = cellList;
+  tasks.Ranges = &ranges;
+  tasks.FaceLocations = tasks.Faces = NULL;
+  tasks.Centroids = NULL;
+  tasks.AdditionalCellIds = NULL;
+  tasks.NumAdditionalCells = NULL;
+  tasks.AdditionalCellPointIndices = tasks.AdditionalCellPointIds = NULL;
+
+  // first pass
+  vtkUnsignedCharArray *cellTypesArray = vtkUnsignedCharArray::New();
+  tasks.Arrays.Types = cellTypesArray->WritePointer(0, nCells);
+  tasks.Fill = false;
+  vtkFoamParallelTasks(nRanges, this->Parent->GetNumberOfThreads(), tasks);
+
+  // prefix sums of the counted sizes
+  vtkIdType connectivitySize = 0, additionalConnectivitySize = 0,
+      facesSize = 0, nTotalAdditionalCells = 0;
+  vtkIdType nPolyhedra = 0, additionalCellPointsSize = 0;
+  for (vtkIdType rangeI = 0; rangeI < nRanges; rangeI++)
+    {
+    vtkFoamCellRange &range = ranges[rangeI];
+    range.ConnectivityStart = connectivitySize;
+    range.AdditionalConnectivityStart = additionalConnectivitySize;
+    range.FacesStart = facesSize;
+    range.AdditionalCellStart = nTotalAdditionalCells;
+    range.PolyhedronStart = nPolyhedra;
+    range.AdditionalCellPointsStart = additionalCellPointsSize;
+    connectivitySize += range.ConnectivitySize;
+    additionalConnectivitySize += range.AdditionalConnectivitySize;
+    facesSize += range.FacesSize;
+    nTotalAdditionalCells += range.NAdditionalCells;
+    nPolyhedra += range.NPolyhedra;
+    additionalCellPointsSize += range.AdditionalCellPointsSize;
+    }
+  // the additional cells follow the original cells
+  for (vtkIdType rangeI = 0; rangeI < nRanges; rangeI++)
+    {
+    ranges[rangeI].AdditionalConnectivityStart += connectivitySize;
+    ranges[rangeI].AdditionalCellStart += nCells;
+    }
+  this->NumTotalAdditionalCells = static_cast<int>(nTotalAdditionalCells);
+
+  // allocate the cell arrays
+  const vtkIdType nTotalCells = nCells + nTotalAdditionalCells;
+  tasks.Arrays.Types = cellTypesArray->WritePointer(0, nTotalCells);
+  vtkIdTypeArray *cellLocationsArray = vtkIdTypeArray::New();
+  tasks.Arrays.Locations = cellLocationsArray->WritePointer(0, nTotalCells);
+  vtkIdTypeArray *connectivityArray = vtkIdTypeArray::New();
+  tasks.Arrays.Connectivity = connectivityArray->WritePointer(0,
+      connectivitySize + additionalConnectivitySize);
+
+  vtkIdTypeArray *faceLocationsArray = NULL, *facesArray = NULL;
+  if (facesSize > 0)
+    {
+    faceLocationsArray = vtkIdTypeArray::New();
+    tasks.FaceLocations = faceLocationsArray->WritePointer(0, nTotalCells);
+    facesArray = vtkIdTypeArray::New();
+    tasks.Faces = facesArray->WritePointer(0, facesSize);
+    }
+
+  if (decomposePolyhedra)
+    {
+    // for polyhedral decomposition: the centroids are appended to the
+    // point list and the point lists of the polyhedra are stored in a
+    // compact vector of vectors
+    this->AdditionalCellPoints = new vtkFoamIntVectorVector(nPolyhedra,
+        additionalCellPointsSize);
+    if (nPolyhedra > 0)
+      {
+      tasks.Centroids = pointArray->WritePointer(3 * this->NumPoints,
+          3 * nPolyhedra);
+      tasks.AdditionalCellIds = this->AdditionalCellIds->WritePointer(0,
+          nPolyhedra);
+      tasks.NumAdditionalCells = this->NumAdditionalCells->WritePointer(0,
+          nPolyhedra);
+      tasks.AdditionalCellPointIndices
+          = this->AdditionalCellPoints->GetIndices()->GetPointer(0);
+      tasks.AdditionalCellPointIds
+          = this->AdditionalCellPoints->GetBody()->GetPointer(0);
+      }
+    }
+
+  // second pass
+  tasks.Fill = true;
+  vtkFoamParallelTasks(nRanges, this->Parent->GetNumberOfThreads(), tasks);
+  for (vtkIdType rangeI = 0; rangeI < nRanges; rangeI++)
+    {
+    const vtkstd::vector<vtkStdString> &warnings = ranges[rangeI].Warnings;
+    for (size_t warningI = 0; warningI < warnings.size(); warningI++)
+      {
+      vtkWarningMacro(<< warnings[warningI].c_str());
+      }
+    }
+
+  // the point lists of the decomposed polyhedra have been allocated for
+  // the upper bound of the number of cell points as well
+  if (decomposePolyhedra)
+    {
+    vtkIdType *indices
+        = this->AdditionalCellPoints->GetIndices()->GetPointer(0);
+    vtkIdType *pointIds = tasks.AdditionalCellPointIds;
+    vtkIdType additionalCellPointsEnd = 0;
+    for (vtkIdType rangeI = 0; rangeI < nRanges; rangeI++)
+      {
+      const vtkFoamCellRange &range = ranges[rangeI];
+      const vtkIdType shift = range.AdditionalCellPointsStart
+          - additionalCellPointsEnd;
+      const vtkIdType size = range.AdditionalCellPointsEnd
+          - range.AdditionalCellPointsStart;
+      if (shift > 0)
+        {
+        memmove(pointIds + additionalCellPointsEnd,
+            pointIds + range.AdditionalCellPointsStart, size * sizeof(int));
+        const vtkIdType polyEnd = range.PolyhedronStart + range.NPolyhedra;
+        for (vtkIdType polyI = range.PolyhedronStart; polyI < polyEnd; polyI++)
+          {
+          indices[polyI] -= shift;
+          }
+        }
+      additionalCellPointsEnd += size;
+      }
+    indices[nPolyhedra] = additionalCellPointsEnd;
+    if (additionalCellPointsEnd < additionalCellPointsSize)
+      {
+      vtkIdTypeArray *body = this->AdditionalCellPoints->GetBody();
+      body->SetNumberOfValues(additionalCellPointsEnd);
+      body->Squeeze();
+      }
+    }
+
+  // the connectivity list of non-decomposed polyhedra has been
+  // allocated for the upper bound of the number of cell points: close
+  // the gaps between the ranges
+  if (!decomposePolyhedra && facesSize > 0)
+    {
+    vtkIdType *connectivity = tasks.Arrays.Connectivity;
+    vtkIdType *cellLocations = tasks.Arrays.Locations;
+    vtkIdType connectivityEnd = 0;
+    for (vtkIdType rangeI = 0; rangeI < nRanges; rangeI++)
+      {
+      const vtkFoamCellRange &range = ranges[rangeI];
+      const vtkIdType shift = range.ConnectivityStart - connectivityEnd;
+      const vtkIdType size = range.ConnectivityEnd - range.ConnectivityStart;
+      if (shift > 0)
+        {
+        memmove(connectivity + connectivityEnd,
+            connectivity + range.ConnectivityStart, size * sizeof(vtkIdType));
+        for (vtkIdType cellI = range.Begin; cellI < range.End; cellI++)
+          {
+          cellLocations[cellI] -= shift;
+          }
+        }
+      connectivityEnd += size;
+      }
+    if (connectivityEnd < connectivitySize)
+      {
+      connectivityArray->SetNumberOfValues(connectivityEnd);
+      connectivityArray->Squeeze();
+      }
+    }
+
+  // hand the cell arrays to the grid
+  cellTypesArray->Squeeze();
+  vtkCellArray *cells = vtkCellArray::New();
+  cells->SetCells(nTotalCells, connectivityArray);
+  if (facesArray != NULL)
+    {
+    internalMesh->SetCells(cellTypesArray, cellLocationsArray, cells,
+        faceLocationsArray, facesArray);
+    faceLocationsArray->Delete();
+    facesArray->Delete();
+    }
+  else
+    {
+    internalMesh->SetCells(cellTypesArray, cellLocationsArray, cells);
+    }
+  cells->Delete();
+  connectivityArray->Delete();
+  cellLocationsArray->Delete();
+  cellTypesArray->Delete();
 }
 
 //-----------------------------------------------------------------------------
@@ -6651,50 +11303,23 @@ vtkUnstructuredGrid *vtkOFFReaderPrivate::MakeInternalMesh(
 {
   // Create Mesh
   vtkUnstructuredGrid* internalMesh = vtkUnstructuredGrid::New();
-  internalMesh->Allocate(this->NumCells);
 
   if (this->Parent->GetDecomposePolyhedra())
     {
     // for polyhedral decomposition
-    this->AdditionalCellIds = vtkIntArray::New();
+    this->AdditionalCellIds = vtkIdTypeArray::New();
     this->NumAdditionalCells = vtkIntArray::New();
-    this->AdditionalCellPoints = new vtkFoamIdListVector;
-
-    vtkIdTypeArray *additionalCells = vtkIdTypeArray::New();
-    additionalCells->SetNumberOfComponents(5); // accommodates tetra or pyramid
 
     this->InsertCellsToGrid(internalMesh, cellsFaces, facesPoints, pointArray,
-        additionalCells, NULL);
+        true, NULL);
 
     // for polyhedral decomposition
     pointArray->Squeeze();
-    this->AdditionalCellIds->Squeeze();
-    this->NumAdditionalCells->Squeeze();
-    additionalCells->Squeeze();
-
-    // insert decomposed cells into mesh
-    const int nComponents = additionalCells->GetNumberOfComponents();
-    const int nAdditionalCells = additionalCells->GetNumberOfTuples();
-    for (int i = 0; i < nAdditionalCells; i++)
-      {
-      if (additionalCells->GetComponent(i, 4) == -1)
-        {
-        internalMesh->InsertNextCell(VTK_TETRA, 4,
-            additionalCells->GetPointer(i * nComponents));
-        }
-      else
-        {
-        internalMesh->InsertNextCell(VTK_PYRAMID, 5,
-            additionalCells->GetPointer(i * nComponents));
-        }
-      }
-    internalMesh->Squeeze();
-    additionalCells->Delete();
     }
   else
     {
     this->InsertCellsToGrid(internalMesh, cellsFaces, facesPoints, pointArray,
-        NULL, NULL);
+        false, NULL);
     }
 
   // set the internal mesh points
@@ -6726,10 +11351,10 @@ vtkPolyData* vtkOFFReaderPrivate::MakeSurfaceMesh(
   surfaceMesh->Allocate(this->NumInternalFaces);
 
   // Count the max number of points per face in mesh
-  int maxNFacePoints = 0;
-  for (int j = 0; j < this->NumInternalFaces; j++)
+  vtkIdType maxNFacePoints = 0;
+  for (vtkIdType j = 0; j < this->NumInternalFaces; j++)
     {
-    const int nFacePoints = facesPoints->GetSize(j);
+    const vtkIdType nFacePoints = facesPoints->GetSize(j);
     if (nFacePoints > maxNFacePoints)
       {
       maxNFacePoints = nFacePoints;
@@ -6761,7 +11386,7 @@ vtkPolyData* vtkOFFReaderPrivate::MakeSurfaceMesh(
     try
       {
       faceProcDict.ReadNonuniformList<vtkFoamToken::LABELLIST,
-        vtkFoamEntryValue::listTraits<vtkIntArray, int> >(io);
+        vtkFoamEntryValue::listTraits<vtkIntArray, vtkIdType> >(io);
       }
     catch(vtkFoamError& e)
       {
@@ -6774,18 +11399,19 @@ vtkPolyData* vtkOFFReaderPrivate::MakeSurfaceMesh(
 
     // first pass: count the number of processor faces to be added
     vtkIntArray *faceProc = static_cast<vtkIntArray *>(faceProcDict.Ptr());
-    int nNonNegFaces = 0;
+    vtkIdType nNonNegFaces = 0;
     for (int procBoundI = 0; procBoundI < nProcBoundaries; procBoundI++)
       {
       vtkFoamBoundaryEntry &beI
           = this->BoundaryDict[this->BoundaryDict.ProcBoundaries[procBoundI]];
-      const int startFace = beI.StartFace, endFace = startFace + beI.NFaces;
-      for (int faceI = startFace; faceI < endFace; faceI++)
+      const vtkIdType startFace = beI.StartFace,
+          endFace = startFace + beI.NFaces;
+      for (vtkIdType faceI = startFace; faceI < endFace; faceI++)
         {
         if (faceProc->GetValue(faceI) >= 0)
           {
           nNonNegFaces++;
-          const int nFacePoints = facesPoints->GetSize(faceI);
+          const vtkIdType nFacePoints = facesPoints->GetSize(faceI);
           if (nFacePoints > maxNFacePoints)
             {
             maxNFacePoints = nFacePoints;
@@ -6803,13 +11429,14 @@ vtkPolyData* vtkOFFReaderPrivate::MakeSurfaceMesh(
       nNonNegFaces = 0;
       for (int procBoundI = 0; procBoundI < nProcBoundaries; procBoundI++)
         {
-        int *procFaces = this->ProcessorFaces->SetIndex(procBoundI,
+        vtkIdType *procFaces = this->ProcessorFaces->SetIndex(procBoundI,
             nNonNegFaces);
         vtkFoamBoundaryEntry &beI
             = this->BoundaryDict[this->BoundaryDict.ProcBoundaries[procBoundI]];
-        const int startFace = beI.StartFace, endFace = startFace + beI.NFaces;
-        int nProcFaces = 0;
-        for (int faceI = startFace; faceI < endFace; faceI++)
+        const vtkIdType startFace = beI.StartFace,
+            endFace = startFace + beI.NFaces;
+        vtkIdType nProcFaces = 0;
+        for (vtkIdType faceI = startFace; faceI < endFace; faceI++)
           {
           if (faceProc->GetValue(faceI) >= 0)
             {
@@ -6818,7 +11445,7 @@ vtkPolyData* vtkOFFReaderPrivate::MakeSurfaceMesh(
           }
         this->InsertFacesToGrid(surfaceMesh, facesPoints, 0, nProcFaces, NULL,
             facePointsVtkId, procFaces, false);
-        for (int faceI = 0; faceI < nProcFaces; faceI++)
+        for (vtkIdType faceI = 0; faceI < nProcFaces; faceI++)
           {
           procFaces[faceI] -= startFace;
           }
@@ -6852,15 +11479,16 @@ vtkPolyData* vtkOFFReaderPrivate::MakeSurfaceMesh(
 //-----------------------------------------------------------------------------
 // insert faces to grid
 bool vtkOFFReaderPrivate::InsertFacesToGrid(vtkPolyData *boundaryMesh,
-    const vtkFoamIntVectorVector *facesPoints, int startFace, int endFace,
-    vtkIntArray *boundaryPointMap, vtkIdList *facePointsVtkId,
-    const int *labels, bool isLookupValue)
+    const vtkFoamIntVectorVector *facesPoints, vtkIdType startFace,
+    vtkIdType endFace, vtkIdTypeArray *boundaryPointMap,
+    vtkIdList *facePointsVtkId,
+    const vtkIdType *labels, bool isLookupValue)
 {
   vtkPolyData &bm = *boundaryMesh;
 
-  for (int j = startFace; j < endFace; j++)
+  for (vtkIdType j = startFace; j < endFace; j++)
     {
-    int faceId;
+    vtkIdType faceId;
     if (labels == NULL)
       {
       faceId = j;
@@ -6877,68 +11505,339 @@ bool vtkOFFReaderPrivate::InsertFacesToGrid(vtkPolyData *boundaryMesh,
         return false;
         }
       }
-    const int *facePoints = facesPoints->operator[](faceId);
+    const vtkIdType *facePoints = facesPoints->operator[](faceId);
     vtkIdType nFacePoints = facesPoints->GetSize(faceId);
 
     if (isLookupValue)
       {
       for (vtkIdType k = 0; k < nFacePoints; k++)
         {
-        facePointsVtkId->SetId(k, boundaryPointMap->LookupValue(facePoints[k]));
+        facePointsVtkId->SetId(k,
+            boundaryPointMap->LookupValue(facePoints[k]));
+        }
+      }
+    else
+      {
+      if (boundaryPointMap)
+        {
+        for (vtkIdType k = 0; k < nFacePoints; k++)
+          {
+          facePointsVtkId->SetId(k, boundaryPointMap->GetValue(facePoints[k]));
+          }
+        }
+      else
+        {
+        for (vtkIdType k = 0; k < nFacePoints; k++)
+          {
+          facePointsVtkId->SetId(k, facePoints[k]);
+          }
+        }
+      }
+
+    // triangle
+    if (nFacePoints == 3)
+      {
+      bm.InsertNextCell(VTK_TRIANGLE, 3, facePointsVtkId->GetPointer(0));
+      }
+    // quad
+    else if (nFacePoints == 4)
+      {
+      bm.InsertNextCell(VTK_QUAD, 4, facePointsVtkId->GetPointer(0));
+      }
+    // polygon
+    else
+      {
+      bm.InsertNextCell(VTK_POLYGON, nFacePoints,
+          facePointsVtkId->GetPointer(0));
+      }
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// build the point-to-face adjacency of the physical and processor patch
+// faces in CSR form, indexed by the global point ids. facesPoints begins
+// at face number faceOffset.
+void vtkOFFReaderPrivate::BuildAllBoundariesPointFaces(
+    const vtkFoamIntVectorVector *facesPoints, const vtkIdType faceOffset)
+{
+  const int nBoundaries = static_cast<int>(this->BoundaryDict.size());
+  const vtkIdType nPoints = this->NumPoints;
+
+  // if reading a processor sub-case, mark belonging boundary types of
+  // points so that the references to processor boundary faces can be
+  // omitted from physical-processor shared points to avoid cracky seams
+  // on fixedValue-type boundaries which are noticeable when all the
+  // decomposed meshes are appended
+  vtkstd::vector<unsigned char> pointTypes;
+  if (this->ProcessorName != "")
+    {
+    pointTypes.resize(nPoints, 0);
+    for (int boundaryI = 0; boundaryI < nBoundaries; boundaryI++)
+      {
+      const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
+      if (beI.BoundaryType == vtkFoamBoundaryEntry::PHYSICAL
+          || beI.BoundaryType == vtkFoamBoundaryEntry::PROCESSOR)
+        {
+        const vtkIdType startFace = beI.StartFace - faceOffset;
+        const vtkIdType endFace = startFace + beI.NFaces;
+        for (vtkIdType j = startFace; j < endFace; j++)
+          {
+          const vtkIdType *facePoints = facesPoints->operator[](j);
+          const vtkIdType nFacePoints = facesPoints->GetSize(j);
+          for (vtkIdType k = 0; k < nFacePoints; k++)
+            {
+            pointTypes[facePoints[k]] |= beI.BoundaryType;
+            }
+          }
+        }
+      }
+    }
+  const unsigned char sharedPoint = vtkFoamBoundaryEntry::PHYSICAL
+      | vtkFoamBoundaryEntry::PROCESSOR;
+
+  this->AllBoundariesPointFaces = new vtkFoamIntVectorVector(nPoints, 0);
+  vtkIdType *indices
+      = this->AllBoundariesPointFaces->GetIndices()->GetPointer(0);
+  for (vtkIdType pointI = 0; pointI <= nPoints; pointI++)
+    {
+    indices[pointI] = 0;
+    }
+
+  // count the faces of each point, shifted by one for the prefix sum
+  this->NumAllBoundariesFaces = 0;
+  for (int boundaryI = 0; boundaryI < nBoundaries; boundaryI++)
+    {
+    const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
+    if (beI.BoundaryType != vtkFoamBoundaryEntry::PHYSICAL
+        && beI.BoundaryType != vtkFoamBoundaryEntry::PROCESSOR)
+      {
+      continue;
+      }
+    const bool omitShared = !pointTypes.empty()
+        && beI.BoundaryType == vtkFoamBoundaryEntry::PROCESSOR;
+    const vtkIdType startFace = beI.StartFace - faceOffset;
+    const vtkIdType endFace = startFace + beI.NFaces;
+    for (vtkIdType j = startFace; j < endFace; j++)
+      {
+      const vtkIdType *facePoints = facesPoints->operator[](j);
+      const vtkIdType nFacePoints = facesPoints->GetSize(j);
+      for (vtkIdType k = 0; k < nFacePoints; k++)
+        {
+        const vtkIdType pointK = facePoints[k];
+        if (!omitShared || pointTypes[pointK] != sharedPoint)
+          {
+          indices[pointK + 1]++;
+          }
+        }
+      }
+    this->NumAllBoundariesFaces += beI.NFaces;
+    }
+  for (vtkIdType pointI = 0; pointI < nPoints; pointI++)
+    {
+    indices[pointI + 1] += indices[pointI];
+    }
+
+  // fill, using indices as the insertion positions and shifting them
+  // back afterwards
+  vtkIdTypeArray *bodyArray = this->AllBoundariesPointFaces->GetBody();
+  bodyArray->SetNumberOfValues(indices[nPoints]);
+  vtkIdType *body = bodyArray->GetPointer(0);
+  for (int boundaryI = 0; boundaryI < nBoundaries; boundaryI++)
+    {
+    const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
+    if (beI.BoundaryType != vtkFoamBoundaryEntry::PHYSICAL
+        && beI.BoundaryType != vtkFoamBoundaryEntry::PROCESSOR)
+      {
+      continue;
+      }
+    const bool omitShared = !pointTypes.empty()
+        && beI.BoundaryType == vtkFoamBoundaryEntry::PROCESSOR;
+    const vtkIdType startFace = beI.StartFace - faceOffset;
+    const vtkIdType nFaces = beI.NFaces;
+    for (vtkIdType faceI = 0; faceI < nFaces; faceI++)
+      {
+      const vtkIdType abFaceI = beI.AllBoundariesStartFace + faceI;
+      const vtkIdType *facePoints = facesPoints->operator[](startFace + faceI);
+      const vtkIdType nFacePoints = facesPoints->GetSize(startFace + faceI);
+      for (vtkIdType k = 0; k < nFacePoints; k++)
+        {
+        const vtkIdType pointK = facePoints[k];
+        if (!omitShared || pointTypes[pointK] != sharedPoint)
+          {
+          body[indices[pointK]++] = abFaceI;
+          }
         }
       }
-    else
+    }
+  for (vtkIdType pointI = nPoints; pointI > 0; pointI--)
+    {
+    indices[pointI] = indices[pointI - 1];
+    }
+  indices[0] = 0;
+}
+
+//-----------------------------------------------------------------------------
+// gathers the points of one boundary patch per task through the
+// boundary point map into an array created by the caller
+struct vtkFoamBoundaryPointsTasks
+{
+  const vtkIdType *Indices;
+  const vtkIdType *PointIds;
+  const float *PointArray;
+  vtkstd::vector<vtkFloatArray *> Points;
+
+  void operator()(const vtkIdType patchI) const
+  {
+    const vtkIdType *pointIds = this->PointIds + this->Indices[patchI];
+    const vtkIdType nPoints
+        = this->Indices[patchI + 1] - this->Indices[patchI];
+    this->Points[patchI]->SetNumberOfTuples(nPoints);
+    float *points = this->Points[patchI]->GetPointer(0);
+    for (vtkIdType pointI = 0; pointI < nPoints; pointI++)
+      {
+      const float *point = this->PointArray + 3 * pointIds[pointI];
+      points[3 * pointI] = point[0];
+      points[3 * pointI + 1] = point[1];
+      points[3 * pointI + 2] = point[2];
+      }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// builds the boundary point map and the polygons of one active patch
+// per task. The first pass counts the unique points of each patch into
+// the map indices, which the caller turns into the start of each patch
+// in the map by a prefix sum; the second pass fills the map and the
+// polygons with the point ids remapped to the patch-local ones.
+//
+// Each thread takes a pointPositions array of its own from a pool.
+// The arrays are never reset: the first pass stamps a point seen in
+// patch patchI with -(patchI + 2), and the second pass stores its
+// position in the map, so that neither a stamp nor a position from
+// the other patches, all of whose positions are outside the range of
+// the patch, can be taken for a point of the patch.
+struct vtkFoamBoundaryMapTasks
+{
+  const vtkFoamIntVectorVector *FacesPoints;
+  vtkIdType NumPoints;
+  // the face ranges of the active patches in FacesPoints
+  vtkstd::vector<vtkIdType> StartFaces, EndFaces;
+  vtkIdType *MapIndices;
+  vtkIdType *MapBody;
+  vtkstd::vector<vtkIdType *> Cells;
+  bool Fill;
+
+  vtkSimpleMutexLock Lock;
+  vtkstd::vector<vtkstd::vector<vtkIdType> *> FreePositions;
+
+  vtkFoamBoundaryMapTasks() :
+    FacesPoints(NULL), NumPoints(0), MapIndices(NULL), MapBody(NULL),
+        Fill(false)
+  {
+  }
+  ~vtkFoamBoundaryMapTasks()
+  {
+    for (size_t arrayI = 0; arrayI < this->FreePositions.size(); arrayI++)
+      {
+      delete this->FreePositions[arrayI];
+      }
+  }
+
+  void operator()(const vtkIdType patchI)
+  {
+    this->Lock.Lock();
+    vtkstd::vector<vtkIdType> *positionsPtr = NULL;
+    if (!this->FreePositions.empty())
+      {
+      positionsPtr = this->FreePositions.back();
+      this->FreePositions.pop_back();
+      }
+    this->Lock.Unlock();
+    if (positionsPtr == NULL)
+      {
+      positionsPtr = new vtkstd::vector<vtkIdType>(
+          static_cast<size_t>(this->NumPoints), -1);
+      }
+    vtkIdType *pointPositions = &(*positionsPtr)[0];
+
+    const vtkFoamIntVectorVector *facesPoints = this->FacesPoints;
+    const vtkIdType startFace = this->StartFaces[patchI];
+    const vtkIdType endFace = this->EndFaces[patchI];
+    if (!this->Fill)
       {
-      if (boundaryPointMap)
+      const vtkIdType stamp = -patchI - 2;
+      vtkIdType nPatchPoints = 0;
+      for (vtkIdType faceI = startFace; faceI < endFace; faceI++)
         {
+        const vtkIdType *facePoints = facesPoints->operator[](faceI);
+        const vtkIdType nFacePoints = facesPoints->GetSize(faceI);
         for (vtkIdType k = 0; k < nFacePoints; k++)
           {
-          facePointsVtkId->SetId(k, boundaryPointMap->GetValue(facePoints[k]));
+          const vtkIdType pointK = facePoints[k];
+          if (pointPositions[pointK] != stamp)
+            {
+            pointPositions[pointK] = stamp;
+            nPatchPoints++;
+            }
           }
         }
-      else
-        {
+      this->MapIndices[patchI + 1] = nPatchPoints;
+      }
+    else
+      {
+      // polygons in the [n, id0, id1, ...] layout of vtkCellArray
+      const vtkIdType patchStart = this->MapIndices[patchI];
+      const vtkIdType patchEnd = this->MapIndices[patchI + 1];
+      vtkIdType *mapBody = this->MapBody;
+      vtkIdType nMapPoints = patchStart;
+      vtkIdType *cells = this->Cells[patchI];
+      for (vtkIdType faceI = startFace; faceI < endFace; faceI++)
+        {
+        const vtkIdType *facePoints = facesPoints->operator[](faceI);
+        const vtkIdType nFacePoints = facesPoints->GetSize(faceI);
+        *cells++ = nFacePoints;
         for (vtkIdType k = 0; k < nFacePoints; k++)
           {
-          facePointsVtkId->SetId(k, facePoints[k]);
+          const vtkIdType pointK = facePoints[k];
+          const vtkIdType position = pointPositions[pointK];
+          if (position < patchStart || position >= patchEnd)
+            {
+            pointPositions[pointK] = nMapPoints;
+            mapBody[nMapPoints] = pointK;
+            cells[k] = nMapPoints++ - patchStart;
+            }
+          else
+            {
+            cells[k] = position - patchStart;
+            }
           }
+        cells += nFacePoints;
         }
       }
 
-    // triangle
-    if (nFacePoints == 3)
-      {
-      bm.InsertNextCell(VTK_TRIANGLE, 3, facePointsVtkId->GetPointer(0));
-      }
-    // quad
-    else if (nFacePoints == 4)
-      {
-      bm.InsertNextCell(VTK_QUAD, 4, facePointsVtkId->GetPointer(0));
-      }
-    // polygon
-    else
-      {
-      bm.InsertNextCell(VTK_POLYGON, nFacePoints,
-          facePointsVtkId->GetPointer(0));
-      }
-    }
-  return true;
-}
+    this->Lock.Lock();
+    this->FreePositions.push_back(positionsPtr);
+    this->Lock.Unlock();
+  }
+};
 
 //-----------------------------------------------------------------------------
-// returns requested boundary meshes
+// returns requested boundary meshes. facesPoints begins at face number
+// faceOffset.
 vtkMultiBlockDataSet *vtkOFFReaderPrivate::MakeBoundaryMesh(
-    const vtkFoamIntVectorVector *facesPoints, vtkFloatArray* pointArray)
+    const vtkFoamIntVectorVector *facesPoints, vtkFloatArray* pointArray,
+    const vtkIdType faceOffset)
 {
   const vtkIdType nBoundaries = static_cast<vtkIdType>(this->BoundaryDict.size());
 
   // do a consistency check of BoundaryDict
-  int previousEndFace = -1;
+  vtkIdType previousEndFace = -1;
   for (int boundaryI = 0; boundaryI < nBoundaries; boundaryI++)
     {
     const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
-    const int startFace = beI.StartFace;
-    const int nFaces = beI.NFaces;
+    const vtkIdType startFace = beI.StartFace;
+    const vtkIdType nFaces = beI.NFaces;
     if (startFace < 0 || nFaces < 0)
       {
       vtkErrorMacro(<<"Neither of startFace " << startFace << " nor nFaces "
@@ -6958,12 +11857,13 @@ vtkMultiBlockDataSet *vtkOFFReaderPrivate::MakeBoundaryMesh(
       }
     previousEndFace = startFace + nFaces;
     }
-  if (previousEndFace > facesPoints->GetNumberOfElements())
+  if (previousEndFace > faceOffset + facesPoints->GetNumberOfElements())
     {
     vtkErrorMacro(<<"The end face number " << previousEndFace - 1
         << " of the last patch "
         << this->BoundaryDict[nBoundaries - 1].BoundaryName.c_str()
-        << " exceeds the number of faces " << facesPoints->GetNumberOfElements());
+        << " exceeds the number of faces "
+        << faceOffset + facesPoints->GetNumberOfElements());
     this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
     return NULL;
     }
@@ -6972,150 +11872,19 @@ vtkMultiBlockDataSet *vtkOFFReaderPrivate::MakeBoundaryMesh(
 
   if (this->Parent->GetCreateCellToPoint())
     {
-    const int boundaryStartFace =
-        (this->BoundaryDict.size() > 0 ? this->BoundaryDict[0].StartFace : 0);
-    this->AllBoundaries = vtkPolyData::New();
-    this->AllBoundaries->Allocate(facesPoints->GetNumberOfElements()
-        - boundaryStartFace);
-    }
-  this->BoundaryPointMap = new vtkFoamIntArrayVector;
-
-  vtkIntArray *nBoundaryPointsList = vtkIntArray::New();
-  nBoundaryPointsList->SetNumberOfValues(nBoundaries);
-
-  // count the max number of points per face and the number of points
-  // (with duplicates) in mesh
-  int maxNFacePoints = 0;
-  for (int boundaryI = 0; boundaryI < nBoundaries; boundaryI++)
-    {
-    const int startFace = this->BoundaryDict[boundaryI].StartFace;
-    const int endFace = startFace + this->BoundaryDict[boundaryI].NFaces;
-    int nPoints = 0;
-    for (int j = startFace; j < endFace; j++)
-      {
-      const int nFacePoints = facesPoints->GetSize(j);
-      nPoints += nFacePoints;
-      if (nFacePoints > maxNFacePoints)
-        {
-        maxNFacePoints = nFacePoints;
-        }
-      }
-    nBoundaryPointsList->SetValue(boundaryI, nPoints);
-    }
-
-  // aloocate array for converting int vector to vtkIdType List:
-  // workaround for 64bit machines
-  vtkIdList *facePointsVtkId = vtkIdList::New();
-  facePointsVtkId->SetNumberOfIds(maxNFacePoints);
-
-  // create initial internal point list: set all points to -1
-  if (this->Parent->GetCreateCellToPoint())
-    {
-    this->InternalPoints = vtkIntArray::New();
-    this->InternalPoints->SetNumberOfValues(this->NumPoints);
-    for (int pointI = 0; pointI < this->NumPoints; pointI++)
-      {
-      this->InternalPoints->SetValue(pointI, -1);
-      }
-
-    // mark boundary points as 0
-    for (int boundaryI = 0; boundaryI < nBoundaries; boundaryI++)
-      {
-      const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
-      if (beI.BoundaryType == vtkFoamBoundaryEntry::PHYSICAL
-          || beI.BoundaryType == vtkFoamBoundaryEntry::PROCESSOR)
-        {
-        const int startFace = beI.StartFace;
-        const int endFace = startFace + beI.NFaces;
-
-        for (int j = startFace; j < endFace; j++)
-          {
-          const int *facePoints = facesPoints->operator[](j);
-          const int nFacePoints = facesPoints->GetSize(j);
-          for (int k = 0; k < nFacePoints; k++)
-            {
-            this->InternalPoints->SetValue(facePoints[k], 0);
-            }
-          }
-        }
-      }
-    }
-
-  int nAllBoundaryPoints = 0;
-  vtkstd::vector<vtkstd::vector<int> > procCellList;
-  vtkIntArray *pointTypes = NULL;
-
-  if (this->Parent->GetCreateCellToPoint())
-    {
-    // create global to AllBoundaries point map
-    for (int pointI = 0; pointI < this->NumPoints; pointI++)
-      {
-      if (this->InternalPoints->GetValue(pointI) == 0)
-        {
-        this->InternalPoints->SetValue(pointI, nAllBoundaryPoints);
-        nAllBoundaryPoints++;
-        }
-      }
-
-    if (this->ProcessorName != "")
-      {
-      // initialize physical-processor boundary shared point list
-      procCellList.resize(nAllBoundaryPoints);
-      pointTypes = vtkIntArray::New();
-      pointTypes->SetNumberOfTuples(nAllBoundaryPoints);
-      for (int pointI = 0; pointI < nAllBoundaryPoints; pointI++)
-        {
-        pointTypes->SetValue(pointI, 0);
-        }
-      }
+    this->BuildAllBoundariesPointFaces(facesPoints, faceOffset);
     }
-
+  // create the meshes of the active patches and their polygon arrays
+  // sized by the numbers of the face points
+  vtkFoamBoundaryMapTasks mapTasks;
+  mapTasks.FacesPoints = facesPoints;
+  mapTasks.NumPoints = this->NumPoints;
+  vtkstd::vector<vtkIdTypeArray *> cellsArrays;
+  vtkFoamBoundaryPointsTasks tasks;
+  tasks.PointArray = pointArray->GetPointer(0);
   for (int boundaryI = 0; boundaryI < nBoundaries; boundaryI++)
     {
     const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
-    const int nFaces = beI.NFaces;
-    const int startFace = beI.StartFace;
-    const int endFace = startFace + nFaces;
-
-    if (this->Parent->GetCreateCellToPoint() && (beI.BoundaryType
-        == vtkFoamBoundaryEntry::PHYSICAL || beI.BoundaryType
-        == vtkFoamBoundaryEntry::PROCESSOR))
-      {
-      // add faces to AllBoundaries
-      this->InsertFacesToGrid(this->AllBoundaries, facesPoints, startFace,
-          endFace, this->InternalPoints, facePointsVtkId, NULL, false);
-
-      if (this->ProcessorName != "")
-        {
-        // mark belonging boundary types and, if PROCESSOR, cell numbers
-        const int abStartFace = beI.AllBoundariesStartFace;
-        const int abEndFace = abStartFace + beI.NFaces;
-        for (int faceI = abStartFace; faceI < abEndFace; faceI++)
-          {
-          vtkIdType nPoints;
-          vtkIdType *points;
-          this->AllBoundaries->GetCellPoints(faceI, nPoints, points);
-          if (beI.BoundaryType == vtkFoamBoundaryEntry::PHYSICAL)
-            {
-            for (int pointI = 0; pointI < nPoints; pointI++)
-              {
-              *pointTypes->GetPointer(points[pointI])
-                  |= vtkFoamBoundaryEntry::PHYSICAL;
-              }
-            }
-          else // PROCESSOR
-            {
-            for (int pointI = 0; pointI < nPoints; pointI++)
-              {
-              const int pointJ = points[pointI];
-              *pointTypes->GetPointer(pointJ)
-                  |= vtkFoamBoundaryEntry::PROCESSOR;
-              procCellList[pointJ].push_back(faceI);
-              }
-            }
-          }
-        }
-      }
 
     // skip below if inactive
     if (!beI.IsActive)
@@ -7131,53 +11900,20 @@ vtkMultiBlockDataSet *vtkOFFReaderPrivate::MakeBoundaryMesh(
     // set the name of boundary
     this->SetBlockName(boundaryMesh, activeBoundaryI, beI.BoundaryName.c_str());
 
-    bm->Allocate(nFaces);
-    const int nBoundaryPoints = nBoundaryPointsList->GetValue(boundaryI);
+    const vtkIdType nFaces = beI.NFaces;
+    const vtkIdType startFace = beI.StartFace - faceOffset;
+    const vtkIdType endFace = startFace + nFaces;
+    mapTasks.StartFaces.push_back(startFace);
+    mapTasks.EndFaces.push_back(endFace);
+    vtkIdTypeArray *cellsArray = vtkIdTypeArray::New();
+    cellsArray->SetNumberOfValues(nFaces + (facesPoints->operator[](endFace)
+        - facesPoints->operator[](startFace)));
+    mapTasks.Cells.push_back(cellsArray->GetPointer(0));
+    cellsArrays.push_back(cellsArray);
 
-    // create global to boundary-local point map and boundary points
-    vtkIntArray *boundaryPointList = vtkIntArray::New();
-    boundaryPointList->SetNumberOfValues(nBoundaryPoints);
-    int pointI = 0;
-    for (int j = startFace; j < endFace; j++)
-      {
-      const int *facePoints = facesPoints->operator[](j);
-      int nFacePoints = facesPoints->GetSize(j);
-      for (int k = 0; k < nFacePoints; k++)
-        {
-        boundaryPointList->SetValue(pointI, facePoints[k]);
-        pointI++;
-        }
-      }
-    vtkSortDataArray::Sort(boundaryPointList);
-    this->BoundaryPointMap->push_back(vtkIntArray::New());
-    vtkIntArray& bpMap = *this->BoundaryPointMap->back();
     vtkFloatArray *boundaryPointArray = vtkFloatArray::New();
     boundaryPointArray->SetNumberOfComponents(3);
-    int oldPointJ = -1;
-    for (int j = 0; j < nBoundaryPoints; j++)
-      {
-      const int pointJ = boundaryPointList->GetValue(j);
-      if (pointJ != oldPointJ)
-        {
-        oldPointJ = pointJ;
-        boundaryPointArray->InsertNextTuple(pointArray->GetPointer(3 * pointJ));
-        bpMap.InsertNextValue(pointJ);
-        }
-      }
-    boundaryPointArray->Squeeze();
-    bpMap.Squeeze();
-    boundaryPointList->Delete();
-    vtkPoints *boundaryPoints = vtkPoints::New();
-    boundaryPoints->SetData(boundaryPointArray);
-    boundaryPointArray->Delete();
-
-    // set points for boundary
-    bm->SetPoints(boundaryPoints);
-    boundaryPoints->Delete();
-
-    // insert faces to boundary mesh
-    this->InsertFacesToGrid(bm, facesPoints, startFace, endFace, &bpMap,
-        facePointsVtkId, NULL, true);
+    tasks.Points.push_back(boundaryPointArray);
 
     vtkIntArray *bt = vtkIntArray::New();
     bt->SetNumberOfTuples(1);
@@ -7203,76 +11939,55 @@ vtkMultiBlockDataSet *vtkOFFReaderPrivate::MakeBoundaryMesh(
       }
 
     bm->Delete();
-    bpMap.ClearLookup();
     }
-
-  nBoundaryPointsList->Delete();
-  facePointsVtkId->Delete();
-
-  if (this->Parent->GetCreateCellToPoint())
+  const int nActivePatches = static_cast<int>(cellsArrays.size());
+
+  // count the unique points of each patch concurrently, then give each
+  // patch its part of the boundary point map by a prefix sum
+  vtkstd::vector<vtkIdType> patchStarts(nActivePatches + 1, 0);
+  mapTasks.MapIndices = &patchStarts[0];
+  mapTasks.Fill = false;
+  vtkFoamParallelTasks(nActivePatches, this->Parent->GetNumberOfThreads(),
+      mapTasks);
+  for (int patchI = 0; patchI < nActivePatches; patchI++)
+    {
+    patchStarts[patchI + 1] += patchStarts[patchI];
+    }
+
+  // build the map and the polygons of each patch concurrently
+  this->BoundaryPointMap = new vtkFoamIntVectorVector(nActivePatches,
+      patchStarts[nActivePatches]);
+  vtkIdType *bpmIndices = this->BoundaryPointMap->GetIndices()->GetPointer(0);
+  vtkstd::copy(patchStarts.begin(), patchStarts.end(), bpmIndices);
+  mapTasks.MapIndices = bpmIndices;
+  mapTasks.MapBody = this->BoundaryPointMap->GetBody()->GetPointer(0);
+  mapTasks.Fill = true;
+  vtkFoamParallelTasks(nActivePatches, this->Parent->GetNumberOfThreads(),
+      mapTasks);
+  for (int patchI = 0; patchI < nActivePatches; patchI++)
+    {
+    vtkCellArray *polys = vtkCellArray::New();
+    polys->SetCells(mapTasks.EndFaces[patchI] - mapTasks.StartFaces[patchI],
+        cellsArrays[patchI]);
+    cellsArrays[patchI]->Delete();
+    vtkPolyData::SafeDownCast(boundaryMesh->GetBlock(patchI))
+    ->SetPolys(polys);
+    polys->Delete();
+    }
+
+  // gather the boundary points concurrently
+  tasks.Indices = bpmIndices;
+  tasks.PointIds = this->BoundaryPointMap->GetBody()->GetPointer(0);
+  vtkFoamParallelTasks(nActivePatches, this->Parent->GetNumberOfThreads(),
+      tasks);
+  for (int patchI = 0; patchI < nActivePatches; patchI++)
     {
-    this->AllBoundaries->Squeeze();
-    this->AllBoundariesPointMap = vtkIntArray::New();
-    vtkIntArray &abpMap = *this->AllBoundariesPointMap;
-    abpMap.SetNumberOfValues(nAllBoundaryPoints);
-
-    // create lists of internal points and AllBoundaries points
-    int nInternalPoints = 0;
-    for (int pointI = 0, allBoundaryPointI = 0; pointI < this->NumPoints; pointI++)
-      {
-      const int globalPointId = this->InternalPoints->GetValue(pointI);
-      if (globalPointId == -1)
-        {
-        this->InternalPoints->SetValue(nInternalPoints, pointI);
-        nInternalPoints++;
-        }
-      else
-        {
-        abpMap.SetValue(allBoundaryPointI, pointI);
-        allBoundaryPointI++;
-        }
-      }
-    // shrink to the number of internal points
-    if (nInternalPoints > 0)
-      {
-      this->InternalPoints->Resize(nInternalPoints);
-      }
-    else
-      {
-      this->InternalPoints->Delete();
-      this->InternalPoints = NULL;
-      }
-
-    // set dummy vtkPoints to tell the grid the number of points
-    // (otherwise GetPointCells will crash)
-    vtkPoints *allBoundaryPoints = vtkPoints::New();
-    allBoundaryPoints->SetNumberOfPoints(abpMap.GetNumberOfTuples());
-    this->AllBoundaries->SetPoints(allBoundaryPoints);
-    allBoundaryPoints->Delete();
-
-    if (this->ProcessorName != "")
-      {
-      // remove links to processor boundary faces from point-to-cell
-      // links of physical-processor shared points to avoid cracky seams
-      // on fixedValue-type boundaries which are noticeable when all the
-      // decomposed meshes are appended
-      this->AllBoundaries->BuildLinks();
-      for (int pointI = 0; pointI < nAllBoundaryPoints; pointI++)
-        {
-        if (pointTypes->GetValue(pointI) == (vtkFoamBoundaryEntry::PHYSICAL
-            | vtkFoamBoundaryEntry::PROCESSOR))
-          {
-          const vtkstd::vector<int> &procCells = procCellList[pointI];
-          for (size_t cellI = 0; cellI < procCellList[pointI].size(); cellI++)
-            {
-            this->AllBoundaries->RemoveReferenceToCell(pointI, procCells[cellI]);
-            }
-          // omit reclaiming memory as the possibly recovered size should
-          // not typically be so large
-          }
-        }
-      pointTypes->Delete();
-      }
+    vtkPoints *boundaryPoints = vtkPoints::New();
+    boundaryPoints->SetData(tasks.Points[patchI]);
+    tasks.Points[patchI]->Delete();
+    vtkPolyData::SafeDownCast(boundaryMesh->GetBlock(patchI))
+    ->SetPoints(boundaryPoints);
+    boundaryPoints->Delete();
     }
 
   return boundaryMesh;
@@ -7282,11 +11997,11 @@ vtkMultiBlockDataSet *vtkOFFReaderPrivate::MakeBoundaryMesh(
 // truncate face owner to have only boundary face info
 void vtkOFFReaderPrivate::TruncateFaceOwner()
 {
-  const int boundaryStartFace =
+  const vtkIdType boundaryStartFace =
       this->BoundaryDict.size() > 0 ? this->BoundaryDict[0].StartFace
           : this->FaceOwner->GetNumberOfTuples();
   // all the boundary faces
-  const int nBoundaryFaces = this->FaceOwner->GetNumberOfTuples()
+  const vtkIdType nBoundaryFaces = this->FaceOwner->GetNumberOfTuples()
       - boundaryStartFace;
   memmove(this->FaceOwner->GetPointer(0),
       this->FaceOwner->GetPointer(boundaryStartFace), sizeof(int)
@@ -7298,9 +12013,9 @@ void vtkOFFReaderPrivate::TruncateFaceOwner()
 // this is necessary due to the strange vtkDataArrayTemplate::Resize()
 // implementation when the array size is to be extended
 template <typename T1, typename T2> bool vtkOFFReaderPrivate::ExtendArray(
-    T1 *array, const int nTuples)
+    T1 *array, const vtkIdType nTuples)
 {
-  const int newSize = nTuples * array->GetNumberOfComponents();
+  const vtkIdType newSize = nTuples * array->GetNumberOfComponents();
   void *ptr = malloc(newSize * array->GetDataTypeSize());
   if (ptr == NULL)
     {
@@ -7422,6 +12137,50 @@ void vtkOFFReaderPrivate::CalculateReciprocalDelta(
 }
 #endif
 
+//-----------------------------------------------------------------------------
+// averages the tuples of the points of each decomposed polyhedron into
+// the tuple of its centroidal point, which follows the original points.
+// accumT is the type the tuples are summed up in.
+template <typename accumT> struct vtkFoamAverageCellPoints
+{
+  const vtkIdType *Indices;
+  const vtkIdType *PointIds;
+  float *Data;
+  int NComponents;
+  vtkIdType NPoints;
+
+  void operator()(const vtkIdType begin, const vtkIdType end) const
+  {
+    const int nComponents = this->NComponents;
+    accumT average[9]; // up to tensors
+    for (vtkIdType polyI = begin; polyI < end; polyI++)
+      {
+      for (int k = 0; k < nComponents; k++)
+        {
+        average[k] = 0;
+        }
+      const vtkIdType *pointIds = this->PointIds + this->Indices[polyI];
+      const vtkIdType nCellPoints
+          = this->Indices[polyI + 1] - this->Indices[polyI];
+      for (vtkIdType j = 0; j < nCellPoints; j++)
+        {
+        const float *tuple = this->Data + nComponents * pointIds[j];
+        for (int k = 0; k < nComponents; k++)
+          {
+          average[k] += tuple[k];
+          }
+        }
+      const accumT weight = (nCellPoints ? static_cast<accumT>(1)
+          / static_cast<accumT>(nCellPoints) : static_cast<accumT>(0));
+      float *centroid = this->Data + nComponents * (this->NPoints + polyI);
+      for (int k = 0; k < nComponents; k++)
+        {
+        centroid[k] = static_cast<float>(average[k] * weight);
+        }
+      }
+  }
+};
+
 //-----------------------------------------------------------------------------
 // move polyhedral cell centroids
 vtkPoints *vtkOFFReaderPrivate::MoveInternalMesh(
@@ -7429,29 +12188,18 @@ vtkPoints *vtkOFFReaderPrivate::MoveInternalMesh(
 {
   if (this->Parent->GetDecomposePolyhedra())
     {
-    const vtkIdType nAdditionalCells = static_cast<vtkIdType>(this->AdditionalCellPoints->size());
+    const vtkIdType nAdditionalPoints
+        = this->AdditionalCellPoints->GetNumberOfElements();
     this->ExtendArray<vtkFloatArray, float>(pointArray, this->NumPoints
-        + nAdditionalCells);
-    for (int i = 0; i < nAdditionalCells; i++)
-      {
-      vtkIdList *polyCellPoints = this->AdditionalCellPoints->operator[](i);
-      float centroid[3];
-      centroid[0] = centroid[1] = centroid[2] = 0.0F;
-      const vtkIdType nCellPoints = polyCellPoints->GetNumberOfIds();
-      for (vtkIdType j = 0; j < nCellPoints; j++)
-        {
-        float *pointK = pointArray->GetPointer(3 * polyCellPoints->GetId(j));
-        centroid[0] += pointK[0];
-        centroid[1] += pointK[1];
-        centroid[2] += pointK[2];
-        }
-      const float weight = (nCellPoints ? 1.0F
-          / static_cast<float>(nCellPoints) : 0.0F);
-      centroid[0] *= weight;
-      centroid[1] *= weight;
-      centroid[2] *= weight;
-      pointArray->InsertTuple(this->NumPoints + i, centroid);
-      }
+        + nAdditionalPoints);
+    vtkFoamAverageCellPoints<float> centroids;
+    centroids.Indices = this->AdditionalCellPoints->GetIndices()->GetPointer(0);
+    centroids.PointIds = this->AdditionalCellPoints->GetBody()->GetPointer(0);
+    centroids.Data = pointArray->GetPointer(0);
+    centroids.NComponents = 3;
+    centroids.NPoints = this->NumPoints;
+    vtkFoamParallelFor(nAdditionalPoints, VTK_FOAMFILE_MT_MINCELLS,
+        centroids);
     }
   if (internalMesh->GetPoints()->GetNumberOfPoints() != pointArray->GetNumberOfTuples())
     {
@@ -7497,32 +12245,187 @@ int vtkOFFReaderPrivate::MoveSurfaceMesh(vtkPolyData *surfaceMesh,
 void vtkOFFReaderPrivate::MoveBoundaryMesh(
     vtkMultiBlockDataSet *boundaryMesh, vtkFloatArray *pointArray)
 {
-  for (vtkIdType boundaryI = 0, activeBoundaryI = 0; boundaryI
-    < static_cast<vtkIdType>(this->BoundaryDict.size()); boundaryI++)
+  const int nActivePatches
+      = static_cast<int>(this->BoundaryPointMap->GetNumberOfElements());
+  vtkFoamBoundaryPointsTasks tasks;
+  tasks.Indices = this->BoundaryPointMap->GetIndices()->GetPointer(0);
+  tasks.PointIds = this->BoundaryPointMap->GetBody()->GetPointer(0);
+  tasks.PointArray = pointArray->GetPointer(0);
+  for (int patchI = 0; patchI < nActivePatches; patchI++)
     {
-    if (this->BoundaryDict[boundaryI].IsActive)
+    vtkFloatArray *boundaryPointArray = vtkFloatArray::New();
+    boundaryPointArray->SetNumberOfComponents(3);
+    tasks.Points.push_back(boundaryPointArray);
+    }
+  vtkFoamParallelTasks(nActivePatches, this->Parent->GetNumberOfThreads(),
+      tasks);
+  for (int patchI = 0; patchI < nActivePatches; patchI++)
+    {
+    vtkPoints *boundaryPoints = vtkPoints::New();
+    boundaryPoints->SetData(tasks.Points[patchI]);
+    tasks.Points[patchI]->Delete();
+    vtkPolyData::SafeDownCast(boundaryMesh->GetBlock(patchI))
+    ->SetPoints(boundaryPoints);
+    boundaryPoints->Delete();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// build the point-to-cell adjacency of the internal mesh in CSR form
+// from the cell connectivity. The cells a decomposed polyhedron has
+// been split into are all represented by the original cell so that
+// they do not weigh more than the other cells in the averaging.
+void vtkOFFReaderPrivate::BuildPointCells()
+{
+  const vtkIdType nPoints = this->NumPoints;
+  const vtkIdType nCells = this->NumCells;
+  const vtkIdType *locations
+      = this->InternalMesh->GetCellLocationsArray()->GetPointer(0);
+  const vtkIdType *connectivity
+      = this->InternalMesh->GetCells()->GetData()->GetPointer(0);
+
+  // the decomposed polyhedra are listed in ascending order of cells
+  const bool decomposed = this->AdditionalCellPoints != NULL;
+  const vtkIdType nPolyhedra = decomposed
+      ? this->AdditionalCellIds->GetNumberOfTuples() : 0;
+  const vtkIdType *polyCellIds = decomposed
+      ? this->AdditionalCellIds->GetPointer(0) : NULL;
+  const vtkIdType *polyIndices = decomposed
+      ? this->AdditionalCellPoints->GetIndices()->GetPointer(0) : NULL;
+  const vtkIdType *polyPoints = decomposed
+      ? this->AdditionalCellPoints->GetBody()->GetPointer(0) : NULL;
+
+  this->PointCells = new vtkFoamIntVectorVector(nPoints, 0);
+  vtkIdType *indices = this->PointCells->GetIndices()->GetPointer(0);
+  for (vtkIdType pointI = 0; pointI <= nPoints; pointI++)
+    {
+    indices[pointI] = 0;
+    }
+
+  // count the cells of each point, shifted by one for the prefix sum
+  vtkIdType polyI = 0;
+  for (vtkIdType cellI = 0; cellI < nCells; cellI++)
+    {
+    if (polyI < nPolyhedra && polyCellIds[polyI] == cellI)
       {
-      vtkIntArray *bpMap = this->BoundaryPointMap->operator[](activeBoundaryI);
-      const int nBoundaryPoints = bpMap->GetNumberOfTuples();
-      vtkFloatArray *boundaryPointArray = vtkFloatArray::New();
-      boundaryPointArray->SetNumberOfComponents(3);
-      boundaryPointArray->SetNumberOfTuples(nBoundaryPoints);
-      for (int pointI = 0; pointI < nBoundaryPoints; pointI++)
-        {
-        boundaryPointArray->SetTuple(pointI, bpMap->GetValue(pointI),
-            pointArray);
-        }
-      vtkPoints *boundaryPoints = vtkPoints::New();
-      boundaryPoints->SetData(boundaryPointArray);
-      boundaryPointArray->Delete();
-      vtkPolyData::SafeDownCast(boundaryMesh->GetBlock(activeBoundaryI))
-      ->SetPoints(boundaryPoints);
-      boundaryPoints->Delete();
-      activeBoundaryI++;
+      for (vtkIdType j = polyIndices[polyI]; j < polyIndices[polyI + 1]; j++)
+        {
+        indices[polyPoints[j] + 1]++;
+        }
+      polyI++;
+      }
+    else
+      {
+      const vtkIdType *cellPoints = connectivity + locations[cellI];
+      const vtkIdType nCellPoints = cellPoints[0];
+      for (vtkIdType j = 1; j <= nCellPoints; j++)
+        {
+        indices[cellPoints[j] + 1]++;
+        }
+      }
+    }
+  for (vtkIdType pointI = 0; pointI < nPoints; pointI++)
+    {
+    indices[pointI + 1] += indices[pointI];
+    }
+
+  // fill in ascending order of cells, using indices as the insertion
+  // positions and shifting them back afterwards
+  vtkIdTypeArray *bodyArray = this->PointCells->GetBody();
+  bodyArray->SetNumberOfValues(indices[nPoints]);
+  vtkIdType *body = bodyArray->GetPointer(0);
+  polyI = 0;
+  for (vtkIdType cellI = 0; cellI < nCells; cellI++)
+    {
+    if (polyI < nPolyhedra && polyCellIds[polyI] == cellI)
+      {
+      for (vtkIdType j = polyIndices[polyI]; j < polyIndices[polyI + 1]; j++)
+        {
+        body[indices[polyPoints[j]]++] = cellI;
+        }
+      polyI++;
       }
+    else
+      {
+      const vtkIdType *cellPoints = connectivity + locations[cellI];
+      const vtkIdType nCellPoints = cellPoints[0];
+      for (vtkIdType j = 1; j <= nCellPoints; j++)
+        {
+        body[indices[cellPoints[j]]++] = cellI;
+        }
+      }
+    }
+  for (vtkIdType pointI = nPoints; pointI > 0; pointI--)
+    {
+    indices[pointI] = indices[pointI - 1];
     }
+  indices[0] = 0;
 }
 
+//-----------------------------------------------------------------------------
+// averages the tuples of all the given fields to each point in a range
+// of the points of the internal mesh, from the cells sharing the point
+// for an internal point or from the AllBoundaries faces sharing the
+// point for a boundary point, so that the cell or face list of a point
+// is looked up once for all the fields
+struct vtkFoamCellToPointInterpolator
+{
+  struct field
+    {
+    float *PointData;
+    const float *CellData;
+    const float *BoundaryData;
+    int NComponents;
+    };
+  const vtkIdType *CellIndices;
+  const vtkIdType *CellIds;
+  const vtkIdType *FaceIndices;
+  const vtkIdType *FaceIds;
+  const field *Fields;
+  int NFields;
+
+  void operator()(const vtkIdType begin, const vtkIdType end) const
+  {
+    double summedValue[9]; // up to tensors
+    for (vtkIdType pointI = begin; pointI < end; pointI++)
+      {
+      const bool isBoundaryPoint
+          = this->FaceIndices[pointI + 1] > this->FaceIndices[pointI];
+      const vtkIdType *ids = isBoundaryPoint
+          ? this->FaceIds + this->FaceIndices[pointI]
+          : this->CellIds + this->CellIndices[pointI];
+      const vtkIdType nIds = isBoundaryPoint
+          ? this->FaceIndices[pointI + 1] - this->FaceIndices[pointI]
+          : this->CellIndices[pointI + 1] - this->CellIndices[pointI];
+      // use double intermediate variables for precision
+      const double weight = (nIds ? 1.0 / static_cast<double>(nIds) : 0.0);
+      for (int fieldI = 0; fieldI < this->NFields; fieldI++)
+        {
+        const field &f = this->Fields[fieldI];
+        const int nComponents = f.NComponents;
+        const float *tuples = isBoundaryPoint ? f.BoundaryData : f.CellData;
+        for (int k = 0; k < nComponents; k++)
+          {
+          summedValue[k] = 0.0;
+          }
+        for (vtkIdType idI = 0; idI < nIds; idI++)
+          {
+          const float *tuple = tuples + nComponents * ids[idI];
+          for (int k = 0; k < nComponents; k++)
+            {
+            summedValue[k] += tuple[k];
+            }
+          }
+        float *interpolatedValue = f.PointData + nComponents * pointI;
+        for (int k = 0; k < nComponents; k++)
+          {
+          interpolatedValue[k] = static_cast<float>(weight * summedValue[k]);
+          }
+        }
+      }
+  }
+};
+
 //-----------------------------------------------------------------------------
 // as of now the function does not do interpolation, but do just averaging.
 void vtkOFFReaderPrivate::InterpolateCellToPoint(vtkFloatArray *pData,
@@ -7660,7 +12563,7 @@ void vtkOFFReaderPrivate::InterpolateCellToPoint(vtkFloatArray *pData,
 //-----------------------------------------------------------------------------
 bool vtkOFFReaderPrivate::ReadFieldFile(vtkFoamIOobject *ioPtr,
     vtkFoamDict *dictPtr, const vtkStdString &varName,
-    vtkDataArraySelection *selection)
+    vtkDataArraySelection *selection, const vtkFoamEntryFilter *filter)
 {
   const vtkStdString varPath(this->CurrentTimeRegionPath() + "/" + varName);
 
@@ -7668,7 +12571,7 @@ bool vtkOFFReaderPrivate::ReadFieldFile(vtkFoamIOobject *ioPtr,
   vtkFoamIOobject &io = *ioPtr;
   if (!io.Open(varPath))
     {
-    vtkErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
+    vtkFoamErrorMacro(<<"Error opening " << io.GetFileName().c_str() << ": "
         << io.GetError().c_str());
     return false;
     }
@@ -7681,25 +12584,33 @@ bool vtkOFFReaderPrivate::ReadFieldFile(vtkFoamIOobject *ioPtr,
 
   // read the field file into dictionary
   vtkFoamDict &dict = *dictPtr;
-  if (!dict.Read(io))
+  if (!vtkFoamReadDict(io, dict, filter))
     {
-    vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
+    vtkFoamErrorMacro(<<"Error reading line " << io.GetLineNumber()
         << " of " << io.GetFileName().c_str() << ": " << io.GetError().c_str());
     return false;
     }
 
   if (dict.GetType() != vtkFoamToken::DICTIONARY)
     {
-    vtkErrorMacro(<<"File " << io.GetFileName().c_str()
+    vtkFoamErrorMacro(<<"File " << io.GetFileName().c_str()
         << "is not valid as a field file");
     return false;
     }
+
+  if (io.GetBinaryListBytes() > 0.0 && io.GetBinaryListTime() > 0.0)
+    {
+    vtkFoamDebugWithObjectMacro(this->Parent, << "Read "
+        << io.GetBinaryListBytes() << " bytes of binary lists from "
+        << io.GetFileName().c_str() << " at "
+        << io.GetBinaryListBytes() / io.GetBinaryListTime() << " bytes/s");
+    }
   return true;
 }
 
 //-----------------------------------------------------------------------------
 vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
-    vtkFoamEntry *refEntryPtr, int nElements, vtkFoamIOobject *ioPtr,
+    vtkFoamEntry *refEntryPtr, vtkIdType nElements, vtkFoamIOobject *ioPtr,
     const vtkStdString &fieldType, const bool isUniformFixedValueBC)
     // the isUniformFixedValueBC argument can be determined in compile-time
     // thus better use a template, which unfortunately is not possible due to
@@ -7744,7 +12655,7 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
       }
     else
       {
-      vtkErrorMacro(<< "Wrong referenceLevel type");
+      vtkFoamErrorMacro(<< "Wrong referenceLevel type");
       return NULL;
       }
     }
@@ -7762,13 +12673,13 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
           }
         else
           {
-          vtkErrorMacro(<<"Wrong referenceLevel type for uniform scalar field");
+          vtkFoamErrorMacro(<<"Wrong referenceLevel type for uniform scalar field");
           return NULL;
           }
         }
       data = vtkFloatArray::New();
       data->SetNumberOfValues(nElements);
-      for (int i = 0; i < nElements; i++)
+      for (vtkIdType i = 0; i < nElements; i++)
         {
         data->SetValue(i, num);
         }
@@ -7798,7 +12709,7 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
         }
       else
         {
-        vtkErrorMacro(<< "Wrong list type for uniform field");
+        vtkFoamErrorMacro(<< "Wrong list type for uniform field");
         return NULL;
         }
 
@@ -7813,7 +12724,7 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
           }
         else
           {
-          vtkErrorMacro(<< "Wrong referenceLevel type");
+          vtkFoamErrorMacro(<< "Wrong referenceLevel type");
           return NULL;
           }
         }
@@ -7826,14 +12737,14 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
         data = vtkFloatArray::New();
         data->SetNumberOfComponents(nComponents);
         data->SetNumberOfTuples(nElements);
-        for (int i = 0; i < nElements; i++)
+        for (vtkIdType i = 0; i < nElements; i++)
           {
           data->SetTuple(i, tuple);
           }
         }
       else
         {
-        vtkErrorMacro(<< "Number of components and field class doesn't match "
+        vtkFoamErrorMacro(<< "Number of components and field class doesn't match "
                       << "for " << ioPtr->GetFileName().c_str() << ". class = " << className.c_str()
                       << ", nComponents = " << nComponents);
         return NULL;
@@ -7849,7 +12760,7 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
       const int valueI = entry.FirstValue().GetType() != vtkFoamToken::WORD ? 0 : 1;
       if(entry.size() <= valueI)
         {
-        vtkErrorMacro(<< "Constant uniform value is missing in entry "
+        vtkFoamErrorMacro(<< "Constant uniform value is missing in entry "
         << entry.GetKeyword().c_str() << " in " << ioPtr->GetFileName().c_str() << ".");
         return NULL;
         }
@@ -7859,7 +12770,7 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
         float num = entry[valueI]->ToFloat();
         data = vtkFloatArray::New();
         data->SetNumberOfValues(nElements);
-        for (int i = 0; i < nElements; i++)
+        for (vtkIdType i = 0; i < nElements; i++)
           {
           data->SetValue(i, num);
           }
@@ -7889,7 +12800,7 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
           }
         else
           {
-          vtkErrorMacro(<< "Wrong list type for uniform field");
+          vtkFoamErrorMacro(<< "Wrong list type for uniform field");
           return NULL;
           }
 
@@ -7901,14 +12812,14 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
           data = vtkFloatArray::New();
           data->SetNumberOfComponents(nComponents);
           data->SetNumberOfTuples(nElements);
-          for (int i = 0; i < nElements; i++)
+          for (vtkIdType i = 0; i < nElements; i++)
             {
             data->SetTuple(i, tuple);
             }
           }
         else
           {
-          vtkErrorMacro(<< "Number of components and field class doesn't match "
+          vtkFoamErrorMacro(<< "Number of components and field class doesn't match "
                         << "for " << ioPtr->GetFileName().c_str() << ". class = " << className.c_str()
                         << ", nComponents = " << nComponents);
           return NULL;
@@ -7917,7 +12828,7 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
       }
     else
       {
-      vtkErrorMacro(<< "Unrecognized uniformFixedValue type " << entry.ToWord()
+      vtkFoamErrorMacro(<< "Unrecognized uniformFixedValue type " << entry.ToWord()
                     << " in entry " << entry.GetKeyword().c_str()
                     << " in " << ioPtr->GetFileName().c_str() << ".");
       return NULL;
@@ -7930,10 +12841,10 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
         == "SymmTensorField" || fieldType == "TensorField")
         && entry.FirstValue().GetType() == vtkFoamToken::VECTORLIST))
       {
-      const int nTuples = entry.ScalarList().GetNumberOfTuples();
+      const vtkIdType nTuples = entry.ScalarList().GetNumberOfTuples();
       if (nTuples != nElements)
         {
-        vtkErrorMacro(<<"Number of cells/faces/points in mesh and field don't "
+        vtkFoamErrorMacro(<<"Number of cells/faces/points in mesh and field don't "
             << "match: mesh = " << nElements << ", field = " << nTuples);
         return NULL;
         }
@@ -7948,7 +12859,7 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
             && entry.FirstValue().GetType() == vtkFoamToken::VECTORLIST
             && nRefComponents == nComponents))
           {
-          for (int tupleI = 0; tupleI < nTuples; tupleI++)
+          for (vtkIdType tupleI = 0; tupleI < nTuples; tupleI++)
             {
             float *tuple = data->GetPointer(nComponents * tupleI);
             for (int componentI = 0; componentI < nComponents; componentI++)
@@ -7959,7 +12870,7 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
           }
         else
           {
-          vtkErrorMacro(<< "Wrong referenceLevel type");
+          vtkFoamErrorMacro(<< "Wrong referenceLevel type");
           return NULL;
           }
         }
@@ -7987,14 +12898,14 @@ vtkFloatArray *vtkOFFReaderPrivate::FillField(vtkFoamEntry *entryPtr,
       }
     else
       {
-      vtkErrorMacro(<< ioPtr->GetFileName().c_str() << " is not a valid "
+      vtkFoamErrorMacro(<< ioPtr->GetFileName().c_str() << " is not a valid "
           << ioPtr->GetClassName().c_str());
       return NULL;
       }
     }
   else // undefined
     {
-    vtkErrorMacro(<< "Either uniform or nonuniform keyword is missing in entry "
+    vtkFoamErrorMacro(<< "Either uniform or nonuniform keyword is missing in entry "
         << entry.GetKeyword().c_str() << " in " << ioPtr->GetFileName().c_str());
     return NULL;
     }
@@ -8083,37 +12994,227 @@ void vtkOFFReaderPrivate::ConstructDimensions(vtkStdString *dimString,
         }
       *dimString += "]";
       }
-    }
-}
+    }
+}
+
+//-----------------------------------------------------------------------------
+// class vtkFoamFieldArrays
+// the arrays made from a field file along with the attributes they
+// belong to, held until they are added to the meshes so that fields
+// can be read concurrently
+struct vtkFoamFieldArrays
+{
+private:
+  struct fieldArray
+    {
+    vtkDataSetAttributes *FieldData;
+    vtkDataArray *Array;
+    vtkStdString Name;
+    };
+  // cell-to-point interpolations of the internal mesh deferred to
+  // vtkOFFReaderPrivate::InterpolateInternalCellToPoint()
+  struct cellToPoint
+    {
+    vtkFloatArray *PointData;
+    vtkFloatArray *CellData;
+    vtkFloatArray *BoundaryData;
+    };
+  vtkstd::vector<fieldArray> Arrays;
+  vtkstd::vector<cellToPoint> CellToPoints;
+
+public:
+  ~vtkFoamFieldArrays()
+  {
+    for (size_t arrayI = 0; arrayI < this->Arrays.size(); arrayI++)
+      {
+      this->Arrays[arrayI].Array->UnRegister(0);
+      }
+    for (size_t ctpI = 0; ctpI < this->CellToPoints.size(); ctpI++)
+      {
+      this->CellToPoints[ctpI].PointData->UnRegister(0);
+      this->CellToPoints[ctpI].CellData->UnRegister(0);
+      this->CellToPoints[ctpI].BoundaryData->UnRegister(0);
+      }
+  }
+  void Add(vtkDataSetAttributes *fieldData, vtkDataArray *array,
+      const vtkStdString &arrayName)
+  {
+    fieldArray fa;
+    fa.FieldData = fieldData;
+    fa.Array = array;
+    fa.Name = arrayName;
+    array->Register(0);
+    this->Arrays.push_back(fa);
+  }
+  size_t GetNumberOfArrays() const
+  {
+    return this->Arrays.size();
+  }
+  vtkDataSetAttributes *GetFieldData(const size_t arrayI) const
+  {
+    return this->Arrays[arrayI].FieldData;
+  }
+  vtkDataArray *GetArray(const size_t arrayI) const
+  {
+    return this->Arrays[arrayI].Array;
+  }
+  const vtkStdString &GetName(const size_t arrayI) const
+  {
+    return this->Arrays[arrayI].Name;
+  }
+  void AddCellToPoint(vtkFloatArray *pointData, vtkFloatArray *cellData,
+      vtkFloatArray *boundaryData)
+  {
+    cellToPoint ctp;
+    ctp.PointData = pointData;
+    ctp.CellData = cellData;
+    ctp.BoundaryData = boundaryData;
+    pointData->Register(0);
+    cellData->Register(0);
+    boundaryData->Register(0);
+    this->CellToPoints.push_back(ctp);
+  }
+  size_t GetNumberOfCellToPoints() const
+  {
+    return this->CellToPoints.size();
+  }
+  vtkFloatArray *GetCellToPointPointData(const size_t ctpI) const
+  {
+    return this->CellToPoints[ctpI].PointData;
+  }
+  vtkFloatArray *GetCellToPointCellData(const size_t ctpI) const
+  {
+    return this->CellToPoints[ctpI].CellData;
+  }
+  vtkFloatArray *GetCellToPointBoundaryData(const size_t ctpI) const
+  {
+    return this->CellToPoints[ctpI].BoundaryData;
+  }
+};
+
+//-----------------------------------------------------------------------------
+// class vtkFoamBoundaryFieldFilter
+// rejects the whole boundaryField, the subdictionaries of patches whose
+// values are not used, or the value entries of patches whose values
+// are replaced by patch-internal values
+struct vtkFoamBoundaryFieldFilter : public vtkFoamEntryFilter
+{
+private:
+  enum skipTypes
+    {SKIP_PATCH, SKIP_VALUES};
+  typedef vtksys::hash_map<vtkstd::string, int> patchMap;
+  patchMap Patches;
+  bool SkipBoundaryField;
+
+public:
+  vtkFoamBoundaryFieldFilter() :
+    Patches(), SkipBoundaryField(false)
+  {
+  }
+
+  void SetSkipBoundaryField(const bool skip)
+  {
+    this->SkipBoundaryField = skip;
+  }
+  void SkipPatch(const vtkStdString &patchName)
+  {
+    this->Patches[patchName] = SKIP_PATCH;
+  }
+  void SkipValues(const vtkStdString &patchName)
+  {
+    this->Patches[patchName] = SKIP_VALUES;
+  }
+  bool IsPatchSkipped(const vtkStdString &patchName) const
+  {
+    patchMap::const_iterator it = this->Patches.find(patchName);
+    return it != this->Patches.end() && it->second == SKIP_PATCH;
+  }
+
+  bool IsWanted(const vtkstd::vector<vtkStdString> &keywordPath) const
+  {
+    if (keywordPath[0] != "boundaryField")
+      {
+      return true;
+      }
+    if (keywordPath.size() == 1)
+      {
+      return !this->SkipBoundaryField;
+      }
+    // regex keywords never match patch names literally thus are kept
+    patchMap::const_iterator it = this->Patches.find(keywordPath[1]);
+    if (it == this->Patches.end())
+      {
+      return true;
+      }
+    if (it->second == SKIP_PATCH)
+      {
+      return false;
+      }
+    return keywordPath.size() != 3
+        || (keywordPath[2] != "value" && keywordPath[2] != "uniformValue");
+  }
+};
 
 //-----------------------------------------------------------------------------
 void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
     vtkUnstructuredGrid *internalMesh, vtkMultiBlockDataSet *boundaryMesh,
-    const vtkStdString &varName)
+    const vtkStdString &varName, vtkFoamFieldArrays *arrays)
 {
+  // skip parsing the parts of boundaryField not used. The patch
+  // values are used if the patch is output or if they contribute to
+  // cell-to-point interpolation on the boundaries.
+  const bool createCellToPoint = (this->Parent->GetCreateCellToPoint() != 0);
+  vtkFoamBoundaryFieldFilter filter;
+  filter.SetSkipBoundaryField(boundaryMesh == NULL);
+  for (size_t boundaryI = 0; boundaryI < this->BoundaryDict.size();
+      boundaryI++)
+    {
+    const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
+    if (!beI.IsActive && (!createCellToPoint
+        || beI.BoundaryType == vtkFoamBoundaryEntry::GEOMETRICAL))
+      {
+      filter.SkipPatch(beI.BoundaryName);
+      }
+    else if (beI.BoundaryType == vtkFoamBoundaryEntry::GEOMETRICAL
+        || this->Parent->ForceZeroGradient != 0)
+      {
+      filter.SkipValues(beI.BoundaryName);
+      }
+    }
+
   vtkFoamIOobject io(this->CasePath,
       this->Parent->GetIsSinglePrecisionBinary() != 0);
+  if (this->BoundaryOwnerCells != NULL)
+    {
+    // only the cells next to the active patches are in use
+    io.SetGather("internalField", this->BoundaryOwnerCells);
+    }
   vtkFoamDict dict;
   if (!this->ReadFieldFile(&io, &dict, varName,
-      this->Parent->CellDataArraySelection))
+      this->Parent->CellDataArraySelection, &filter))
     {
     return;
     }
 
   if (io.GetClassName().substr(0, 3) != "vol")
     {
-    vtkErrorMacro(<< io.GetFileName().c_str() << " is not a volField");
+    vtkFoamErrorMacro(<< io.GetFileName().c_str() << " is not a volField");
     return;
     }
 
   const bool dimensionedInternalField
       = (io.GetClassName().find("::DimensionedInternalField")
       != vtkStdString::npos);
+  if (dimensionedInternalField && this->BoundaryOwnerCells != NULL)
+    {
+    // has no patch values and the internal mesh is not output
+    return;
+    }
   vtkFoamEntry *iEntry
       = dict.Lookup(dimensionedInternalField ? "value" : "internalField");
   if (!iEntry)
     {
-    vtkErrorMacro(<<"internalField not found in " << io.GetFileName().c_str());
+    vtkFoamErrorMacro(<<"internalField not found in " << io.GetFileName().c_str());
     return;
     }
 
@@ -8122,7 +13223,7 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
     // if there's no cell there shouldn't be any boundary faces either
     if (this->NumCells > 0)
       {
-      vtkErrorMacro(<<"internalField of " << io.GetFileName().c_str()
+      vtkFoamErrorMacro(<<"internalField of " << io.GetFileName().c_str()
           << " is empty");
       }
     return;
@@ -8157,9 +13258,9 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
         // add values for decomposed cells
         this->ExtendArray<vtkFloatArray, float>(iData, this->NumCells
             + this->NumTotalAdditionalCells);
-        const int nTuples = this->AdditionalCellIds->GetNumberOfTuples();
-        int additionalCellI = this->NumCells;
-        for (int tupleI = 0; tupleI < nTuples; tupleI++)
+        const vtkIdType nTuples = this->AdditionalCellIds->GetNumberOfTuples();
+        vtkIdType additionalCellI = this->NumCells;
+        for (vtkIdType tupleI = 0; tupleI < nTuples; tupleI++)
           {
           const int nCells = this->NumAdditionalCells->GetValue(tupleI);
           const vtkIdType cellId = this->AdditionalCellIds->GetValue(tupleI);
@@ -8171,7 +13272,7 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
         }
 
       // set data to internal mesh
-      this->AddArrayToFieldData(internalMesh->GetCellData(), iData,
+      arrays->Add(internalMesh->GetCellData(), iData,
           io.GetObjectName() + dimString);
 
       if (this->Parent->GetCreateCellToPoint())
@@ -8180,17 +13281,13 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
         ctpData = vtkFloatArray::New();
         ctpData->SetNumberOfComponents(iData->GetNumberOfComponents());
         ctpData->SetNumberOfTuples(internalMesh->GetPoints()->GetNumberOfPoints());
-        if (this->InternalPoints != NULL)
-          {
-          this->InterpolateCellToPoint(ctpData, iData, internalMesh,
-              this->InternalPoints, this->InternalPoints->GetNumberOfTuples());
-          }
 
         if (this->Parent->GetDecomposePolyhedra())
           {
           // assign cell values to additional points
-          const int nPoints = this->AdditionalCellIds->GetNumberOfTuples();
-          for (int pointI = 0; pointI < nPoints; pointI++)
+          const vtkIdType nPoints =
+              this->AdditionalCellIds->GetNumberOfTuples();
+          for (vtkIdType pointI = 0; pointI < nPoints; pointI++)
             {
             ctpData->SetTuple(this->NumPoints + pointI,
                 this->AdditionalCellIds->GetValue(pointI), iData);
@@ -8218,28 +13315,25 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
 
   vtkFloatArray *acData = NULL;
 
-  if (this->Parent->GetCreateCellToPoint())
+  if (ctpData != NULL)
     {
-    if (this->AllBoundaries == NULL)
+    if (this->AllBoundariesPointFaces == NULL)
       {
-      vtkErrorMacro(<<"boundary mesh for cell to point filtering not found");
+      vtkFoamErrorMacro(<<"boundary mesh for cell to point filtering not found");
       iData->Delete();
-      if (ctpData != NULL)
-        {
-        ctpData->Delete();
-        }
+      ctpData->Delete();
       return;
       }
     acData = vtkFloatArray::New();
     acData->SetNumberOfComponents(iData->GetNumberOfComponents());
-    acData->SetNumberOfTuples(this->AllBoundaries->GetNumberOfCells());
+    acData->SetNumberOfTuples(this->NumAllBoundariesFaces);
     }
 
   // set boundary values
   const vtkFoamEntry *bEntry = dict.Lookup("boundaryField");
   if (bEntry == NULL)
     {
-    vtkErrorMacro(<< "boundaryField not found in object " << varName.c_str()
+    vtkFoamErrorMacro(<< "boundaryField not found in object " << varName.c_str()
         << " at time = " << this->TimeNames->GetValue(this->TimeStep).c_str());
     iData->Delete();
     if (acData != NULL)
@@ -8259,10 +13353,16 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
     const vtkFoamBoundaryEntry &beI = this->BoundaryDict[boundaryI];
     const vtkStdString &boundaryNameI = beI.BoundaryName;
 
+    // values of the patch are not used
+    if (filter.IsPatchSkipped(boundaryNameI))
+      {
+      continue;
+      }
+
     const vtkFoamEntry *bEntryI = bEntry->Dictionary().Lookup(boundaryNameI);
     if (bEntryI == NULL)
       {
-      vtkErrorMacro(<< "boundaryField " << boundaryNameI.c_str()
+      vtkFoamErrorMacro(<< "boundaryField " << boundaryNameI.c_str()
           << " not found in object " << varName.c_str() << " at time = "
           << this->TimeNames->GetValue(this->TimeStep).c_str());
       iData->Delete();
@@ -8279,7 +13379,7 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
 
     if (bEntryI->FirstValue().GetType() != vtkFoamToken::DICTIONARY)
       {
-      vtkErrorMacro(<< "Type of boundaryField " << boundaryNameI.c_str()
+      vtkFoamErrorMacro(<< "Type of boundaryField " << boundaryNameI.c_str()
           << " is not a subdictionary in object " << varName.c_str()
           << " at time = " << this->TimeNames->GetValue(this->TimeStep).c_str());
       iData->Delete();
@@ -8294,7 +13394,7 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
       return;
       }
 
-    const int nFaces = beI.NFaces;
+    const vtkIdType nFaces = beI.NFaces;
 
     vtkFloatArray* vData = NULL;
     if (beI.BoundaryType != vtkFoamBoundaryEntry::GEOMETRICAL
@@ -8349,7 +13449,7 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
           }
         }
       }
-    const int boundaryStartFace = beI.StartFace
+    const vtkIdType boundaryStartFace = beI.StartFace
         - this->BoundaryDict[0].StartFace;
 
     if (vData == NULL) // doesn't have a value nor uniformValue entry
@@ -8358,16 +13458,17 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
       vData = vtkFloatArray::New();
       vData->SetNumberOfComponents(iData->GetNumberOfComponents());
       vData->SetNumberOfTuples(nFaces);
-      for (int j = 0; j < nFaces; j++)
+      for (vtkIdType j = 0; j < nFaces; j++)
         {
-        const int cellId = this->FaceOwner->GetValue(boundaryStartFace + j);
+        const vtkIdType cellId =
+            this->FaceOwner->GetValue(boundaryStartFace + j);
         vData->SetTuple(j, cellId, iData);
         }
       }
 
-    if (this->Parent->GetCreateCellToPoint())
+    if (acData != NULL)
       {
-      const int startFace = beI.AllBoundariesStartFace;
+      const vtkIdType startFace = beI.AllBoundariesStartFace;
       // if reading a processor sub-case of a decomposed case as is,
       // use the patch values of the processor patch as is
       if (beI.BoundaryType == vtkFoamBoundaryEntry::PHYSICAL
@@ -8375,7 +13476,7 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
               == vtkFoamBoundaryEntry::PROCESSOR))
         {
         // set the same value to AllBoundaries
-        for (int faceI = 0; faceI < nFaces; faceI++)
+        for (vtkIdType faceI = 0; faceI < nFaces; faceI++)
           {
           acData->SetTuple(faceI + startFace, faceI, vData);
           }
@@ -8388,7 +13489,7 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
         // decomposed mesh. Using double precision to avoid degrade in
         // accuracy.
         const int nComponents = vData->GetNumberOfComponents();
-        for (int faceI = 0; faceI < nFaces; faceI++)
+        for (vtkIdType faceI = 0; faceI < nFaces; faceI++)
           {
           const float *vTuple = vData->GetPointer(nComponents * faceI);
           const float *iTuple = iData->GetPointer(nComponents
@@ -8408,7 +13509,7 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
       {
       vtkPolyData *bm =
           vtkPolyData::SafeDownCast(boundaryMesh->GetBlock(activeBoundaryI));
-      this->AddArrayToFieldData(bm->GetCellData(), vData, io.GetObjectName()
+      arrays->Add(bm->GetCellData(), vData, io.GetObjectName()
           + dimString);
 
       if (this->Parent->GetCreateCellToPoint())
@@ -8423,7 +13524,7 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
         const int nPoints = bm->GetPoints()->GetNumberOfPoints();
         pData->SetNumberOfTuples(nPoints);
         this->InterpolateCellToPoint(pData, vData, bm, NULL, nPoints);
-        this->AddArrayToFieldData(bm->GetPointData(), pData, io.GetObjectName()
+        arrays->Add(bm->GetPointData(), pData, io.GetObjectName()
             + dimString);
         pData->Delete();
         }
@@ -8432,42 +13533,27 @@ void vtkOFFReaderPrivate::GetVolFieldAtTimeStep(
       }
     vData->Delete();
     }
-  iData->Delete();
 
-  if (this->Parent->GetCreateCellToPoint())
+  if (ctpData != NULL)
     {
-    // Create cell-to-point interpolated data for all boundaries and
-    // override internal values
-    vtkFloatArray *bpData = vtkFloatArray::New();
-    bpData->SetNumberOfComponents(acData->GetNumberOfComponents());
-    const int nPoints = this->AllBoundariesPointMap->GetNumberOfTuples();
-    bpData->SetNumberOfTuples(nPoints);
-    this->InterpolateCellToPoint(bpData, acData, this->AllBoundaries, NULL,
-        nPoints);
+    // the cell-to-point data for internal mesh is interpolated from the
+    // cell values at the internal points and from the AllBoundaries
+    // face values at the boundary points, together with the other
+    // fields after all fields have been read
+    arrays->AddCellToPoint(ctpData, iData, acData);
+    arrays->Add(internalMesh->GetPointData(), ctpData,
+        io.GetObjectName() + dimString);
+    ctpData->Delete();
     acData->Delete();
-
-    if (ctpData != NULL)
-      {
-      // set cell-to-pint data for internal mesh
-      for (int pointI = 0; pointI < nPoints; pointI++)
-        {
-        ctpData->SetTuple(this->AllBoundariesPointMap->GetValue(pointI),
-            pointI, bpData);
-        }
-      this->AddArrayToFieldData(internalMesh->GetPointData(), ctpData,
-          io.GetObjectName() + dimString);
-      ctpData->Delete();
-      }
-
-    bpData->Delete();
     }
+  iData->Delete();
 }
 
 //-----------------------------------------------------------------------------
 // read surface field at a timestep
 void vtkOFFReaderPrivate::GetSurfaceFieldAtTimeStep(
     vtkPolyData *surfaceMesh, vtkMultiBlockDataSet *boundaryMesh,
-    const vtkStdString &varName)
+    const vtkStdString &varName, vtkFoamFieldArrays *arrays)
 {
   vtkFoamIOobject io(this->CasePath,
       this->Parent->GetIsSinglePrecisionBinary() != 0);
@@ -8480,14 +13566,14 @@ void vtkOFFReaderPrivate::GetSurfaceFieldAtTimeStep(
 
   if (io.GetClassName().substr(0, 7) != "surface")
     {
-    vtkErrorMacro(<< io.GetFileName().c_str() << " is not a surfaceField");
+    vtkFoamErrorMacro(<< io.GetFileName().c_str() << " is not a surfaceField");
     return;
     }
 
   vtkFoamEntry *iEntry = dict.Lookup("internalField");
   if (iEntry == NULL)
     {
-    vtkErrorMacro (<< "internalField not found in "
+    vtkFoamErrorMacro(<< "internalField not found in "
         << io.GetFileName().c_str());
     return;
     }
@@ -8501,7 +13587,7 @@ void vtkOFFReaderPrivate::GetSurfaceFieldAtTimeStep(
     // Check if internal faces have been defined
     if (this->NumInternalFaces <= 0)
       {
-      vtkErrorMacro(<< "Internal faces is either invalid or not defined."
+      vtkFoamErrorMacro(<< "Internal faces is either invalid or not defined."
           << " Internal Faces: " << this->NumInternalFaces);
       return;
       }
@@ -8530,7 +13616,7 @@ void vtkOFFReaderPrivate::GetSurfaceFieldAtTimeStep(
     const vtkFoamEntry *bEntry = dict.Lookup("boundaryField");
     if (bEntry == NULL)
       {
-      vtkErrorMacro( << "boundaryField not found in object " << varName.c_str()
+      vtkFoamErrorMacro( << "boundaryField not found in object " << varName.c_str()
           << " at time = "
           << this->TimeNames->GetValue(this->TimeStep).c_str());
       if (iData != NULL)
@@ -8558,7 +13644,7 @@ void vtkOFFReaderPrivate::GetSurfaceFieldAtTimeStep(
 
       if (bEntryI == NULL)
         {
-        vtkErrorMacro(<< "boundaryField " << boundaryNameI.c_str()
+        vtkFoamErrorMacro(<< "boundaryField " << boundaryNameI.c_str()
             << " not found in object " << varName.c_str() << " at time = "
             << this->TimeNames->GetValue(this->TimeStep).c_str());
 
@@ -8571,7 +13657,7 @@ void vtkOFFReaderPrivate::GetSurfaceFieldAtTimeStep(
 
       if (bEntryI->FirstValue().GetType() != vtkFoamToken::DICTIONARY)
         {
-        vtkErrorMacro( << "Type of boundaryField " << boundaryNameI.c_str()
+        vtkFoamErrorMacro( << "Type of boundaryField " << boundaryNameI.c_str()
             << " is not a subdictionary in object " << varName.c_str()
             << " at time = "
             << this->TimeNames->GetValue(this->TimeStep).c_str());
@@ -8583,7 +13669,7 @@ void vtkOFFReaderPrivate::GetSurfaceFieldAtTimeStep(
         return;
         }
 
-      const int nFaces = beI.NFaces;
+      const vtkIdType nFaces = beI.NFaces;
       vtkFloatArray* vData = NULL;
 
       if (beI.BoundaryType != vtkFoamBoundaryEntry::GEOMETRICAL
@@ -8659,7 +13745,7 @@ void vtkOFFReaderPrivate::GetSurfaceFieldAtTimeStep(
           }
         else
           {
-          vtkErrorMacro(<< io.GetFileName().c_str() << " is not a valid field");
+          vtkFoamErrorMacro(<< io.GetFileName().c_str() << " is not a valid field");
           if (iData != NULL)
             {
             iData->Delete();
@@ -8678,18 +13764,20 @@ void vtkOFFReaderPrivate::GetSurfaceFieldAtTimeStep(
         {
         vtkPolyData *bm = vtkPolyData::SafeDownCast(
             boundaryMesh->GetBlock(activeBoundaryI));
-        this->AddArrayToFieldData(bm->GetCellData(), vData,
+        arrays->Add(bm->GetCellData(), vData,
             io.GetObjectName() + dimString);
         activeBoundaryI++;
         }
 
       if (doProcFaces)
         {
-        const int startFace = this->NumInternalFaces
+        const vtkIdType startFace = this->NumInternalFaces
             + this->ProcessorFaces->GetIndices()->GetValue(procBoundaryI);
-        const int nProcFaces = this->ProcessorFaces->GetSize(procBoundaryI);
-        const int *faceIDs = this->ProcessorFaces->operator[](procBoundaryI);
-        for (int faceI = 0; faceI < nProcFaces; faceI++)
+        const vtkIdType nProcFaces
+            = this->ProcessorFaces->GetSize(procBoundaryI);
+        const vtkIdType *faceIDs
+            = this->ProcessorFaces->operator[](procBoundaryI);
+        for (vtkIdType faceI = 0; faceI < nProcFaces; faceI++)
           {
           iData->SetTuple(startFace + faceI, faceIDs[faceI], vData);
           }
@@ -8705,7 +13793,7 @@ void vtkOFFReaderPrivate::GetSurfaceFieldAtTimeStep(
     if (iData->GetSize() > 0)
       {
       // set data to internal mesh
-      this->AddArrayToFieldData(surfaceMesh->GetCellData(), iData,
+      arrays->Add(surfaceMesh->GetCellData(), iData,
           io.GetObjectName() + dimString);
       }
     iData->Delete();
@@ -8716,7 +13804,7 @@ void vtkOFFReaderPrivate::GetSurfaceFieldAtTimeStep(
 // read point field at a timestep
 void vtkOFFReaderPrivate::GetPointFieldAtTimeStep(
     vtkUnstructuredGrid *internalMesh, vtkMultiBlockDataSet *boundaryMesh,
-    const vtkStdString &varName)
+    const vtkStdString &varName, vtkFoamFieldArrays *arrays)
 {
   vtkFoamIOobject io(this->CasePath,
       this->Parent->GetIsSinglePrecisionBinary() != 0);
@@ -8729,14 +13817,14 @@ void vtkOFFReaderPrivate::GetPointFieldAtTimeStep(
 
   if (io.GetClassName().substr(0, 5) != "point")
     {
-    vtkErrorMacro(<< io.GetFileName().c_str() << " is not a pointField");
+    vtkFoamErrorMacro(<< io.GetFileName().c_str() << " is not a pointField");
     return;
     }
 
   vtkFoamEntry *iEntry = dict.Lookup("internalField");
   if (iEntry == NULL)
     {
-    vtkErrorMacro(<<"internalField not found in " << io.GetFileName().c_str());
+    vtkFoamErrorMacro(<<"internalField not found in " << io.GetFileName().c_str());
     return;
     }
 
@@ -8745,7 +13833,7 @@ void vtkOFFReaderPrivate::GetPointFieldAtTimeStep(
     // if there's no cell there shouldn't be any boundary faces either
     if (this->NumPoints > 0)
       {
-      vtkErrorMacro(<<"internalField of " << io.GetFileName().c_str()
+      vtkFoamErrorMacro(<<"internalField of " << io.GetFileName().c_str()
           << " is empty");
       }
     return;
@@ -8768,35 +13856,19 @@ void vtkOFFReaderPrivate::GetPointFieldAtTimeStep(
     {
     // point-to-cell interpolation to additional cell centroidal points
     // for decomposed cells
-    const int nAdditionalPoints = static_cast<int>(this->AdditionalCellPoints->size());
-    const int nComponents = iData->GetNumberOfComponents();
+    const vtkIdType nAdditionalPoints
+        = this->AdditionalCellPoints->GetNumberOfElements();
     this->ExtendArray<vtkFloatArray, float>(iData, this->NumPoints
         + nAdditionalPoints);
-    for (int i = 0; i < nAdditionalPoints; i++)
-      {
-      vtkIdList *acp = this->AdditionalCellPoints->operator[](i);
-      const vtkIdType nPoints = acp->GetNumberOfIds();
-      double interpolatedValue[9];
-      for (int k = 0; k < nComponents; k++)
-        {
-        interpolatedValue[k] = 0.0;
-        }
-      for (vtkIdType j = 0; j < nPoints; j++)
-        {
-        const float *tuple = iData->GetPointer(nComponents * acp->GetId(j));
-        for (int k = 0; k < nComponents; k++)
-          {
-          interpolatedValue[k] += tuple[k];
-          }
-        }
-      const double weight = 1.0 / static_cast<double>(nPoints);
-      for (int k = 0; k < nComponents; k++)
-        {
-        interpolatedValue[k] *= weight;
-        }
-      // will automatically be converted to float
-      iData->InsertTuple(this->NumPoints + i, interpolatedValue);
-      }
+    vtkFoamAverageCellPoints<double> interpolator;
+    interpolator.Indices
+        = this->AdditionalCellPoints->GetIndices()->GetPointer(0);
+    interpolator.PointIds = this->AdditionalCellPoints->GetBody()->GetPointer(0);
+    interpolator.Data = iData->GetPointer(0);
+    interpolator.NComponents = iData->GetNumberOfComponents();
+    interpolator.NPoints = this->NumPoints;
+    vtkFoamParallelFor(nAdditionalPoints, VTK_FOAMFILE_MT_MINCELLS,
+        interpolator);
     }
 
   if (iData->GetSize() > 0)
@@ -8808,7 +13880,7 @@ void vtkOFFReaderPrivate::GetPointFieldAtTimeStep(
     if (internalMesh != NULL)
       {
       // set data to internal mesh
-      this->AddArrayToFieldData(internalMesh->GetPointData(), iData,
+      arrays->Add(internalMesh->GetPointData(), iData,
           io.GetObjectName() + dimString);
       }
     }
@@ -8832,15 +13904,17 @@ void vtkOFFReaderPrivate::GetPointFieldAtTimeStep(
     if (this->BoundaryDict[boundaryI].IsActive)
       {
       vtkFloatArray *vData = vtkFloatArray::New();
-      vtkIntArray& bpMap = *this->BoundaryPointMap->operator[](activeBoundaryI);
-      const int nPoints = bpMap.GetNumberOfTuples();
+      const vtkIdType *bpMap
+          = this->BoundaryPointMap->operator[](activeBoundaryI);
+      const vtkIdType nPoints
+          = this->BoundaryPointMap->GetSize(activeBoundaryI);
       vData->SetNumberOfComponents(iData->GetNumberOfComponents());
       vData->SetNumberOfTuples(nPoints);
-      for (int j = 0; j < nPoints; j++)
+      for (vtkIdType j = 0; j < nPoints; j++)
         {
-        vData->SetTuple(j, bpMap.GetValue(j), iData);
+        vData->SetTuple(j, bpMap[j], iData);
         }
-      this->AddArrayToFieldData(vtkPolyData::SafeDownCast(
+      arrays->Add(vtkPolyData::SafeDownCast(
           boundaryMesh->GetBlock(activeBoundaryI))->GetPointData(), vData, io.GetObjectName()
           + dimString);
       vData->Delete();
@@ -8850,6 +13924,166 @@ void vtkOFFReaderPrivate::GetPointFieldAtTimeStep(
   iData->Delete();
 }
 
+//-----------------------------------------------------------------------------
+// reads one of the vol, surface or point fields per task, each into
+// its own vtkFoamFieldArrays
+struct vtkOFFReaderPrivate::vtkFoamFieldTasks
+{
+  vtkOFFReaderPrivate *Reader;
+  vtkIdType NVolFields;
+  vtkIdType NSurfaceFields;
+  vtkstd::vector<vtkFoamFieldArrays> *Arrays;
+  vtkstd::vector<vtkFoamMessageSink> *Messages;
+
+  void operator()(const vtkIdType taskI) const
+  {
+    vtkOFFReaderPrivate &r = *this->Reader;
+    vtkFoamFieldArrays *arrays = &(*this->Arrays)[taskI];
+    vtkFoamMessageSinkScope messages(&(*this->Messages)[taskI]);
+    if (taskI < this->NVolFields)
+      {
+      r.GetVolFieldAtTimeStep(r.InternalMesh, r.BoundaryMesh,
+          r.VolFieldFiles->GetValue(taskI), arrays);
+      }
+    else if (taskI < this->NVolFields + this->NSurfaceFields)
+      {
+      r.GetSurfaceFieldAtTimeStep(r.SurfaceMesh, r.BoundaryMesh,
+          r.SurfaceFieldFiles->GetValue(taskI - this->NVolFields), arrays);
+      }
+    else
+      {
+      r.GetPointFieldAtTimeStep(r.InternalMesh, r.BoundaryMesh,
+          r.PointFieldFiles->GetValue(taskI - this->NVolFields
+          - this->NSurfaceFields), arrays);
+      }
+  }
+};
+
+//-----------------------------------------------------------------------------
+// interpolate the cell-to-point data of the internal mesh the field
+// tasks have deferred, in one pass over the points of the mesh
+void vtkOFFReaderPrivate::InterpolateInternalCellToPoint(
+    const vtkstd::vector<vtkFoamFieldArrays> &arrays)
+{
+  vtkstd::vector<vtkFoamCellToPointInterpolator::field> fields;
+  for (size_t taskI = 0; taskI < arrays.size(); taskI++)
+    {
+    const vtkFoamFieldArrays &fa = arrays[taskI];
+    for (size_t ctpI = 0; ctpI < fa.GetNumberOfCellToPoints(); ctpI++)
+      {
+      vtkFoamCellToPointInterpolator::field f;
+      f.PointData = fa.GetCellToPointPointData(ctpI)->GetPointer(0);
+      f.CellData = fa.GetCellToPointCellData(ctpI)->GetPointer(0);
+      f.BoundaryData = fa.GetCellToPointBoundaryData(ctpI)->GetPointer(0);
+      f.NComponents
+          = fa.GetCellToPointCellData(ctpI)->GetNumberOfComponents();
+      fields.push_back(f);
+      }
+    }
+  if (fields.empty())
+    {
+    return;
+    }
+
+  vtkFoamCellToPointInterpolator interpolator;
+  interpolator.CellIndices = this->PointCells->GetIndices()->GetPointer(0);
+  interpolator.CellIds = this->PointCells->GetBody()->GetPointer(0);
+  interpolator.FaceIndices
+      = this->AllBoundariesPointFaces->GetIndices()->GetPointer(0);
+  interpolator.FaceIds
+      = this->AllBoundariesPointFaces->GetBody()->GetPointer(0);
+  interpolator.Fields = &fields[0];
+  interpolator.NFields = static_cast<int>(fields.size());
+  vtkFoamParallelFor(this->NumPoints, VTK_FOAMFILE_MT_MINCELLS,
+      interpolator);
+}
+
+//-----------------------------------------------------------------------------
+// read the selected vol, surface and point fields concurrently and add
+// the resulting arrays to the meshes in the order of the field lists
+void vtkOFFReaderPrivate::GetFieldsAtTimeStep()
+{
+  const bool readSurfaceFields = this->SurfaceMesh != NULL
+      || (this->BoundaryMesh != NULL
+      && this->BoundaryMesh->GetNumberOfBlocks() > 0);
+
+  vtkFoamFieldTasks tasks;
+  tasks.Reader = this;
+  tasks.NVolFields = this->VolFieldFiles->GetNumberOfValues();
+  tasks.NSurfaceFields = readSurfaceFields
+      ? this->SurfaceFieldFiles->GetNumberOfValues() : 0;
+  const vtkIdType nTasks = tasks.NVolFields + tasks.NSurfaceFields
+      + this->PointFieldFiles->GetNumberOfValues();
+  vtkstd::vector<vtkFoamFieldArrays> arrays(static_cast<size_t>(nTasks));
+  tasks.Arrays = &arrays;
+  vtkstd::vector<vtkFoamMessageSink> messages(static_cast<size_t>(nTasks));
+  tasks.Messages = &messages;
+
+  if (this->Parent->GetCreateCellToPoint())
+    {
+    if (this->InternalMesh != NULL && this->PointCells == NULL)
+      {
+      this->BuildPointCells();
+      }
+
+    // the cell links InterpolateCellToPoint() uses are built on demand,
+    // which is not thread-safe, thus build them here beforehand
+    vtkIdList *pointCells = vtkIdList::New();
+    if (this->BoundaryMesh != NULL)
+      {
+      for (unsigned int i = 0; i < this->BoundaryMesh->GetNumberOfBlocks(); i++)
+        {
+        vtkPolyData *bm =
+            vtkPolyData::SafeDownCast(this->BoundaryMesh->GetBlock(i));
+        if (bm->GetNumberOfPoints() > 0)
+          {
+          bm->GetPointCells(0, pointCells);
+          }
+        }
+      }
+    pointCells->Delete();
+    }
+
+  vtkFoamParallelTasks(nTasks, this->Parent->GetNumberOfThreads(), tasks);
+
+  // report the messages of the tasks in the order of the field lists
+  for (size_t taskI = 0; taskI < messages.size(); taskI++)
+    {
+    const vtkstd::vector<vtkFoamMessageSink::message> &m
+        = messages[taskI].Messages;
+    for (size_t messageI = 0; messageI < m.size(); messageI++)
+      {
+      if (m[messageI].Type == vtkFoamMessageSink::MESSAGE_ERROR)
+        {
+        vtkErrorMacro(<< m[messageI].Text.c_str());
+        }
+      else if (m[messageI].Type == vtkFoamMessageSink::MESSAGE_WARNING)
+        {
+        vtkWarningMacro(<< m[messageI].Text.c_str());
+        }
+      else
+        {
+        vtkDebugWithObjectMacro(this->Parent, << m[messageI].Text.c_str());
+        }
+      }
+    }
+
+  if (this->PointCells != NULL && this->AllBoundariesPointFaces != NULL)
+    {
+    this->InterpolateInternalCellToPoint(arrays);
+    }
+
+  for (size_t taskI = 0; taskI < arrays.size(); taskI++)
+    {
+    const vtkFoamFieldArrays &fa = arrays[taskI];
+    for (size_t arrayI = 0; arrayI < fa.GetNumberOfArrays(); arrayI++)
+      {
+      this->AddArrayToFieldData(fa.GetFieldData(arrayI), fa.GetArray(arrayI),
+          fa.GetName(arrayI));
+      }
+    }
+}
+
 //-----------------------------------------------------------------------------
 vtkMultiBlockDataSet* vtkOFFReaderPrivate::MakeLagrangianMesh()
 {
@@ -9007,9 +14241,10 @@ vtkMultiBlockDataSet* vtkOFFReaderPrivate::MakeLagrangianMesh()
 }
 
 //-----------------------------------------------------------------------------
-// returns a dictionary of block names for a specified domain
+// returns a dictionary of block names for a specified domain. The
+// entries rejected by the filter, if given, are skipped unparsed.
 vtkFoamDict* vtkOFFReaderPrivate::GatherBlocks(const char* typeIn,
-    const int timeStep)
+    const int timeStep, const vtkFoamEntryFilter *filter)
 {
   if (this->PolyMeshFacesDir->GetValue(timeStep) == "")
     {
@@ -9029,7 +14264,7 @@ vtkFoamDict* vtkOFFReaderPrivate::GatherBlocks(const char* typeIn,
 
   vtkFoamDict* dictPtr = new vtkFoamDict;
   vtkFoamDict& dict = *dictPtr;
-  if (!dict.Read(io))
+  if (!vtkFoamReadDict(io, dict, filter))
     {
     vtkErrorMacro(<<"Error reading line " << io.GetLineNumber()
         << " of " << io.GetFileName().c_str() << ": " << io.GetError().c_str());
@@ -9046,13 +14281,132 @@ vtkFoamDict* vtkOFFReaderPrivate::GatherBlocks(const char* typeIn,
   return dictPtr;
 }
 
+//-----------------------------------------------------------------------------
+// class vtkFoamZoneFilter
+// reads only the names of the zones if no selection is given.
+// Otherwise rejects the zones not selected, and reads only the names
+// of the zones whose meshes are taken over from the previous zone mesh.
+struct vtkFoamZoneFilter : public vtkFoamEntryFilter
+{
+private:
+  typedef vtksys::hash_map<vtkstd::string, vtkDataObject *> blockMap;
+  vtkDataArraySelection *Selection;
+  vtkStdString Prefix;
+  blockMap OldBlocks;
+
+public:
+  vtkFoamZoneFilter(vtkDataArraySelection *selection,
+      const vtkStdString &prefix, vtkMultiBlockDataSet *oldZoneMesh) :
+    Selection(selection), Prefix(prefix), OldBlocks()
+  {
+    if (oldZoneMesh != NULL)
+      {
+      for (unsigned int i = 0; i < oldZoneMesh->GetNumberOfBlocks(); i++)
+        {
+        this->OldBlocks[oldZoneMesh->GetMetaData(i)->Get(
+            vtkCompositeDataSet::NAME())] = oldZoneMesh->GetBlock(i);
+        }
+      }
+  }
+
+  bool IsSelected(const vtkStdString &zoneName) const
+  {
+    const vtkStdString selectionName(this->Prefix + zoneName);
+    return this->Selection->ArrayExists(selectionName.c_str())
+        && this->Selection->ArrayIsEnabled(selectionName.c_str());
+  }
+  // the previously built mesh of the zone, NULL if none
+  vtkDataObject *GetOldBlock(const vtkStdString &zoneName) const
+  {
+    blockMap::const_iterator it = this->OldBlocks.find(zoneName);
+    return it != this->OldBlocks.end() ? it->second : NULL;
+  }
+  // whether any of the selected zones is yet to be built
+  bool HasMissingZones() const
+  {
+    const size_t prefixLength = this->Prefix.length();
+    for (int i = 0; i < this->Selection->GetNumberOfArrays(); i++)
+      {
+      const vtkStdString selectionName(this->Selection->GetArrayName(i));
+      if (this->Selection->GetArraySetting(i)
+          && selectionName.compare(0, prefixLength, this->Prefix) == 0
+          && this->GetOldBlock(selectionName.substr(prefixLength)) == NULL)
+        {
+        return true;
+        }
+      }
+    return false;
+  }
+
+  bool IsWanted(const vtkstd::vector<vtkStdString> &keywordPath) const
+  {
+    if (this->Selection == NULL)
+      {
+      return keywordPath.size() == 1;
+      }
+    if (!this->IsSelected(keywordPath[0]))
+      {
+      return false;
+      }
+    return keywordPath.size() == 1 || this->GetOldBlock(keywordPath[0]) == NULL;
+  }
+};
+
+//-----------------------------------------------------------------------------
+// adds the names of the zones of a type to the zone selection list
+// without parsing the zone contents
+void vtkOFFReaderPrivate::ListZoneNames(const char *zoneType)
+{
+  const vtkFoamZoneFilter filter(NULL, "", NULL);
+  vtkFoamDict *zoneDictPtr
+      = this->GatherBlocks(zoneType, this->TimeStep, &filter);
+
+  if (zoneDictPtr == NULL)
+    {
+    // not an error
+    return;
+    }
+
+  const vtkStdString prefix(this->RegionPrefix() + zoneType + "/");
+  for (size_t i = 0; i < zoneDictPtr->size(); i++)
+    {
+    const vtkStdString selectionName(prefix
+        + zoneDictPtr->operator[](i)->GetKeyword());
+    // zones are added selected so that turning on ReadZones outputs
+    // all the zones by default
+    if (!this->Parent->ZoneDataArraySelection
+        ->ArrayExists(selectionName.c_str()))
+      {
+      this->Parent->ZoneDataArraySelection
+          ->EnableArray(selectionName.c_str());
+      }
+    }
+
+  delete zoneDictPtr;
+}
+
+//-----------------------------------------------------------------------------
+// returns true if any of the selected zones of a type is not in the
+// given zone mesh
+bool vtkOFFReaderPrivate::HasMissingZones(vtkMultiBlockDataSet *zoneMesh,
+    const char *zoneType)
+{
+  const vtkFoamZoneFilter filter(this->Parent->ZoneDataArraySelection,
+      this->RegionPrefix() + zoneType + "/", zoneMesh);
+  return filter.HasMissingZones();
+}
+
 //-----------------------------------------------------------------------------
 // returns a requested point zone mesh
 bool vtkOFFReaderPrivate::GetPointZoneMesh(
-    vtkMultiBlockDataSet *pointZoneMesh, vtkPoints *points)
+    vtkMultiBlockDataSet *pointZoneMesh,
+    vtkMultiBlockDataSet *oldPointZoneMesh, vtkPoints *points)
 {
+  // only the selected zones that have not been built yet are parsed
+  const vtkFoamZoneFilter filter(this->Parent->ZoneDataArraySelection,
+      this->RegionPrefix() + "pointZones/", oldPointZoneMesh);
   vtkFoamDict *pointZoneDictPtr
-      = this->GatherBlocks("pointZones", this->TimeStep);
+      = this->GatherBlocks("pointZones", this->TimeStep, &filter);
 
   if (pointZoneDictPtr == NULL)
     {
@@ -9065,6 +14419,18 @@ bool vtkOFFReaderPrivate::GetPointZoneMesh(
 
   for (int i = 0; i < nPointZones; i++)
     {
+    const vtkStdString &zoneName = pointZoneDict[i]->GetKeyword();
+    const unsigned int blockI = pointZoneMesh->GetNumberOfBlocks();
+
+    // take over the mesh of the zone if already built
+    vtkDataObject *oldBlock = filter.GetOldBlock(zoneName);
+    if (oldBlock != NULL)
+      {
+      pointZoneMesh->SetBlock(blockI, oldBlock);
+      this->SetBlockName(pointZoneMesh, blockI, zoneName.c_str());
+      continue;
+      }
+
     // look up point labels
     vtkFoamDict &dict = pointZoneDict[i]->Dictionary();
     vtkFoamEntry *pointLabelsEntry = dict.Lookup("pointLabels");
@@ -9080,10 +14446,10 @@ bool vtkOFFReaderPrivate::GetPointZoneMesh(
     if (pointLabelsEntry->FirstValue().GetType() == vtkFoamToken::EMPTYLIST)
       {
       vtkPolyData *pzm = vtkPolyData::New();
-      pointZoneMesh->SetBlock(i, pzm);
+      pointZoneMesh->SetBlock(blockI, pzm);
       pzm->Delete();
       // set name
-      this->SetBlockName(pointZoneMesh, i, pointZoneDict[i]->GetKeyword().c_str());
+      this->SetBlockName(pointZoneMesh, blockI, zoneName.c_str());
       continue;
       }
 
@@ -9102,7 +14468,7 @@ bool vtkOFFReaderPrivate::GetPointZoneMesh(
     if (nPoints > this->NumPoints)
       {
       vtkErrorMacro(<<"The length of pointLabels " << nPoints
-          << " for pointZone " << pointZoneDict[i]->GetKeyword().c_str()
+          << " for pointZone " << zoneName.c_str()
           << " exceeds the number of points " << this->NumPoints);
       this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
       delete pointZoneDictPtr;
@@ -9131,10 +14497,10 @@ bool vtkOFFReaderPrivate::GetPointZoneMesh(
       }
     pzm->SetPoints(points);
 
-    pointZoneMesh->SetBlock(i, pzm);
+    pointZoneMesh->SetBlock(blockI, pzm);
     pzm->Delete();
     // set name
-    this->SetBlockName(pointZoneMesh, i, pointZoneDict[i]->GetKeyword().c_str());
+    this->SetBlockName(pointZoneMesh, blockI, zoneName.c_str());
     }
 
   delete pointZoneDictPtr;
@@ -9145,11 +14511,14 @@ bool vtkOFFReaderPrivate::GetPointZoneMesh(
 //-----------------------------------------------------------------------------
 // returns a requested face zone mesh
 bool vtkOFFReaderPrivate::GetFaceZoneMesh(
-    vtkMultiBlockDataSet *faceZoneMesh,
+    vtkMultiBlockDataSet *faceZoneMesh, vtkMultiBlockDataSet *oldFaceZoneMesh,
     const vtkFoamIntVectorVector *facesPoints, vtkPoints *points)
 {
+  // only the selected zones that have not been built yet are parsed
+  const vtkFoamZoneFilter filter(this->Parent->ZoneDataArraySelection,
+      this->RegionPrefix() + "faceZones/", oldFaceZoneMesh);
   vtkFoamDict *faceZoneDictPtr
-      = this->GatherBlocks("faceZones", this->TimeStep);
+      = this->GatherBlocks("faceZones", this->TimeStep, &filter);
 
   if (faceZoneDictPtr == NULL)
     {
@@ -9162,6 +14531,18 @@ bool vtkOFFReaderPrivate::GetFaceZoneMesh(
 
   for (int i = 0; i < nFaceZones; i++)
     {
+    const vtkStdString &zoneName = faceZoneDict[i]->GetKeyword();
+    const unsigned int blockI = faceZoneMesh->GetNumberOfBlocks();
+
+    // take over the mesh of the zone if already built
+    vtkDataObject *oldBlock = filter.GetOldBlock(zoneName);
+    if (oldBlock != NULL)
+      {
+      faceZoneMesh->SetBlock(blockI, oldBlock);
+      this->SetBlockName(faceZoneMesh, blockI, zoneName.c_str());
+      continue;
+      }
+
     // look up face labels
     vtkFoamDict &dict = faceZoneDict[i]->Dictionary();
     vtkFoamEntry *faceLabelsEntry = dict.Lookup("faceLabels");
@@ -9177,10 +14558,10 @@ bool vtkOFFReaderPrivate::GetFaceZoneMesh(
     if (faceLabelsEntry->FirstValue().GetType() == vtkFoamToken::EMPTYLIST)
       {
       vtkPolyData *fzm = vtkPolyData::New();
-      faceZoneMesh->SetBlock(i, fzm);
+      faceZoneMesh->SetBlock(blockI, fzm);
       fzm->Delete();
       // set name
-      this->SetBlockName(faceZoneMesh, i, faceZoneDict[i]->GetKeyword().c_str());
+      this->SetBlockName(faceZoneMesh, blockI, zoneName.c_str());
       continue;
       }
 
@@ -9192,71 +14573,258 @@ bool vtkOFFReaderPrivate::GetFaceZoneMesh(
       return false;
       }
 
-    vtkIntArray &labels = faceLabelsEntry->LabelList();
-
-    int nFaces = labels.GetNumberOfTuples();
-    if (nFaces > this->FaceOwner->GetNumberOfTuples())
+    vtkIntArray &labels = faceLabelsEntry->LabelList();
+
+    // FaceOwner may have been truncated to the boundary faces thus
+    // the faces list is the reference
+    int nFaces = labels.GetNumberOfTuples();
+    const vtkIdType nAllFaces = facesPoints->GetNumberOfElements();
+    if (nFaces > nAllFaces)
+      {
+      vtkErrorMacro(<<"The length of faceLabels " << nFaces
+          << " for faceZone " << zoneName.c_str()
+          << " exceeds the number of faces " << nAllFaces);
+      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+      delete faceZoneDictPtr;
+      return false;
+      }
+
+    // count the size of the connectivity while checking the labels
+    const int *faceLabels = labels.GetPointer(0);
+    vtkIdType connectivitySize = nFaces;
+    for (int j = 0; j < nFaces; j++)
+      {
+      const int faceId = faceLabels[j];
+      if (faceId >= nAllFaces)
+        {
+        vtkErrorMacro(<<"faceLabels id " << faceId
+            << " exceeds the number of faces " << nAllFaces);
+        this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
+        delete faceZoneDictPtr;
+        return false;
+        }
+      connectivitySize += facesPoints->GetSize(faceId);
+      }
+
+    // copy the slices of the faces list into polygons in the
+    // [n, id0, id1, ...] layout of vtkCellArray
+    vtkIdTypeArray *cellsArray = vtkIdTypeArray::New();
+    cellsArray->SetNumberOfValues(connectivitySize);
+    vtkIdType *cells = cellsArray->GetPointer(0);
+    for (int j = 0; j < nFaces; j++)
       {
-      vtkErrorMacro(<<"The length of faceLabels " << nFaces
-          << " for faceZone " << faceZoneDict[i]->GetKeyword().c_str()
-          << " exceeds the number of faces "
-          << this->FaceOwner->GetNumberOfTuples());
-      this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
-      delete faceZoneDictPtr;
-      return false;
+      const vtkIdType *facePoints = facesPoints->operator[](faceLabels[j]);
+      const vtkIdType nFacePoints = facesPoints->GetSize(faceLabels[j]);
+      *cells++ = nFacePoints;
+      for (vtkIdType k = 0; k < nFacePoints; k++)
+        {
+        cells[k] = facePoints[k];
+        }
+      cells += nFacePoints;
       }
 
     // allocate new grid: we do not use resize() beforehand since it
     // could lead to undefined pointer if we return by error
     vtkPolyData *fzm = vtkPolyData::New();
+    vtkCellArray *polys = vtkCellArray::New();
+    polys->SetCells(nFaces, cellsArray);
+    cellsArray->Delete();
+    fzm->SetPolys(polys);
+    polys->Delete();
+    fzm->SetPoints(points);
+    faceZoneMesh->SetBlock(blockI, fzm);
+    fzm->Delete();
+    // set name
+    this->SetBlockName(faceZoneMesh, blockI, zoneName.c_str());
+    }
+
+  delete faceZoneDictPtr;
 
-    // set faceZone size
-    fzm->Allocate(nFaces);
+  return true;
+}
 
-    // aloocate array for converting int vector to vtkIdType vector:
-    // workaround for 64bit machines
-    int maxNFacePoints = 0;
-    for (int j = 0; j < nFaces; j++)
+//-----------------------------------------------------------------------------
+// copy the cells of the internal mesh listed in cellList to a grid that
+// shares the points of the internal mesh. A decomposed polyhedron is
+// copied together with the additional cells it has been decomposed to.
+void vtkOFFReaderPrivate::ExtractCellsToGrid(vtkUnstructuredGrid *grid,
+    vtkIntArray *cellList)
+{
+  vtkUnstructuredGrid *internalMesh = this->InternalMesh;
+  const unsigned char *types
+      = internalMesh->GetCellTypesArray()->GetPointer(0);
+  const vtkIdType *locations
+      = internalMesh->GetCellLocationsArray()->GetPointer(0);
+  const vtkIdType *connectivity
+      = internalMesh->GetCells()->GetData()->GetPointer(0);
+  vtkIdTypeArray *facesArray = internalMesh->GetFaces();
+  const vtkIdType *faceLocations = facesArray != NULL
+      ? internalMesh->GetFaceLocations()->GetPointer(0) : NULL;
+  const vtkIdType *faces = facesArray != NULL
+      ? facesArray->GetPointer(0) : NULL;
+
+  // the decomposed polyhedra are listed in ascending order of cells and
+  // their additional cells follow the original cells in the same order
+  const vtkIdType nPolyhedra = this->AdditionalCellPoints != NULL
+      ? this->AdditionalCellIds->GetNumberOfTuples() : 0;
+  const vtkIdType *polyCellIds = nPolyhedra > 0
+      ? this->AdditionalCellIds->GetPointer(0) : NULL;
+  vtkstd::vector<vtkIdType> additionalCellStarts(nPolyhedra + 1);
+  additionalCellStarts[0] = this->NumCells;
+  for (vtkIdType polyI = 0; polyI < nPolyhedra; polyI++)
+    {
+    additionalCellStarts[polyI + 1] = additionalCellStarts[polyI]
+        + this->NumAdditionalCells->GetValue(polyI);
+    }
+
+  // list the cells to be copied
+  const int nListedCells = cellList->GetNumberOfTuples();
+  const int *listedCells = cellList->GetPointer(0);
+  vtkstd::vector<vtkIdType> cellIds;
+  cellIds.reserve(nListedCells);
+  for (int cellI = 0; cellI < nListedCells; cellI++)
+    {
+    const int cellId = listedCells[cellI];
+    if (cellId >= this->NumCells)
+      {
+      vtkWarningMacro(<<"cellLabels id " << cellId
+          << " exceeds the number of cells " << this->NumCells
+          << ". Inserting an empty cell.");
+      cellIds.push_back(-1);
+      continue;
+      }
+    cellIds.push_back(cellId);
+    if (nPolyhedra > 0)
       {
-      const int nFacePoints = facesPoints->GetSize(labels.GetValue(j));
-      if (nFacePoints > maxNFacePoints)
+      const vtkIdType polyI = vtkstd::lower_bound(polyCellIds,
+          polyCellIds + nPolyhedra, static_cast<vtkIdType>(cellId))
+          - polyCellIds;
+      if (polyI < nPolyhedra && polyCellIds[polyI] == cellId)
         {
-        maxNFacePoints = nFacePoints;
+        for (vtkIdType j = additionalCellStarts[polyI];
+            j < additionalCellStarts[polyI + 1]; j++)
+          {
+          cellIds.push_back(j);
+          }
         }
       }
-    vtkIdList *facePointsVtkId = vtkIdList::New();
-    facePointsVtkId->SetNumberOfIds(maxNFacePoints);
+    }
 
-    // insert faces
-    if (!this->InsertFacesToGrid(fzm, facesPoints, 0, nFaces, NULL,
-        facePointsVtkId, labels.GetPointer(0), false))
+  // count the sizes of the cell arrays
+  const vtkIdType nCells = static_cast<vtkIdType>(cellIds.size());
+  vtkIdType connectivitySize = 0, facesSize = 0;
+  for (vtkIdType cellI = 0; cellI < nCells; cellI++)
+    {
+    const vtkIdType cellId = cellIds[cellI];
+    if (cellId < 0)
       {
-      facePointsVtkId->Delete();
-      fzm->Delete();
-      return false;
+      connectivitySize++;
+      continue;
+      }
+    connectivitySize += connectivity[locations[cellId]] + 1;
+    if (faceLocations != NULL && faceLocations[cellId] >= 0)
+      {
+      const vtkIdType *cellFaces = faces + faceLocations[cellId];
+      const vtkIdType nCellFaces = cellFaces[0];
+      vtkIdType faceI = 1;
+      for (vtkIdType j = 0; j < nCellFaces; j++)
+        {
+        faceI += cellFaces[faceI] + 1;
+        }
+      facesSize += faceI;
       }
-    facePointsVtkId->Delete();
-    fzm->SetPoints(points);
-    faceZoneMesh->SetBlock(i, fzm);
-    fzm->Delete();
-    // set name
-    this->SetBlockName(faceZoneMesh, i, faceZoneDict[i]->GetKeyword().c_str());
     }
 
-  delete faceZoneDictPtr;
+  // copy the cells
+  vtkUnsignedCharArray *cellTypesArray = vtkUnsignedCharArray::New();
+  unsigned char *cellTypes = cellTypesArray->WritePointer(0, nCells);
+  vtkIdTypeArray *cellLocationsArray = vtkIdTypeArray::New();
+  vtkIdType *cellLocations = cellLocationsArray->WritePointer(0, nCells);
+  vtkIdTypeArray *connectivityArray = vtkIdTypeArray::New();
+  vtkIdType *cellPoints = connectivityArray->WritePointer(0,
+      connectivitySize);
+  vtkIdTypeArray *faceLocationsArray = NULL, *cellFacesArray = NULL;
+  vtkIdType *cellFaceLocations = NULL, *cellFaces = NULL;
+  if (facesSize > 0)
+    {
+    faceLocationsArray = vtkIdTypeArray::New();
+    cellFaceLocations = faceLocationsArray->WritePointer(0, nCells);
+    cellFacesArray = vtkIdTypeArray::New();
+    cellFaces = cellFacesArray->WritePointer(0, facesSize);
+    }
+  vtkIdType connectivityI = 0, facesI = 0;
+  for (vtkIdType cellI = 0; cellI < nCells; cellI++)
+    {
+    const vtkIdType cellId = cellIds[cellI];
+    cellLocations[cellI] = connectivityI;
+    if (cellFaceLocations != NULL)
+      {
+      cellFaceLocations[cellI] = -1;
+      }
+    if (cellId < 0)
+      {
+      cellTypes[cellI] = VTK_EMPTY_CELL;
+      cellPoints[connectivityI++] = 0;
+      continue;
+      }
+    cellTypes[cellI] = types[cellId];
+    const vtkIdType *points = connectivity + locations[cellId];
+    const vtkIdType nPoints = points[0] + 1;
+    for (vtkIdType j = 0; j < nPoints; j++)
+      {
+      cellPoints[connectivityI + j] = points[j];
+      }
+    connectivityI += nPoints;
+    if (cellFaceLocations != NULL && faceLocations[cellId] >= 0)
+      {
+      const vtkIdType *polyFaces = faces + faceLocations[cellId];
+      const vtkIdType nCellFaces = polyFaces[0];
+      vtkIdType faceI = 1;
+      for (vtkIdType j = 0; j < nCellFaces; j++)
+        {
+        faceI += polyFaces[faceI] + 1;
+        }
+      cellFaceLocations[cellI] = facesI;
+      for (vtkIdType j = 0; j < faceI; j++)
+        {
+        cellFaces[facesI + j] = polyFaces[j];
+        }
+      facesI += faceI;
+      }
+    }
 
-  return true;
+  // hand the cell arrays to the grid
+  vtkCellArray *cells = vtkCellArray::New();
+  cells->SetCells(nCells, connectivityArray);
+  if (cellFacesArray != NULL)
+    {
+    grid->SetCells(cellTypesArray, cellLocationsArray, cells,
+        faceLocationsArray, cellFacesArray);
+    faceLocationsArray->Delete();
+    cellFacesArray->Delete();
+    }
+  else
+    {
+    grid->SetCells(cellTypesArray, cellLocationsArray, cells);
+    }
+  cells->Delete();
+  connectivityArray->Delete();
+  cellLocationsArray->Delete();
+  cellTypesArray->Delete();
 }
 
 //-----------------------------------------------------------------------------
 // returns a requested cell zone mesh
 bool vtkOFFReaderPrivate::GetCellZoneMesh(
-    vtkMultiBlockDataSet *cellZoneMesh,
+    vtkMultiBlockDataSet *cellZoneMesh, vtkMultiBlockDataSet *oldCellZoneMesh,
     const vtkFoamIntVectorVector *cellsFaces,
     const vtkFoamIntVectorVector *facesPoints, vtkPoints *points)
 {
+  // only the selected zones that have not been built yet are parsed
+  const vtkFoamZoneFilter filter(this->Parent->ZoneDataArraySelection,
+      this->RegionPrefix() + "cellZones/", oldCellZoneMesh);
   vtkFoamDict *cellZoneDictPtr
-      = this->GatherBlocks("cellZones", this->TimeStep);
+      = this->GatherBlocks("cellZones", this->TimeStep, &filter);
 
   if (cellZoneDictPtr == NULL)
     {
@@ -9269,6 +14837,18 @@ bool vtkOFFReaderPrivate::GetCellZoneMesh(
 
   for (int i = 0; i < nCellZones; i++)
     {
+    const vtkStdString &zoneName = cellZoneDict[i]->GetKeyword();
+    const unsigned int blockI = cellZoneMesh->GetNumberOfBlocks();
+
+    // take over the mesh of the zone if already built
+    vtkDataObject *oldBlock = filter.GetOldBlock(zoneName);
+    if (oldBlock != NULL)
+      {
+      cellZoneMesh->SetBlock(blockI, oldBlock);
+      this->SetBlockName(cellZoneMesh, blockI, zoneName.c_str());
+      continue;
+      }
+
     // look up cell labels
     vtkFoamDict &dict = cellZoneDict[i]->Dictionary();
     vtkFoamEntry *cellLabelsEntry = dict.Lookup("cellLabels");
@@ -9284,9 +14864,10 @@ bool vtkOFFReaderPrivate::GetCellZoneMesh(
     if (cellLabelsEntry->FirstValue().GetType() == vtkFoamToken::EMPTYLIST)
       {
       vtkUnstructuredGrid *czm = vtkUnstructuredGrid::New();
-      cellZoneMesh->SetBlock(i, czm);
+      cellZoneMesh->SetBlock(blockI, czm);
+      czm->Delete();
       // set name
-      this->SetBlockName(cellZoneMesh, i, cellZoneDict[i]->GetKeyword().c_str());
+      this->SetBlockName(cellZoneMesh, blockI, zoneName.c_str());
       continue;
       }
 
@@ -9304,7 +14885,7 @@ bool vtkOFFReaderPrivate::GetCellZoneMesh(
     if (nCells > this->NumCells)
       {
       vtkErrorMacro(<<"The length of cellLabels " << nCells
-          << " for cellZone " << cellZoneDict[i]->GetKeyword().c_str()
+          << " for cellZone " << zoneName.c_str()
           << " exceeds the number of cells " << this->NumCells);
       this->Parent->SetErrorCode(vtkErrorCode::FileFormatError);
       delete cellZoneDictPtr;
@@ -9315,26 +14896,82 @@ bool vtkOFFReaderPrivate::GetCellZoneMesh(
     // could lead to undefined pointers if we return by error
     vtkUnstructuredGrid *czm = vtkUnstructuredGrid::New();
 
-    // set cellZone size
-    czm->Allocate(nCells);
-
-    // insert cells
-    this->InsertCellsToGrid(czm, cellsFaces, facesPoints, NULL, NULL, &labels);
+    // insert cells: take the cells the internal mesh already has if
+    // available
+    if (this->InternalMesh != NULL)
+      {
+      this->ExtractCellsToGrid(czm, &labels);
+      }
+    else
+      {
+      this->InsertCellsToGrid(czm, cellsFaces, facesPoints, NULL, false,
+          &labels);
+      }
 
     // set cell zone points
     czm->SetPoints(points);
 
-    cellZoneMesh->SetBlock(i, czm);
+    cellZoneMesh->SetBlock(blockI, czm);
     czm->Delete();
 
     // set name
-    this->SetBlockName(cellZoneMesh, i, cellZoneDict[i]->GetKeyword().c_str());
+    this->SetBlockName(cellZoneMesh, blockI, zoneName.c_str());
     }
 
   delete cellZoneDictPtr;
   return true;
 }
 
+//-----------------------------------------------------------------------------
+// rebuilds the zone meshes from the selected zones, taking over the
+// blocks of the zones that have already been built
+bool vtkOFFReaderPrivate::UpdateZoneMeshes(
+    const vtkFoamIntVectorVector *cellsFaces,
+    const vtkFoamIntVectorVector *facesPoints, vtkPoints *points)
+{
+  vtkMultiBlockDataSet *pointZoneMesh = vtkMultiBlockDataSet::New();
+  vtkMultiBlockDataSet *faceZoneMesh = vtkMultiBlockDataSet::New();
+  vtkMultiBlockDataSet *cellZoneMesh = vtkMultiBlockDataSet::New();
+  if (!this->GetPointZoneMesh(pointZoneMesh, this->PointZoneMesh, points)
+      || !this->GetFaceZoneMesh(faceZoneMesh, this->FaceZoneMesh, facesPoints,
+      points) || !this->GetCellZoneMesh(cellZoneMesh, this->CellZoneMesh,
+      cellsFaces, facesPoints, points))
+    {
+    pointZoneMesh->Delete();
+    faceZoneMesh->Delete();
+    cellZoneMesh->Delete();
+    this->ClearZoneMeshes();
+    return false;
+    }
+
+  this->ClearZoneMeshes();
+  if (pointZoneMesh->GetNumberOfBlocks() > 0)
+    {
+    this->PointZoneMesh = pointZoneMesh;
+    }
+  else
+    {
+    pointZoneMesh->Delete();
+    }
+  if (faceZoneMesh->GetNumberOfBlocks() > 0)
+    {
+    this->FaceZoneMesh = faceZoneMesh;
+    }
+  else
+    {
+    faceZoneMesh->Delete();
+    }
+  if (cellZoneMesh->GetNumberOfBlocks() > 0)
+    {
+    this->CellZoneMesh = cellZoneMesh;
+    }
+  else
+    {
+    cellZoneMesh->Delete();
+    }
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 void vtkOFFReaderPrivate::AddArrayToFieldData(
     vtkDataSetAttributes *fieldData, vtkDataArray *array,
@@ -9414,8 +15051,10 @@ void vtkOFFReaderPrivate::SetShallowCopies(vtkMultiBlockDataSet *output,
 // return 0 if there's any error, 1 if success
 int vtkOFFReaderPrivate::RequestData(vtkMultiBlockDataSet *output,
 bool recreateInternalMesh, bool recreateBoundaryMesh, bool updateVariables,
-bool recreateLagrangianMesh)
+bool recreateLagrangianMesh, bool updateZones)
 {
+  vtkFoamMaxThreadsScope maxThreads(this->Parent->GetNumberOfThreads());
+
   // determine if we need to reconstruct meshes
   recreateInternalMesh |= this->TimeStepOld == -1
       // the following three quite likely indicate reading mesh failed on
@@ -9430,23 +15069,38 @@ bool recreateLagrangianMesh)
       || this->PolyMeshFacesDir->GetValue(this->TimeStep)
           != this->PolyMeshFacesDir->GetValue(this->TimeStepOld)
       || this->FaceOwner == NULL;
+  // the zones are extracted from the internal mesh if it is kept,
+  // otherwise they are built from the mesh files read again
+  updateZones &= this->Parent->GetReadZones() != 0;
+  recreateInternalMesh |= updateZones && this->InternalMesh == NULL;
+  // if only the active patches have been read the patch selection
+  // cannot be changed without reading the mesh again
+  recreateInternalMesh |= recreateBoundaryMesh
+      && this->BoundaryOwnerCells != NULL;
   recreateBoundaryMesh |= recreateInternalMesh;
   updateVariables |= recreateBoundaryMesh || this->TimeStep
-      != this->TimeStepOld;
-  recreateLagrangianMesh |= this->TimeStepOld == -1
+      != this->TimeStepOld || this->RereadFields;
+  recreateLagrangianMesh |= this->TimeStepOld == -1 || this->RereadFields
       || (this->Parent->LagrangianPaths->GetNumberOfTuples()
           && this->TimeStep != this->TimeStepOld);
   const bool pointsMoved = this->TimeStepOld == -1
       || this->PolyMeshPointsDir->GetValue(this->TimeStep)
           != this->PolyMeshPointsDir->GetValue(this->TimeStepOld);
+  // stamped before the mesh files are read so that any file rewritten
+  // meanwhile is read again at the next refresh
+  if (this->Parent->GetCacheMesh()
+      && (recreateInternalMesh || recreateBoundaryMesh || pointsMoved))
+    {
+    this->MeshFilesKeyOld = this->MeshFilesKey(this->TimeStep);
+    }
   const bool moveInternalPoints = !recreateInternalMesh && pointsMoved;
   const bool moveBoundaryPoints = !recreateBoundaryMesh && pointsMoved;
 
   const bool createEulerians
       = this->PolyMeshFacesDir->GetValue(this->TimeStep) != "";
 
-  this->Parent->MeshChanged
-      |= recreateBoundaryMesh || recreateLagrangianMesh || pointsMoved;
+  this->Parent->MeshChanged |= recreateBoundaryMesh || recreateLagrangianMesh
+      || pointsMoved || updateZones;
 
   if (recreateInternalMesh)
     {
@@ -9460,28 +15114,111 @@ bool recreateLagrangianMesh)
     {
     this->ClearLagrangianMeshes();
     }
+  if (!this->Parent->GetReadZones())
+    {
+    this->ClearZoneMeshes();
+    }
+
+  // nothing but the patches is output: read only the parts of the
+  // mesh files the patches refer to
+  const bool readBoundaryOnly = !this->InternalMeshSelectionStatus
+      && !this->SurfaceMeshSelectionStatus && !this->Parent->GetReadZones()
+      && !this->Parent->GetCreateCellToPoint() && this->BoundaryDict.size() > 0;
+  // the mesh cache holds the internal mesh and the faces of the
+  // patches only, thus is not used if other faces are needed
+  const char *meshCacheDir = this->Parent->GetMeshCacheDirectory();
+  const bool useMeshCache = meshCacheDir != NULL && *meshCacheDir != '\0'
+      && this->InternalMeshSelectionStatus && !this->SurfaceMeshSelectionStatus
+      && !(this->Parent->GetReadZones()
+      && this->HasMissingZones(this->FaceZoneMesh, "faceZones"));
+  bool isMeshCached = false;
 
   vtkFoamIntVectorVector *facePoints = NULL;
+  vtkIdType faceOffset = 0;
   vtkStdString meshDir;
-  if (createEulerians && (recreateInternalMesh || recreateBoundaryMesh))
+  // the faces are also needed if any selected face zone is yet to be
+  // built
+  const bool readFaces = createEulerians && (recreateInternalMesh
+      || recreateBoundaryMesh || (updateZones
+      && this->HasMissingZones(this->FaceZoneMesh, "faceZones")));
+  if (readFaces)
     {
     // create paths to polyMesh files
     meshDir = this->CurrentTimeRegionMeshPath(this->PolyMeshFacesDir);
 
-    // create the faces vector
-    facePoints = this->ReadFacesFile(meshDir);
+    // create the faces vector of the patches only
+    if (recreateInternalMesh && readBoundaryOnly)
+      {
+      facePoints = this->ReadBoundaryMeshFiles(meshDir);
+      if (facePoints != NULL)
+        {
+        faceOffset = this->BoundaryDict[0].StartFace;
+        }
+      }
+    // restore the internal mesh from the mesh cache if valid
+    else if (recreateInternalMesh && useMeshCache)
+      {
+      facePoints = this->ReadMeshCache(meshDir, faceOffset);
+      isMeshCached = (facePoints != NULL);
+      }
+    }
+  // the cached internal mesh has the points of the faces directory
+  const bool moveCachedPoints = isMeshCached
+      && this->CurrentTimeRegionMeshPath(this->PolyMeshPointsDir) != meshDir;
+  const bool readOwnerNeighbor = createEulerians && recreateInternalMesh
+      && this->BoundaryOwnerCells == NULL && !isMeshCached;
+  const bool readPoints = createEulerians && ((recreateInternalMesh
+      && !isMeshCached) || (recreateBoundaryMesh && !recreateInternalMesh
+      && this->InternalMesh == NULL) || moveInternalPoints
+      || moveBoundaryPoints || moveCachedPoints);
+
+  // read faces, owner, neighbour and points concurrently
+  vtkFoamMeshFile meshFiles[4];
+  int nMeshFiles = 0;
+  vtkFoamMeshFile *facesFile = NULL, *ownerFile = NULL, *neighborFile = NULL,
+      *pointsFile = NULL;
+  if (readFaces && facePoints == NULL)
+    {
+    facesFile = &meshFiles[nMeshFiles++];
+    facesFile->SetFile(vtkFoamMeshFile::FACES, meshDir + "faces");
+    }
+  if (readOwnerNeighbor)
+    {
+    ownerFile = &meshFiles[nMeshFiles++];
+    ownerFile->SetFile(vtkFoamMeshFile::LABELLIST, meshDir + "owner");
+    neighborFile = &meshFiles[nMeshFiles++];
+    neighborFile->SetFile(vtkFoamMeshFile::LABELLIST, meshDir + "neighbour");
+    }
+  if (readPoints)
+    {
+    pointsFile = &meshFiles[nMeshFiles++];
+    if (this->PolyMeshPointsDir->GetValue(this->TimeStep) != "")
+      {
+      pointsFile->SetFile(vtkFoamMeshFile::POINTS,
+          this->CurrentTimeRegionMeshPath(this->PolyMeshPointsDir) + "points");
+      }
+    }
+  this->ReadMeshFiles(meshFiles, nMeshFiles);
+
+  if (facesFile != NULL)
+    {
+    facePoints = this->ReadFacesFile(*facesFile);
     if (facePoints == NULL)
       {
       return 0;
       }
+    }
+  if (readFaces)
+    {
     this->Parent->UpdateProgress(0.2);
     }
 
   vtkFoamIntVectorVector *cellFaces = NULL;
-  if (createEulerians && recreateInternalMesh)
+  if (readOwnerNeighbor)
     {
-    // read owner/neighbor and create the FaceOwner and cellFaces vectors
-    cellFaces = this->ReadOwnerNeighborFiles(meshDir, facePoints);
+    // create the FaceOwner and cellFaces vectors from owner/neighbor
+    cellFaces = this->ReadOwnerNeighborFiles(meshDir, facePoints, *ownerFile,
+        *neighborFile);
     if (cellFaces == NULL)
       {
       delete facePoints;
@@ -9491,12 +15228,10 @@ bool recreateLagrangianMesh)
     }
 
   vtkFloatArray *pointArray = NULL;
-  if (createEulerians && (recreateInternalMesh || (recreateBoundaryMesh
-      && !recreateInternalMesh && this->InternalMesh == NULL)
-      || moveInternalPoints || moveBoundaryPoints))
+  if (readPoints)
     {
     // get the points
-    pointArray = this->ReadPointsFile();
+    pointArray = this->ReadPointsFile(*pointsFile);
     if ((pointArray == NULL && recreateInternalMesh) || (facePoints != NULL
         && !this->CheckFacePoints(facePoints)))
       {
@@ -9507,11 +15242,27 @@ bool recreateLagrangianMesh)
     this->Parent->UpdateProgress(0.4);
     }
 
+  // move the cached internal mesh before anything is built upon it.
+  // This also appends the moved centroids of the decomposed polyhedra
+  // to the points.
+  if (moveCachedPoints)
+    {
+    vtkPoints *points = this->MoveInternalMesh(this->InternalMesh,
+        pointArray);
+    if (points == NULL)
+      {
+      delete facePoints;
+      pointArray->Delete();
+      return 0;
+      }
+    points->Delete();
+    }
+
   // make internal mesh
   // Create Internal Mesh only if required for display
   if (createEulerians && recreateInternalMesh)
     {
-    if (this->InternalMeshSelectionStatus)
+    if (this->InternalMeshSelectionStatus && !isMeshCached)
       {
       this->InternalMesh = this->MakeInternalMesh(cellFaces, facePoints,
           pointArray);
@@ -9562,88 +15313,49 @@ bool recreateLagrangianMesh)
         points->SetData(pointArray);
         }
 
-      this->PointZoneMesh = vtkMultiBlockDataSet::New();
-      if (!this->GetPointZoneMesh(this->PointZoneMesh, points))
-        {
-        this->PointZoneMesh->Delete();
-        this->PointZoneMesh = NULL;
-        delete cellFaces;
-        delete facePoints;
-        if (this->InternalMesh == NULL)
-          {
-          points->Delete();
-          }
-        pointArray->Delete();
-        return 0;
-        }
-      if (this->PointZoneMesh->GetNumberOfBlocks() == 0)
+      const bool isZoneRead
+          = this->UpdateZoneMeshes(cellFaces, facePoints, points);
+      if (this->InternalMesh == NULL)
         {
-        this->PointZoneMesh->Delete();
-        this->PointZoneMesh = NULL;
+        points->Delete();
         }
-
-      this->FaceZoneMesh = vtkMultiBlockDataSet::New();
-      if (!this->GetFaceZoneMesh(this->FaceZoneMesh, facePoints, points))
+      if (!isZoneRead)
         {
-        this->FaceZoneMesh->Delete();
-        this->FaceZoneMesh = NULL;
-        if (this->PointZoneMesh != NULL)
-          {
-          this->PointZoneMesh->Delete();
-          this->PointZoneMesh = NULL;
-          }
         delete cellFaces;
         delete facePoints;
-        if (this->InternalMesh == NULL)
+        if (pointArray != NULL)
           {
-          points->Delete();
+          pointArray->Delete();
           }
-        pointArray->Delete();
         return 0;
         }
-      if (this->FaceZoneMesh->GetNumberOfBlocks() == 0)
-        {
-        this->FaceZoneMesh->Delete();
-        this->FaceZoneMesh = NULL;
-        }
+      }
+    delete cellFaces;
+    if (this->BoundaryOwnerCells == NULL && !isMeshCached)
+      {
+      this->TruncateFaceOwner();
+      }
 
-      this->CellZoneMesh = vtkMultiBlockDataSet::New();
-      if (!this->GetCellZoneMesh(this->CellZoneMesh, cellFaces, facePoints,
-          points))
+    // store the mesh just built for the later sessions
+    if (useMeshCache && !isMeshCached && this->InternalMesh != NULL)
+      {
+      this->WriteMeshCache(meshDir, facePoints);
+      }
+    }
+  else if (createEulerians && updateZones)
+    {
+    // build or drop only the zones whose selection has changed. The
+    // internal mesh is there since otherwise it has been recreated.
+    if (!this->UpdateZoneMeshes(NULL, facePoints,
+        this->InternalMesh->GetPoints()))
+      {
+      delete facePoints;
+      if (pointArray != NULL)
         {
-        this->CellZoneMesh->Delete();
-        this->CellZoneMesh = NULL;
-        if (this->FaceZoneMesh != NULL)
-          {
-          this->FaceZoneMesh->Delete();
-          this->FaceZoneMesh = NULL;
-          }
-        if (this->PointZoneMesh != NULL)
-          {
-          this->PointZoneMesh->Delete();
-          this->PointZoneMesh = NULL;
-          }
-        delete cellFaces;
-        delete facePoints;
-        if (this->InternalMesh == NULL)
-          {
-          points->Delete();
-          }
         pointArray->Delete();
-        return 0;
-        }
-      if (this->CellZoneMesh->GetNumberOfBlocks() == 0)
-        {
-        this->CellZoneMesh->Delete();
-        this->CellZoneMesh = NULL;
-        }
-      if (this->InternalMesh == NULL)
-        {
-        points->Delete();
         }
+      return 0;
       }
-    delete cellFaces;
-    this->TruncateFaceOwner();
     }
 
   if (createEulerians && recreateBoundaryMesh)
@@ -9659,7 +15371,8 @@ bool recreateLagrangianMesh)
           = static_cast<vtkFloatArray *>(this->InternalMesh->GetPoints()->GetData());
       }
     // create boundary mesh
-    this->BoundaryMesh = this->MakeBoundaryMesh(facePoints, boundaryPointArray);
+    this->BoundaryMesh = this->MakeBoundaryMesh(facePoints, boundaryPointArray,
+        faceOffset);
     if (this->BoundaryMesh == NULL)
       {
       delete facePoints;
@@ -9779,33 +15492,8 @@ bool recreateLagrangianMesh)
           }
         }
       // read field data variables into Internal/Boundary meshes
-      for (int i = 0; i < (int)this->VolFieldFiles->GetNumberOfValues(); i++)
-        {
-        this->GetVolFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
-            this->VolFieldFiles->GetValue(i));
-        this->Parent->UpdateProgress(0.5 + 0.25 * ((float)(i + 1)
-            / ((float)this->VolFieldFiles->GetNumberOfValues() + 0.0001)));
-        }
-      if (this->SurfaceMesh != NULL || (this->BoundaryMesh != NULL
-          && this->BoundaryMesh->GetNumberOfBlocks() > 0))
-        {
-        for (int i = 0; i < (int)this->SurfaceFieldFiles->GetNumberOfValues();
-             i++)
-          {
-          this->GetSurfaceFieldAtTimeStep(this->SurfaceMesh,
-              this->BoundaryMesh, this->SurfaceFieldFiles->GetValue(i));
-          this->Parent->UpdateProgress(0.75 + 0.125 * ((float)(i + 1) /
-                  ((float)this->SurfaceFieldFiles->GetNumberOfValues()
-                  + 0.0001)));
-          }
-        }
-      for (int i = 0; i < (int)this->PointFieldFiles->GetNumberOfValues(); i++)
-        {
-        this->GetPointFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
-            this->PointFieldFiles->GetValue(i));
-        this->Parent->UpdateProgress(0.75 + 0.125 * ((float)(i + 1)
-            / ((float)this->PointFieldFiles->GetNumberOfValues() + 0.0001)));
-        }
+      this->GetFieldsAtTimeStep();
+      this->Parent->UpdateProgress(0.875);
       }
     }
 
@@ -9895,6 +15583,7 @@ bool recreateLagrangianMesh)
     this->ClearMeshes();
     this->TimeStepOld = -1;
     }
+  this->RereadFields = false;
   this->InternalMeshSelectionStatusOld = this->InternalMeshSelectionStatus;
   this->SurfaceMeshSelectionStatusOld = this->SurfaceMeshSelectionStatus;
 
@@ -9934,12 +15623,21 @@ vtkOFFReader::vtkOFFReader()
   // Child readers
   this->Readers = vtkCollection::New();
 
+  // directory index of the case
+  this->CaseIndex = new vtkFoamCaseIndex;
+
+  // watching the case for new timesteps
+  this->Watch = 0;
+  this->CaseWatcher = new vtkFoamCaseWatcher;
+  this->CompletedTimeSteps = vtkStringArray::New();
+
   // VTK CLASSES
   this->PatchDataArraySelection = vtkDataArraySelection::New();
   this->CellDataArraySelection = vtkDataArraySelection::New();
   this->SurfaceDataArraySelection = vtkDataArraySelection::New();
   this->PointDataArraySelection = vtkDataArraySelection::New();
   this->LagrangianDataArraySelection = vtkDataArraySelection::New();
+  this->ZoneDataArraySelection = vtkDataArraySelection::New();
 
   this->PatchSelectionMTimeOld = 0;
   this->CellSelectionMTimeOld = 0;
@@ -9947,6 +15645,7 @@ vtkOFFReader::vtkOFFReader()
   this->PointSelectionMTimeOld = 0;
   this->LagrangianSelectionMTimeOld = 0;
   this->LagrangianPathsMTimeOld = 0;
+  this->ZoneSelectionMTimeOld = 0;
 
   // for creating cell-to-point translated data
   this->CreateCellToPoint = 1;
@@ -9987,6 +15686,12 @@ vtkOFFReader::vtkOFFReader()
   this->ForceZeroGradient = 0;
   this->ForceZeroGradientOld = 0;
 
+  // read fields on as many threads as vtkMultiThreader provides
+  this->NumberOfThreads = 0;
+
+  // no persistent mesh cache by default
+  this->MeshCacheDirectory = NULL;
+
   // has mesh changed at this time step or not
   this->MeshChanged = 0;
 
@@ -10008,11 +15713,16 @@ vtkOFFReader::~vtkOFFReader()
   this->SurfaceDataArraySelection->Delete();
   this->PointDataArraySelection->Delete();
   this->LagrangianDataArraySelection->Delete();
+  this->ZoneDataArraySelection->Delete();
 
   this->Readers->Delete();
   this->CasePath->Delete();
+  delete this->CaseIndex;
+  delete this->CaseWatcher;
+  this->CompletedTimeSteps->Delete();
 
   this->SetFileName(0);
+  this->SetMeshCacheDirectory(0);
   delete this->FileNameOld;
 }
 
@@ -10045,6 +15755,12 @@ void vtkOFFReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "AddDimensionsToArrayNames: "
       << this->AddDimensionsToArrayNames << endl;
   os << indent << "ForceZeroGradient: " << this->ForceZeroGradient << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+  os << indent << "MeshCacheDirectory: " << (this->MeshCacheDirectory
+      ? this->MeshCacheDirectory : "(none)") << endl;
+  os << indent << "Watch: " << this->Watch << endl;
+  os << indent << "Completed Time Steps: \n";
+  this->CompletedTimeSteps->PrintSelf(os, indent.GetNextIndent());
 
   os << indent << "Case Path: \n";
   this->CasePath->PrintSelf(os, indent.GetNextIndent());
@@ -10067,6 +15783,8 @@ void vtkOFFReader::PrintSelf(ostream& os, vtkIndent indent)
   this->PointDataArraySelection->PrintSelf(os, indent.GetNextIndent());
   os << indent << "Lagrangian Data Array Selection: \n";
   this->LagrangianDataArraySelection->PrintSelf(os, indent.GetNextIndent());
+  os << indent << "Zone Data Array Selection: \n";
+  this->ZoneDataArraySelection->PrintSelf(os, indent.GetNextIndent());
 
   os << indent << "Patch Selection MTime Old: "
     << this->PatchSelectionMTimeOld << endl;
@@ -10080,6 +15798,8 @@ void vtkOFFReader::PrintSelf(ostream& os, vtkIndent indent)
     << this->LagrangianSelectionMTimeOld << endl;
   os << indent << "Lagrangian Paths MTime Old: "
     << this->LagrangianPathsMTimeOld << endl;
+  os << indent << "Zone Selection MTime Old: "
+    << this->ZoneSelectionMTimeOld << endl;
 
   os << indent << "FileNameOld: " << (this->FileNameOld ? *this->FileNameOld :
       vtkStdString()) << endl;
@@ -10170,6 +15890,58 @@ void vtkOFFReader::EnableAllSelectionArrays(vtkDataArraySelection *s)
     }
 }
 
+//-----------------------------------------------------------------------------
+// watching the case for new timesteps
+
+// does not call Modified() since watching does not change the output
+void vtkOFFReader::SetWatch(const int watch)
+{
+  if (this->Watch != watch)
+    {
+    this->Watch = watch;
+    if (!watch)
+      {
+      this->CaseWatcher->Stop();
+      this->CompletedTimeSteps->Initialize();
+      }
+    }
+}
+
+vtkStringArray *vtkOFFReader::GetCompletedTimeSteps()
+{
+  if (this->Watch && this->FileName != NULL && strlen(this->FileName) > 0)
+    {
+    if (this->CaseWatcher->FileName != this->FileName)
+      {
+      vtkStringArray *dirs = vtkStringArray::New();
+      this->GetWatchedDirectories(dirs);
+      this->CaseWatcher->Start(vtkStdString(this->FileName), dirs);
+      dirs->Delete();
+      }
+    this->CaseWatcher->Poll(this->CompletedTimeSteps);
+    }
+  return this->CompletedTimeSteps;
+}
+
+int vtkOFFReader::GetWatchIsEventDriven()
+{
+  return this->Watch && this->CaseWatcher->Fd >= 0;
+}
+
+// restarted at the next poll
+void vtkOFFReader::ResetWatcher()
+{
+  this->CaseWatcher->Stop();
+}
+
+// the directories the time directories are created in
+void vtkOFFReader::GetWatchedDirectories(vtkStringArray *dirs)
+{
+  vtkStdString casePath, controlDictPath;
+  this->CreateCasePath(casePath, controlDictPath);
+  dirs->InsertNextValue(casePath);
+}
+
 //-----------------------------------------------------------------------------
 // RequestInformation
 int vtkOFFReader::RequestInformation(vtkInformation *vtkNotUsed(request), vtkInformationVector **vtkNotUsed(inputVector), vtkInformationVector *outputVector)
@@ -10196,6 +15968,7 @@ int vtkOFFReader::RequestInformation(vtkInformation *vtkNotUsed(request), vtkInf
       this->PointDataArraySelection->RemoveAllArrays();
       this->LagrangianDataArraySelection->RemoveAllArrays();
       this->PatchDataArraySelection->RemoveAllArrays();
+      this->ZoneDataArraySelection->RemoveAllArrays();
       }
 
     // Reset NumberOfReaders here so that the variable will not be
@@ -10203,6 +15976,9 @@ int vtkOFFReader::RequestInformation(vtkInformation *vtkNotUsed(request), vtkInf
     // vtkPOpenFOAMReader
     this->NumberOfReaders = 0;
 
+    // the completed timesteps are listed by the rescan
+    this->CompletedTimeSteps->Initialize();
+
     if (!this->MakeInformationVector(outputVector, vtkStdString(""))
         || !this->MakeMetaDataAtTimeStep(true))
       {
@@ -10269,8 +16045,8 @@ int vtkOFFReader::RequestData(vtkInformation *vtkNotUsed(request), vtkInformatio
   // internal mesh selection change is detected within each reader
   const bool recreateInternalMesh = (!this->Parent->CacheMesh)
       || this->Parent->DecomposePolyhedra
-          != this->Parent->DecomposePolyhedraOld || this->Parent->ReadZones
-      != this->Parent->ReadZonesOld || this->Parent->ListTimeStepsByControlDict
+          != this->Parent->DecomposePolyhedraOld
+      || this->Parent->ListTimeStepsByControlDict
       != this->Parent->ListTimeStepsByControlDictOld
       || this->Parent->IsSinglePrecisionBinary
       != this->Parent->IsSinglePrecisionBinaryOld;
@@ -10306,6 +16082,9 @@ int vtkOFFReader::RequestData(vtkInformation *vtkNotUsed(request), vtkInformatio
           != this->Parent->PositionsIsIn13FormatOld
       || this->Parent->IsSinglePrecisionBinary
           != this->Parent->IsSinglePrecisionBinaryOld;
+  const bool updateZones = this->Parent->ZoneDataArraySelection->GetMTime()
+      != this->Parent->ZoneSelectionMTimeOld
+      || this->Parent->ReadZones != this->Parent->ReadZonesOld;
 
   // create dataset
   int ret = 1;
@@ -10316,7 +16095,8 @@ int vtkOFFReader::RequestData(vtkInformation *vtkNotUsed(request), vtkInformatio
           this->Readers->GetItemAsObject(0)))->GetRegionName() == "")
     {
     ret = reader->RequestData(output, recreateInternalMesh,
-        recreateBoundaryMesh, updateVariables, recreateLagrangianMesh);
+        recreateBoundaryMesh, updateVariables, recreateLagrangianMesh,
+        updateZones);
     this->Parent->CurrentReaderIndex++;
     }
   else
@@ -10328,7 +16108,8 @@ int vtkOFFReader::RequestData(vtkInformation *vtkNotUsed(request), vtkInformatio
       {
       vtkMultiBlockDataSet *subOutput = vtkMultiBlockDataSet::New();
       if (reader->RequestData(subOutput, recreateInternalMesh,
-          recreateBoundaryMesh, updateVariables, recreateLagrangianMesh))
+          recreateBoundaryMesh, updateVariables, recreateLagrangianMesh,
+          updateZones))
         {
         vtkStdString regionName(reader->GetRegionName());
         if (regionName == "")
@@ -10378,52 +16159,83 @@ void vtkOFFReader::SetTimeInformation(vtkInformationVector *outputVector,
 void vtkOFFReader::GetRegions(vtkStringArray *regionNames,
     const vtkStdString &timeDir)
 {
-  vtkDirectory *dir = vtkDirectory::New();
-  if (!dir->Open(timeDir.c_str()))
+  const bool isSinglePrecisionBinary
+      = this->Parent->GetIsSinglePrecisionBinary() != 0;
+  const vtkFoamCaseIndex::vtkFoamDirEntry *dir
+      = this->CaseIndex->Lookup(timeDir, false, isSinglePrecisionBinary);
+  if (dir == NULL)
     {
-    dir->Delete();
     return;
     }
-  for (int fileI = 0; fileI < dir->GetNumberOfFiles(); fileI++)
+  for (size_t dirI = 0; dirI < dir->SubDirs.size(); dirI++)
     {
-    vtkStdString subDir(dir->GetFile(fileI));
+    const vtkStdString &subDir = dir->SubDirs[dirI];
     // "uniform" subdir is used for recording time by OF <= 1.4.1
-    if (dir->FileIsDirectory(subDir.c_str()) && subDir != "." && subDir != ".."
-        && subDir != "polyMesh" && subDir != "lagrangian" && subDir != "uniform")
+    if (subDir != "polyMesh" && subDir != "lagrangian" && subDir != "uniform")
       {
       if(regionNames->LookupValue(subDir) >= 0)
         {
         continue;
         }
-      vtkStdString boundaryPath(timeDir + "/" + subDir + "/polyMesh/boundary");
-      if (vtksys::SystemTools::FileExists(boundaryPath.c_str(), true)
-          || vtksys::SystemTools::FileExists((boundaryPath + ".gz").c_str(), true))
+      if (this->CaseIndex->LookupHeader(timeDir + "/" + subDir + "/polyMesh",
+          "boundary", isSinglePrecisionBinary) != NULL)
         {
         regionNames->InsertNextValue(subDir);
         }
       }
     }
-  dir->Delete();
 }
 
 //-----------------------------------------------------------------------------
 int vtkOFFReader::MakeInformationVector(
     vtkInformationVector *outputVector, const vtkStdString& procName)
 {
+  vtkStdString casePath, controlDictPath;
+  this->CreateCasePath(casePath, controlDictPath);
+  casePath += procName + (procName == "" ? "" : "/");
+
+  // when refreshing the same case the readers are kept and updated so
+  // that only the new time directories are scanned and the meshes
+  // read are retained
+  vtkOFFReaderPrivate *masterReader = NULL;
+  if (*this->FileNameOld == this->FileName
+      && this->CaseIndex->CasePath == casePath
+      && this->Parent->ListTimeStepsByControlDict
+      == this->Parent->ListTimeStepsByControlDictOld)
+    {
+    masterReader = vtkOFFReaderPrivate::SafeDownCast(
+        this->Readers->GetItemAsObject(0));
+    }
   *this->FileNameOld = vtkStdString(this->FileName);
 
-  // clear prior case information
-  this->Readers->RemoveAllItems();
+  vtkStringArray *timeNamesOld = NULL;
+  if (masterReader != NULL)
+    {
+    masterReader->Register(this);
+    timeNamesOld = vtkStringArray::New();
+    timeNamesOld->DeepCopy(masterReader->GetTimeNames());
+    }
+  else
+    {
+    // clear prior case information
+    this->Readers->RemoveAllItems();
+    if (this->CaseIndex->CasePath != casePath)
+      {
+      this->CaseIndex->Initialize(casePath);
+      }
+    masterReader = vtkOFFReaderPrivate::New();
+    }
 
   // recreate case information
-  vtkStdString casePath, controlDictPath;
-  this->CreateCasePath(casePath, controlDictPath);
-  casePath += procName + (procName == "" ? "" : "/");
-  vtkOFFReaderPrivate *masterReader = vtkOFFReaderPrivate::New();
   if (!masterReader->MakeInformationVector(casePath, controlDictPath, procName,
-      this->Parent))
+      this->Parent, this->CaseIndex, timeNamesOld))
     {
+    this->Readers->RemoveAllItems();
     masterReader->Delete();
+    if (timeNamesOld != NULL)
+      {
+      timeNamesOld->Delete();
+      }
     return 0;
     }
 
@@ -10436,12 +16248,18 @@ int vtkOFFReader::MakeInformationVector(
     {
     vtkWarningMacro(<< "Case " << casePath.c_str()
         << " contains no timestep data.");
+    this->Readers->RemoveAllItems();
     masterReader->Delete();
+    if (timeNamesOld != NULL)
+      {
+      timeNamesOld->Delete();
+      }
     this->Parent->SetErrorCode(vtkErrorCode::NoError);
     return 1;
     }
 
-  this->Readers->AddItem(masterReader);
+  vtkCollection *readers = vtkCollection::New();
+  readers->AddItem(masterReader);
 
   // search subregions under constant subdirectory
   vtkStringArray *regionNames = vtkStringArray::New();
@@ -10456,14 +16274,39 @@ int vtkOFFReader::MakeInformationVector(
   regionNames->Squeeze();
   for(int regionI = 0; regionI < regionNames->GetNumberOfValues(); regionI++)
     {
-    vtkOFFReaderPrivate *subReader = vtkOFFReaderPrivate::New();
-    subReader->SetupInformation(casePath, regionNames->GetValue(regionI),
-        procName, masterReader);
-    this->Readers->AddItem(subReader);
-    subReader->Delete();
+    // update the reader of a region found before
+    vtkOFFReaderPrivate *subReader = NULL;
+    if (timeNamesOld != NULL)
+      {
+      this->Readers->InitTraversal();
+      while ((subReader = vtkOFFReaderPrivate::SafeDownCast(
+          this->Readers->GetNextItemAsObject())) != NULL
+          && subReader->GetRegionName() != regionNames->GetValue(regionI))
+        {
+        }
+      }
+    if (subReader != NULL)
+      {
+      subReader->UpdateTimeInformation(timeNamesOld);
+      readers->AddItem(subReader);
+      }
+    else
+      {
+      subReader = vtkOFFReaderPrivate::New();
+      subReader->SetupInformation(casePath, regionNames->GetValue(regionI),
+          procName, masterReader);
+      readers->AddItem(subReader);
+      subReader->Delete();
+      }
     }
   regionNames->Delete();
   masterReader->Delete();
+  if (timeNamesOld != NULL)
+    {
+    timeNamesOld->Delete();
+    }
+  this->Readers->Delete();
+  this->Readers = readers;
   this->Parent->NumberOfReaders += this->Readers->GetNumberOfItems();
 
   if (this->Parent == this)
@@ -10615,6 +16458,14 @@ int vtkOFFReader::MakeMetaDataAtTimeStep(const bool listNextTimeStep)
   this->AddSelectionNames(this->Parent->LagrangianDataArraySelection,
       lagrangianSelectionNames);
 
+  // store the directories newly indexed
+  reader
+      = vtkOFFReaderPrivate::SafeDownCast(this->Readers->GetItemAsObject(0));
+  if (reader != NULL)
+    {
+    reader->WriteCaseIndex();
+    }
+
   return ret;
 }
 
@@ -10641,6 +16492,7 @@ void vtkOFFReader::UpdateStatus()
   this->LagrangianSelectionMTimeOld
       = this->LagrangianDataArraySelection->GetMTime();
   this->LagrangianPathsMTimeOld = this->LagrangianPaths->GetMTime();
+  this->ZoneSelectionMTimeOld = this->ZoneDataArraySelection->GetMTime();
   this->CreateCellToPointOld = this->CreateCellToPoint;
   this->DecomposePolyhedraOld = this->DecomposePolyhedra;
   this->PositionsIsIn13FormatOld = this->PositionsIsIn13Format;
@@ -59,6 +59,8 @@ class vtkDataArraySelection;
 class vtkDoubleArray;
 class vtkStdString;
 class vtkStringArray;
+struct vtkFoamCaseIndex;
+struct vtkFoamCaseWatcher;
 
 class
 #if !defined(POFFDevReaderPlugin_EXPORTS)
@@ -236,6 +238,32 @@ public:
   void EnableAllPatchArrays()
   { this->EnableAllSelectionArrays(this->PatchDataArraySelection); }
 
+  // Description:
+  // Get the number of point/face/cell zones available in the input.
+  // The zones are listed only while ReadZones is on.
+  int GetNumberOfZoneArrays(void)
+  { return this->GetNumberOfSelectionArrays(this->ZoneDataArraySelection); }
+
+  // Description:
+  // Get/Set whether the zone with the given name is to be read.
+  int GetZoneArrayStatus(const char *name)
+  { return this->GetSelectionArrayStatus(this->ZoneDataArraySelection, name); }
+  void SetZoneArrayStatus(const char *name, int status)
+  { this->SetSelectionArrayStatus(this->ZoneDataArraySelection, name,
+    status); }
+
+  // Description:
+  // Get the name of the zone with the given index in the input.
+  const char *GetZoneArrayName(int index)
+  { return this->GetSelectionArrayName(this->ZoneDataArraySelection, index); }
+
+  // Description:
+  // Turn on/off all zones.
+  void DisableAllZoneArrays()
+  { this->DisableAllSelectionArrays(this->ZoneDataArraySelection); }
+  void EnableAllZoneArrays()
+  { this->EnableAllSelectionArrays(this->ZoneDataArraySelection); }
+
   // Description:
   // Set/Get whether to create cell-to-point translated data for cell-type data.
   vtkSetMacro(CreateCellToPoint,int);
@@ -292,6 +320,38 @@ public:
   vtkGetMacro(ReadZones, int);
   vtkBooleanMacro(ReadZones, int);
 
+  // Description:
+  // Set/Get the maximum number of threads reading fields concurrently.
+  // 0 (the default) uses as many threads as vtkMultiThreader provides.
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Set/Get the directory the built internal meshes and the index of
+  // the case directories are cached in across sessions. The cache is
+  // not used if empty (the default).
+  vtkSetStringMacro(MeshCacheDirectory);
+  vtkGetStringMacro(MeshCacheDirectory);
+
+  // Description:
+  // Set/Get whether the case is watched for new timesteps. Watching
+  // does not refresh the reader by itself; the completed timesteps are
+  // reported by GetCompletedTimeSteps().
+  void SetWatch(const int);
+  vtkGetMacro(Watch, int);
+  vtkBooleanMacro(Watch, int);
+
+  // Description:
+  // Get the names of the timesteps whose time directories have been
+  // completely written since the last refresh. Only reported while
+  // watching by filesystem events.
+  vtkStringArray *GetCompletedTimeSteps();
+
+  // Description:
+  // Get whether the case is watched by filesystem events. If not, the
+  // case has to be polled by refreshing the reader.
+  int GetWatchIsEventDriven();
+
   // Description:
   // Has mesh changed at this time step or not.
   vtkGetMacro(MeshChanged, int);
@@ -313,6 +373,7 @@ protected:
     vtkInformationVector *);
   int RequestData(vtkInformation *, vtkInformationVector **,
     vtkInformationVector *);
+  virtual void GetWatchedDirectories(vtkStringArray *);
 
   //BTX
   friend class vtkOFFReaderPrivate;
@@ -353,12 +414,24 @@ private:
   // force zero gradient to boundary fields
   int ForceZeroGradient;
 
+  // maximum number of threads reading fields
+  int NumberOfThreads;
+
+  // directory of the persistent mesh cache
+  char *MeshCacheDirectory;
+
+  // for watching the case for new timesteps
+  int Watch;
+  vtkFoamCaseWatcher *CaseWatcher;
+  vtkStringArray *CompletedTimeSteps;
+
   // has mesh changed at this time step or not
   int MeshChanged;
 
   char *FileName;
   vtkCharArray *CasePath;
   vtkCollection *Readers;
+  vtkFoamCaseIndex *CaseIndex;
 
   // DataArraySelection for Patch / Region Data
   vtkDataArraySelection *PatchDataArraySelection;
@@ -366,6 +439,7 @@ private:
   vtkDataArraySelection *SurfaceDataArraySelection;
   vtkDataArraySelection *PointDataArraySelection;
   vtkDataArraySelection *LagrangianDataArraySelection;
+  vtkDataArraySelection *ZoneDataArraySelection;
 
   // old selection and path statuses
   unsigned long int PatchSelectionMTimeOld;
@@ -374,6 +448,7 @@ private:
   unsigned long int PointSelectionMTimeOld;
   unsigned long int LagrangianSelectionMTimeOld;
   unsigned long int LagrangianPathsMTimeOld;
+  unsigned long int ZoneSelectionMTimeOld;
 
   // preserved old information
   vtkStdString *FileNameOld;
@@ -421,6 +496,7 @@ private:
   void CreateCharArrayFromString(vtkCharArray *, const char *, vtkStdString &);
   void UpdateStatus();
   void UpdateProgress(double);
+  void ResetWatcher();
 };
 
 #endif
@@ -143,10 +143,41 @@ void vtkPOFFReader::SetCaseType(const int t)
     {
     this->CaseType = static_cast<caseType>(t);
     this->Refresh = true;
+    // the time directories are watched in other directories
+    this->Superclass::ResetWatcher();
     this->Modified();
     }
 }
 
+//-----------------------------------------------------------------------------
+// the time directories of a decomposed case are created in the
+// processor subdirectories
+void vtkPOFFReader::GetWatchedDirectories(vtkStringArray *dirs)
+{
+  if (this->CaseType == RECONSTRUCTED_CASE)
+    {
+    this->Superclass::GetWatchedDirectories(dirs);
+    return;
+    }
+
+  vtkStdString masterCasePath, controlDictPath;
+  this->Superclass::CreateCasePath(masterCasePath, controlDictPath);
+  vtkDirectory *dir = vtkDirectory::New();
+  if (dir->Open(masterCasePath.c_str()))
+    {
+    for (int fileI = 0; fileI < dir->GetNumberOfFiles(); fileI++)
+      {
+      const vtkStdString subDir(dir->GetFile(fileI));
+      if (subDir.substr(0, 9) == "processor"
+          && dir->FileIsDirectory(subDir.c_str()))
+        {
+        dirs->InsertNextValue(masterCasePath + subDir + "/");
+        }
+      }
+    }
+  dir->Delete();
+}
+
 //-----------------------------------------------------------------------------
 int vtkPOFFReader::RequestInformation(vtkInformation *request,
     vtkInformationVector **inputVector, vtkInformationVector *outputVector)
@@ -226,6 +257,7 @@ int vtkPOFFReader::RequestInformation(vtkInformation *request,
       this->Superclass::PointDataArraySelection->RemoveAllArrays();
       this->Superclass::LagrangianDataArraySelection->RemoveAllArrays();
       this->Superclass::PatchDataArraySelection->RemoveAllArrays();
+      this->Superclass::ZoneDataArraySelection->RemoveAllArrays();
       }
     else if ((this->CaseTypeOld == DECOMPOSED_CASE_MULTIBLOCK
             && this->CaseType != DECOMPOSED_CASE_MULTIBLOCK)
@@ -235,6 +267,21 @@ int vtkPOFFReader::RequestInformation(vtkInformation *request,
       this->Superclass::PatchDataArraySelection->RemoveAllArrays();
       }
 
+    // keep the processor readers when just refreshing a case so that
+    // they only have to scan the new time directories
+    vtkCollection *readersOld = vtkCollection::New();
+    vtkIntArray *pieceIdsOld = vtkIntArray::New();
+    if (*this->Superclass::FileNameOld == this->Superclass::FileName
+        && this->Superclass::ListTimeStepsByControlDict
+        == this->Superclass::ListTimeStepsByControlDictOld
+        && this->CaseTypeOld == this->CaseType)
+      {
+      vtkCollection *readers = this->Superclass::Readers;
+      this->Superclass::Readers = readersOld;
+      readersOld = readers;
+      pieceIdsOld->DeepCopy(this->PieceIds);
+      }
+
     // this substitution is always run because Refresh is always set
     // when the CaseType changes
     this->CaseTypeOld = this->CaseType;
@@ -242,6 +289,7 @@ int vtkPOFFReader::RequestInformation(vtkInformation *request,
     *this->Superclass::FileNameOld = vtkStdString(this->FileName);
     this->Superclass::Readers->RemoveAllItems();
     this->Superclass::NumberOfReaders = 0;
+    this->Superclass::CompletedTimeSteps->Initialize();
     this->PieceIds->Initialize();
     this->MaximumPieceId = -1;
     this->MaximumNumberOfPieces = 0;
@@ -270,6 +318,8 @@ int vtkPOFFReader::RequestInformation(vtkInformation *request,
         this->SetErrorCode(vtkErrorCode::UnknownError);
         procNos->Delete();
         procNames->Delete();
+        readersOld->Delete();
+        pieceIdsOld->Delete();
         dir->Delete();
         this->AllReduceStatus(ret = 0);
         return 0;
@@ -323,14 +373,15 @@ int vtkPOFFReader::RequestInformation(vtkInformation *request,
       // get time directories from the first processor subdirectory
       if (procNames->GetNumberOfTuples() > 0)
         {
-        vtkOFFReader *masterReader = vtkOFFReader::New();
-        masterReader->SetFileName(this->FileName);
-        masterReader->SetParent(this);
+        vtkOFFReader *masterReader = this->NewProcessorReader(readersOld,
+            pieceIdsOld, procNos->GetValue(0));
         if (!masterReader->MakeInformationVector(outputVector, procNames
             ->GetValue(0)) || !masterReader->MakeMetaDataAtTimeStep(true))
           {
           procNos->Delete();
           procNames->Delete();
+          readersOld->Delete();
+          pieceIdsOld->Delete();
           masterReader->Delete();
           this->AllReduceStatus(ret = 0);
           return 0;
@@ -362,6 +413,8 @@ int vtkPOFFReader::RequestInformation(vtkInformation *request,
         timeValues->Delete(); // don't have to care about process 0
         procNos->Delete();
         procNames->Delete();
+        readersOld->Delete();
+        pieceIdsOld->Delete();
         return 0;
         }
 
@@ -398,9 +451,8 @@ int vtkPOFFReader::RequestInformation(vtkInformation *request,
     for (int procI = (this->ProcessId ? this->ProcessId : this->NumProcesses); procI
         < procNames->GetNumberOfTuples(); procI += this->NumProcesses)
       {
-      vtkOFFReader *subReader = vtkOFFReader::New();
-      subReader->SetFileName(this->FileName);
-      subReader->SetParent(this);
+      vtkOFFReader *subReader = this->NewProcessorReader(readersOld,
+          pieceIdsOld, procNos->GetValue(procI));
       ret *= (subReader->MakeInformationVector(NULL, procNames->GetValue(procI))
           && subReader->MakeMetaDataAtTimeStep(true));
       // subreader is added even if it failed in order to match the
@@ -416,6 +468,8 @@ int vtkPOFFReader::RequestInformation(vtkInformation *request,
 
     procNos->Delete();
     procNames->Delete();
+    readersOld->Delete();
+    pieceIdsOld->Delete();
 
     this->PieceIds->Squeeze();
 
@@ -435,6 +489,30 @@ int vtkPOFFReader::RequestInformation(vtkInformation *request,
   return ret;
 }
 
+//-----------------------------------------------------------------------------
+// reuse the reader of a processor subdirectory read before or create a
+// new one
+vtkOFFReader *vtkPOFFReader::NewProcessorReader(vtkCollection *readersOld,
+    vtkIntArray *pieceIdsOld, const int procNo)
+{
+  for (int readerI = 0; readerI < pieceIdsOld->GetNumberOfTuples()
+      && readerI < readersOld->GetNumberOfItems(); readerI++)
+    {
+    if (pieceIdsOld->GetValue(readerI) == procNo)
+      {
+      vtkOFFReader *reader = vtkOFFReader::SafeDownCast(
+          readersOld->GetItemAsObject(readerI));
+      reader->Register(this);
+      return reader;
+      }
+    }
+
+  vtkOFFReader *reader = vtkOFFReader::New();
+  reader->SetFileName(this->FileName);
+  reader->SetParent(this);
+  return reader;
+}
+
 //-----------------------------------------------------------------------------
 int vtkPOFFReader::RequestData(vtkInformation *request,
     vtkInformationVector **inputVector, vtkInformationVector *outputVector)
@@ -1488,6 +1566,7 @@ void vtkPOFFReader::GatherMetaData()
     this->AllGatherV(this->Superclass::CellDataArraySelection);
     this->AllGatherV(this->Superclass::PointDataArraySelection);
     this->AllGatherV(this->Superclass::LagrangianDataArraySelection);
+    this->AllGatherV(this->Superclass::ZoneDataArraySelection);
     // omit removing duplicated entries of LagrangianPaths as well
     // when the number of processes is 1 assuming there's no duplicate
     // entry within a process
@@ -37,6 +37,7 @@
 
 #include "vtkOFFDevReader.h"
 
+class vtkCollection;
 class vtkDataArray;
 class vtkDataArraySelection;
 class vtkDoubleArray;
@@ -141,6 +142,7 @@ protected:
     vtkInformationVector *);
   int RequestData(vtkInformation *, vtkInformationVector **,
     vtkInformationVector *);
+  void GetWatchedDirectories(vtkStringArray *);
 
 private:
   vtkMultiProcessController *Controller;
@@ -171,6 +173,8 @@ private:
   int AppendedPolyRegionCentroids(vtkPolyData *);
   int PolyRegionCentroids(vtkPolyData *);
 
+  vtkOFFReader *NewProcessorReader(vtkCollection *, vtkIntArray *,
+      const int);
   void GatherMetaData();
   void AllReduceStatus(int &);
   void Broadcast(vtkStringArray *, int);